@@ -36,6 +36,7 @@
 
 PROTOCOLS_CUSTOMKERNEL(CustomKernel, float32_t, "f\0", NPY_FLOAT32)
 %rename(CustomKernel) CCustomKernel;
+%rename(KernelMatrixCache) CKernelMatrixCache;
 
 %rename(DiagKernel) CDiagKernel;
 #ifdef USE_GPL_SHOGUN
@@ -127,6 +128,7 @@ namespace shogun
 %include <shogun/kernel/string/CommWordStringKernel.h>
 %include <shogun/kernel/CombinedKernel.h>
 %include <shogun/kernel/CustomKernel.h>
+%include <shogun/kernel/KernelMatrixCache.h>
 #ifdef USE_GPL_SHOGUN
 %include <shogun/kernel/string/DistantSegmentsKernel.h>
 #endif //USE_GPL_SHOGUN
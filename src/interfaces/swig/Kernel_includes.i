@@ -7,6 +7,7 @@
 #include <shogun/kernel/string/CommUlongStringKernel.h>
 #include <shogun/kernel/string/CommWordStringKernel.h>
 #include <shogun/kernel/CustomKernel.h>
+#include <shogun/kernel/KernelMatrixCache.h>
 #ifdef USE_GPL_SHOGUN
 #include <shogun/kernel/string/DistantSegmentsKernel.h>
 #endif //USE_GPL_SHOGUN
@@ -7,6 +7,7 @@
  */
 
 #include <list>
+#include <unordered_set>
 #include <shogun/lib/Signal.h>
 #include <shogun/classifier/mkl/MKL.h>
 #include <shogun/classifier/svm/LibSVM.h>
@@ -270,6 +271,7 @@ void CMKL::register_params()
 	w_gap = 1.0;
 	rho = 0;
 	lp_initialized = false;
+	row_cache_size = 256;
 
 	SG_ADD(&svm, "svm", "wrapper svm");
 	SG_ADD(&C_mkl, "C_mkl", "C mkl", ParameterProperties::HYPER);
@@ -288,6 +290,9 @@ void CMKL::register_params()
 	SG_ADD(&w_gap, "w_gap", "gap between interactions");
 	SG_ADD(&rho, "rho", "objective after mkl iterations");
 	SG_ADD(&lp_initialized, "lp_initialized", "if lp is Initialized");
+	SG_ADD(&row_cache_size, "row_cache_size",
+			"size of the subkernel row cache in MB",
+			ParameterProperties::SETTING);
 	// Missing: self (3rd party specific, handled in clone())
 }
 
@@ -352,6 +357,8 @@ bool CMKL::train_machine(CFeatures* data)
 	if (!svm)
 		SG_ERROR("No constraint generator (SVM) set\n")
 
+	row_cache.clear();
+
 	int32_t num_label=0;
 	if (m_labels)
 		num_label = m_labels->get_num_labels();
@@ -493,6 +500,8 @@ bool CMKL::train_machine(CFeatures* data)
 	self->cleanup_glpk(lp_initialized);
 #endif
 
+	row_cache.clear();
+
 	int32_t nsv=svm->get_num_support_vectors();
 	create_new_model(nsv);
 
@@ -506,6 +515,17 @@ bool CMKL::train_machine(CFeatures* data)
 }
 
 
+void CMKL::set_row_cache_size(int32_t size)
+{
+	REQUIRE(size>=0, "Row cache size (%d) must not be negative\n", size)
+	row_cache_size=size;
+}
+
+int32_t CMKL::get_row_cache_size() const
+{
+	return row_cache_size;
+}
+
 void CMKL::set_mkl_norm(float64_t norm)
 {
 
@@ -727,7 +747,6 @@ void CMKL::elasticnet_dual(float64_t *ff, float64_t *gg, float64_t *hh,
 // assumes that all constraints are satisfied
 float64_t CMKL::compute_elasticnet_dual_objective()
 {
-	int32_t n=get_num_support_vectors();
 	int32_t num_kernels = kernel->get_num_subkernels();
 	float64_t mkl_obj=0;
 
@@ -739,28 +758,14 @@ float64_t CMKL::compute_elasticnet_dual_objective()
 
 
 		int32_t k=0;
-		for (index_t k_idx=0; k_idx<((CCombinedKernel*) kernel)->get_num_kernels(); k_idx++)
+		SGVector<float64_t> terms=compute_subkernel_quadratic_terms(this);
+		for (auto sum : terms)
 		{
-			CKernel* kn = ((CCombinedKernel*) kernel)->get_kernel(k_idx);
-			float64_t sum=0;
-			for (int32_t i=0; i<n; i++)
-			{
-				int32_t ii=get_support_vector(i);
-
-				for (int32_t j=0; j<n; j++)
-				{
-					int32_t jj=get_support_vector(j);
-					sum+=get_alpha(i)*get_alpha(j)*kn->kernel(ii,jj);
-				}
-			}
 			nm[k]= CMath::pow(sum, 0.5);
 			del = CMath::max(del, nm[k]);
 
 			// SG_PRINT("nm[%d]=%f\n",k,nm[k])
 			k++;
-
-
-			SG_UNREF(kn);
 		}
 		// initial delta
 		del = del / std::sqrt(2 * (1 - ent_lambda));
@@ -1634,6 +1639,19 @@ void CMKL::compute_sum_beta(float64_t* sumw)
 		sumw[i]=0;
 	}
 
+	// evaluate the subkernels directly instead of the combined kernel with
+	// all but one weight set to zero
+	if (kernel->get_kernel_type()==K_COMBINED &&
+			((CCombinedKernel*) kernel)->get_num_kernels()==num_kernels)
+	{
+		SGVector<float64_t> terms=compute_subkernel_quadratic_terms(svm);
+		for (int32_t n=0; n<num_kernels; n++)
+			sumw[n]=0.5*terms[n];
+
+		mkl_iterations++;
+		return;
+	}
+
 	for (int32_t n=0; n<num_kernels; n++)
 	{
 		beta.vector[n]=1.0;
@@ -1668,32 +1686,17 @@ float64_t CMKL::compute_mkl_dual_objective()
 		return compute_elasticnet_dual_objective();
 	}
 
-	int32_t n=get_num_support_vectors();
 	float64_t mkl_obj=0;
 
 	if (m_labels && kernel && kernel->get_kernel_type() == K_COMBINED)
 	{
-		for (index_t k_idx=0; k_idx<((CCombinedKernel*) kernel)->get_num_kernels(); k_idx++)
+		SGVector<float64_t> terms=compute_subkernel_quadratic_terms(this);
+		for (auto sum : terms)
 		{
-			CKernel* kn = ((CCombinedKernel*) kernel)->get_kernel(k_idx);
-			float64_t sum=0;
-			for (int32_t i=0; i<n; i++)
-			{
-				int32_t ii=get_support_vector(i);
-
-				for (int32_t j=0; j<n; j++)
-				{
-					int32_t jj=get_support_vector(j);
-					sum+=get_alpha(i)*get_alpha(j)*kn->kernel(ii,jj);
-				}
-			}
-
 			if (mkl_norm==1.0)
 				mkl_obj = CMath::max(mkl_obj, sum);
 			else
 				mkl_obj += CMath::pow(sum, mkl_norm/(mkl_norm-1));
-
-			SG_UNREF(kn);
 		}
 
 		if (mkl_norm==1.0)
@@ -1708,3 +1711,119 @@ float64_t CMKL::compute_mkl_dual_objective()
 
 	return -mkl_obj;
 }
+
+SGVector<float64_t> CMKL::compute_subkernel_quadratic_terms(
+		CKernelMachine* machine)
+{
+	ASSERT(kernel && kernel->get_kernel_type()==K_COMBINED)
+	CCombinedKernel* combined=(CCombinedKernel*) kernel;
+
+	int32_t num_kernels=combined->get_num_kernels();
+	int32_t num_vec=kernel->get_num_vec_lhs();
+	int32_t nsv=machine->get_num_support_vectors();
+
+	SGVector<int32_t> svs(nsv);
+	SGVector<float64_t> alphas(nsv);
+	for (int32_t i=0; i<nsv; i++)
+	{
+		svs[i]=machine->get_support_vector(i);
+		alphas[i]=machine->get_alpha(i);
+	}
+
+	update_row_cache(svs, num_kernels, num_vec);
+
+	std::vector<CKernel*> kernels(num_kernels);
+	for (int32_t n=0; n<num_kernels; n++)
+		kernels[n]=combined->get_kernel(n);
+
+	// one task per subkernel and support vector, rows of the same subkernel
+	// are distinct so the lazily filled cache entries do not race
+	SGVector<float64_t> partial_sums(int64_t(num_kernels)*nsv);
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (int64_t p=0; p<int64_t(num_kernels)*nsv; p++)
+	{
+		int32_t n=p/nsv;
+		int32_t i=p%nsv;
+		CKernel* kn=kernels[n];
+		int32_t ii=svs[i];
+
+		auto cached=row_cache[n].find(ii);
+		float64_t* row=cached!=row_cache[n].end() ? cached->second.vector : NULL;
+
+		float64_t sum=0;
+		for (int32_t j=0; j<nsv; j++)
+		{
+			int32_t jj=svs[j];
+			float64_t value;
+			if (row)
+			{
+				if (CMath::is_nan(row[jj]))
+					row[jj]=kn->kernel(ii, jj);
+				value=row[jj];
+			}
+			else
+				value=kn->kernel(ii, jj);
+
+			sum+=alphas[j]*value;
+		}
+		partial_sums[p]=alphas[i]*sum;
+	}
+
+	SGVector<float64_t> terms(num_kernels);
+	for (int32_t n=0; n<num_kernels; n++)
+	{
+		terms[n]=0;
+		for (int32_t i=0; i<nsv; i++)
+			terms[n]+=partial_sums[int64_t(n)*nsv+i];
+
+		SG_UNREF(kernels[n]);
+	}
+
+	return terms;
+}
+
+void CMKL::update_row_cache(
+		SGVector<int32_t> svs, int32_t num_kernels, int32_t num_vec)
+{
+	if (int32_t(row_cache.size())!=num_kernels)
+	{
+		row_cache.clear();
+		row_cache.resize(num_kernels);
+	}
+
+	// support vectors change little between MKL iterations, so only rows of
+	// vectors that dropped out are discarded
+	std::unordered_set<int32_t> sv_set(svs.begin(), svs.end());
+	int64_t num_rows=0;
+	for (auto& rows : row_cache)
+	{
+		for (auto it=rows.begin(); it!=rows.end();)
+		{
+			if (it->second.vlen!=num_vec || !sv_set.count(it->first))
+				it=rows.erase(it);
+			else
+				++it;
+		}
+		num_rows+=rows.size();
+	}
+
+	int64_t max_rows=num_vec>0 ?
+		int64_t(row_cache_size)*1024*1024/(int64_t(num_vec)*sizeof(float64_t)) : 0;
+
+	for (auto sv : svs)
+	{
+		for (auto& rows : row_cache)
+		{
+			if (num_rows>=max_rows)
+				return;
+
+			if (rows.find(sv)==rows.end())
+			{
+				SGVector<float64_t> row(num_vec);
+				row.set_const(NAN);
+				rows.emplace(sv, row);
+				num_rows++;
+			}
+		}
+	}
+}
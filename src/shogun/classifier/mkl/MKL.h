@@ -15,6 +15,9 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/classifier/svm/SVM.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace shogun
 {
 /** @brief Multiple Kernel Learning
@@ -208,6 +211,19 @@ class CMKL : public CSVM
 		 */
 		inline int32_t get_mkl_iterations() { return mkl_iterations; }
 
+		/** set size of the cache for rows of the subkernel matrices, which
+		 * is kept between MKL iterations
+		 *
+		 * @param size cache size in MB
+		 */
+		void set_row_cache_size(int32_t size);
+
+		/** get size of the cache for rows of the subkernel matrices
+		 *
+		 * @return cache size in MB
+		 */
+		int32_t get_row_cache_size() const;
+
 		/** perform single mkl iteration
 		 *
 		 * given sum of alphas, objectives for current alphas for each kernel
@@ -397,6 +413,25 @@ class CMKL : public CSVM
 		/** initialize solver such as glpk or cplex */
 		void init_solver();
 
+		/** compute alpha'*K_j*alpha for each subkernel j of a combined
+		 * kernel, in parallel over subkernels and support vectors
+		 *
+		 * @param machine machine with alphas and support vectors
+		 * @return quadratic term of each subkernel
+		 */
+		SGVector<float64_t> compute_subkernel_quadratic_terms(
+				CKernelMachine* machine);
+
+		/** drops cached rows of vectors that are no longer support vectors
+		 * and allocates rows for new ones, as far as the cache size allows
+		 *
+		 * @param svs indices of the support vectors
+		 * @param num_kernels number of subkernels
+		 * @param num_vec number of training vectors
+		 */
+		void update_row_cache(
+				SGVector<int32_t> svs, int32_t num_kernels, int32_t num_vec);
+
 	private:
 		void register_params();
 
@@ -437,6 +472,12 @@ class CMKL : public CSVM
 		/** measures training time for use with get_max_train_time() */
 		CTime training_time_clock;
 
+		/** size of the subkernel row cache in MB */
+		int32_t row_cache_size;
+		/** lazily filled rows of each subkernel matrix by vector index,
+		 * entries not yet computed are NaN */
+		std::vector<std::unordered_map<int32_t, SGVector<float64_t>>> row_cache;
+
 		/** Opaque parameters of MKL */
 		class Self;
 		Unique<Self> self;
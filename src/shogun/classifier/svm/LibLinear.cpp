@@ -52,6 +52,7 @@ void CLibLinear::init()
 	set_C(1, 1);
 	set_max_iterations();
 	set_epsilon(1e-5);
+	m_num_iterations = 0;
 
 	SG_ADD(&C1, "C1", "C Cost constant 1.", ParameterProperties::HYPER);
 	SG_ADD(&C2, "C2", "C Cost constant 2.", ParameterProperties::HYPER);
@@ -134,6 +135,17 @@ bool CLibLinear::train_machine(CFeatures* data)
 		prob.n = w.vlen;
 		memset(w.vector, 0, sizeof(float64_t) * (w.vlen + 0));
 	}
+
+	// the primal solvers can start from the current model, the dual
+	// solvers derive their starting point from zero dual variables
+	bool warm_start = m_warm_start && m_w.vlen == w.vlen &&
+	                  (solver_type == L2R_LR || solver_type == L2R_L2LOSS_SVC);
+	if (warm_start)
+	{
+		sg_memcpy(w.vector, m_w.vector, sizeof(float64_t) * w.vlen);
+		if (get_bias_enabled())
+			w[w.vlen] = bias;
+	}
 	prob.l = num_vec;
 	prob.x = features;
 	prob.y = SG_MALLOC(double, prob.l);
@@ -175,7 +187,8 @@ bool CLibLinear::train_machine(CFeatures* data)
 		    fun_obj, get_epsilon() * CMath::min(pos, neg) / prob.l,
 		    get_max_iterations());
 		SG_DEBUG("starting L2R_LR training via tron\n")
-		tron_obj.tron(w.vector, m_max_train_time);
+		tron_obj.tron(w.vector, m_max_train_time, warm_start);
+		m_num_iterations = tron_obj.get_num_iterations();
 		SG_DEBUG("done with tron\n")
 		delete fun_obj;
 		break;
@@ -186,7 +199,8 @@ bool CLibLinear::train_machine(CFeatures* data)
 		CTron tron_obj(
 		    fun_obj, get_epsilon() * CMath::min(pos, neg) / prob.l,
 		    get_max_iterations());
-		tron_obj.tron(w.vector, m_max_train_time);
+		tron_obj.tron(w.vector, m_max_train_time, warm_start);
+		m_num_iterations = tron_obj.get_num_iterations();
 		delete fun_obj;
 		break;
 	}
@@ -428,6 +442,7 @@ void CLibLinear::solve_l2r_l1l2_svc(
 
 	pb.complete_absolute();
 	SG_INFO("optimization finished, #iter = %d\n",iter)
+	m_num_iterations = iter;
 	if (iter >= get_max_iterations())
 	{
 		SG_WARNING(
@@ -776,6 +791,7 @@ void CLibLinear::solve_l1r_l2_svc(
 
 	pb.complete_absolute();
 	SG_INFO("optimization finished, #iter = %d\n", iter)
+	m_num_iterations = iter;
 	if (iter >= get_max_iterations())
 		SG_WARNING("\nWARNING: reaching max number of iterations\n")
 
@@ -1150,6 +1166,7 @@ void CLibLinear::solve_l1r_lr(
 
 	pb.complete_absolute();
 	SG_INFO("optimization finished, #iter = %d\n", iter)
+	m_num_iterations = iter;
 	if (iter >= get_max_iterations())
 		SG_WARNING("\nWARNING: reaching max number of iterations\n")
 
@@ -1345,6 +1362,7 @@ void CLibLinear::solve_l2r_lr_dual(
 
 	pb.complete_absolute();
 	SG_INFO("optimization finished, #iter = %d\n",iter)
+	m_num_iterations = iter;
 
 	if (iter >= get_max_iterations())
 		SG_WARNING("reaching max number of iterations\nUsing -s 0 may be "
@@ -193,6 +193,12 @@ namespace shogun
 			max_iterations = max_iter;
 		}
 
+		/** get the number of iterations of the last training */
+		inline int32_t get_num_iterations() const
+		{
+			return m_num_iterations;
+		}
+
 		/** set the linear term for qp */
 		void set_linear_term(const SGVector<float64_t> linear_term);
 
@@ -256,6 +262,8 @@ namespace shogun
 		float64_t epsilon;
 		/** maximum number of iterations */
 		int32_t max_iterations;
+		/** number of iterations of the last training */
+		int32_t m_num_iterations;
 
 		/** precomputed linear term */
 		SGVector<float64_t> m_linear_term;
@@ -103,6 +103,26 @@ bool CLibSVM::train_machine(CFeatures* data)
 		x_space[2*i+1].index=-1;
 	}
 
+	// warm start from the current model, e.g. along a regularization path
+	int32_t num_sv=get_num_support_vectors();
+	if (m_warm_start && solver_type==LIBSVM_C_SVC && num_sv>0)
+	{
+		problem.alpha=SG_CALLOC(float64_t, problem.l);
+		for (int32_t i=0; i<num_sv; i++)
+		{
+			int32_t idx=get_support_vector(i);
+			if (idx<0 || idx>=problem.l)
+			{
+				SG_WARNING("Support vectors do not match the training data, "
+						"not warm starting\n");
+				SG_FREE(problem.alpha);
+				problem.alpha=NULL;
+				break;
+			}
+			problem.alpha[idx]=get_alpha(i);
+		}
+	}
+
 	int32_t weights_label[2]={-1,+1};
 	float64_t weights[2]={1.0,get_C2()/get_C1()};
 
@@ -144,13 +164,14 @@ bool CLibSVM::train_machine(CFeatures* data)
 		SG_ERROR("Error: %s\n",error_msg)
 
 	model = svm_train(&problem, &param);
+	SG_FREE(problem.alpha);
 
 	if (model)
 	{
 		ASSERT(model->nr_class==2)
 		ASSERT((model->l==0) || (model->l>0 && model->SV && model->sv_coef && model->sv_coef[0]))
 
-		int32_t num_sv=model->l;
+		num_sv=model->l;
 
 		create_new_model(num_sv);
 		CSVM::set_objective(model->objective);
@@ -284,3 +284,74 @@ void COnlineLibLinear::train_example(CStreamingDotFeatures *feature, float64_t l
 		SG_NOTIMPLEMENTED
 	}
 }
+
+void COnlineLibLinear::train_batch(const SExampleBatch& batch)
+{
+	const int32_t num_examples=batch.size();
+
+	// updates of examples, added after the batch unless Hogwild is used
+	SGVector<float64_t> updates(m_hogwild ? 0 : num_examples);
+	float64_t bias_update=0;
+	float64_t PGmax=PGmax_new;
+	float64_t PGmin=PGmin_new;
+	float64_t objective=0;
+	int32_t num_sv=0;
+	float32_t* w=m_w.vector;
+
+#pragma omp parallel for schedule(static) \
+	reduction(max:PGmax) reduction(min:PGmin) reduction(+:bias_update,objective,num_sv)
+	for (int32_t i=0; i<num_examples; i++)
+	{
+		// same as train_one() with the local alpha starting from zero
+		int32_t y_current=batch.labels[i]>0 ? +1 : -1;
+		float64_t QD_i=diag[y_current+1]+batch.squared_norm(i);
+		float64_t G_i=batch.dense_dot(i, w);
+		if (use_bias)
+			G_i+=bias;
+		G_i=G_i*y_current-1;
+
+		float64_t d_i=0;
+		if (G_i<=PGmax_old)
+		{
+			float64_t PG_i=G_i<0 ? G_i : 0;
+			PGmax=CMath::max(PGmax, PG_i);
+			PGmin=CMath::min(PGmin, PG_i);
+
+			float64_t alpha=0;
+			if (fabs(PG_i)>1.0e-12)
+			{
+				alpha=CMath::min(CMath::max(-G_i/QD_i, 0.0), upper_bound[y_current+1]);
+				d_i=alpha*y_current;
+				bias_update+=d_i;
+
+				// lock-free, other threads may read or write w meanwhile
+				if (m_hogwild)
+					batch.add_to_dense_vec(i, d_i, w);
+			}
+
+			objective+=alpha*(alpha*diag[y_current+1]-2);
+			if (alpha>0)
+				num_sv++;
+		}
+
+		if (!m_hogwild)
+			updates[i]=d_i;
+	}
+
+	if (!m_hogwild)
+	{
+		for (int32_t i=0; i<num_examples; i++)
+		{
+			if (updates[i]!=0)
+				batch.add_to_dense_vec(i, updates[i], w);
+		}
+	}
+
+	if (use_bias)
+		bias+=bias_update;
+
+	PGmax_new=PGmax;
+	PGmin_new=PGmin;
+	v+=objective;
+	nSV+=num_sv;
+}
@@ -121,6 +121,14 @@ public:
 		 */
 		virtual void train_example(CStreamingDotFeatures *feature, float64_t label);
 
+		/** train on a batch of examples in parallel, taking one dual
+		 * coordinate step per example. The bias is updated once per
+		 * batch.
+		 *
+		 * @param batch examples and their labels
+		 */
+		virtual void train_batch(const SExampleBatch& batch);
+
 private:
 		/** Set up parameters */
 		void init();
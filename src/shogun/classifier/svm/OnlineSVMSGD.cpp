@@ -90,45 +90,57 @@ bool COnlineSVMSGD::train(CFeatures* data)
 		is_log_loss = true;
 
 	int32_t vec_count;
+	SExampleBatch batch;
 	for (auto e : SG_PROGRESS(range(epochs)))
 	{
 		COMPUTATION_CONTROLLERS
 		vec_count=0;
 		count = skip;
-		while (features->get_next_example())
+		if (m_batch_size>1)
 		{
-			vec_count++;
-			// Expand w vector if more features are seen in this example
-			features->expand_if_required(m_w.vector, m_w.vlen);
+			while (read_example_batch(batch, m_batch_size))
+			{
+				vec_count+=batch.size();
+				train_batch(batch);
+			}
+		}
+		else
+		{
+			while (features->get_next_example())
+			{
+				vec_count++;
+				// Expand w vector if more features are seen in this example
+				features->expand_if_required(m_w.vector, m_w.vlen);
 
-			float64_t eta = 1.0 / (lambda * t);
-			float64_t y = features->get_label();
-			float64_t z = y * (features->dense_dot(m_w.vector, m_w.vlen) + bias);
+				float64_t eta = 1.0 / (lambda * t);
+				float64_t y = features->get_label();
+				float64_t z = y * (features->dense_dot(m_w.vector, m_w.vlen) + bias);
 
-			if (z < 1 || is_log_loss)
-			{
-				float64_t etd = -eta * loss->first_derivative(z,1);
-				features->add_to_dense_vec(etd * y / wscale, m_w.vector, m_w.vlen);
+				if (z < 1 || is_log_loss)
+				{
+					float64_t etd = -eta * loss->first_derivative(z,1);
+					features->add_to_dense_vec(etd * y / wscale, m_w.vector, m_w.vlen);
+
+					if (use_bias)
+					{
+						if (use_regularized_bias)
+							bias *= 1 - eta * lambda * bscale;
+						bias += etd * y * bscale;
+					}
+				}
 
-				if (use_bias)
+				if (--count <= 0)
 				{
-					if (use_regularized_bias)
-						bias *= 1 - eta * lambda * bscale;
-					bias += etd * y * bscale;
+					float32_t r = 1 - eta * lambda * skip;
+					if (r < 0.8)
+						r = pow(1 - eta * lambda, skip);
+					linalg::scale(m_w, m_w, r);
+					count = skip;
 				}
-			}
+				t++;
 
-			if (--count <= 0)
-			{
-				float32_t r = 1 - eta * lambda * skip;
-				if (r < 0.8)
-					r = pow(1 - eta * lambda, skip);
-				linalg::scale(m_w, m_w, r);
-				count = skip;
+				features->release_example();
 			}
-			t++;
-
-			features->release_example();
 		}
 
 		// If the stream is seekable, reset the stream to the first
@@ -147,6 +159,74 @@ bool COnlineSVMSGD::train(CFeatures* data)
 	return true;
 }
 
+void COnlineSVMSGD::train_batch(const SExampleBatch& batch)
+{
+	const int32_t num_examples=batch.size();
+	ELossType loss_type = loss->get_loss_type();
+	bool is_log_loss = (loss_type == L_LOGLOSS) || (loss_type == L_LOGLOSSMARGIN);
+
+	// updates of examples, added after the batch unless Hogwild is used
+	SGVector<float64_t> updates(m_hogwild ? 0 : num_examples);
+	float64_t bias_update = 0;
+	int32_t num_updates = 0;
+	float32_t* w = m_w.vector;
+
+#pragma omp parallel for schedule(static) reduction(+:bias_update,num_updates)
+	for (int32_t i=0; i<num_examples; i++)
+	{
+		float64_t eta = 1.0 / (lambda * (t + i));
+		float64_t y = batch.labels[i];
+		float64_t z = y * (batch.dense_dot(i, w) + bias);
+		float64_t etd = 0;
+
+		if (z < 1 || is_log_loss)
+		{
+			etd = -eta * loss->first_derivative(z,1);
+			bias_update += etd * y * bscale;
+			num_updates++;
+
+			// lock-free, other threads may read or write w meanwhile
+			if (m_hogwild)
+				batch.add_to_dense_vec(i, etd * y / wscale, w);
+		}
+
+		if (!m_hogwild)
+			updates[i] = etd * y / wscale;
+	}
+
+	if (!m_hogwild)
+	{
+		for (int32_t i=0; i<num_examples; i++)
+		{
+			if (updates[i] != 0)
+				batch.add_to_dense_vec(i, updates[i], w);
+		}
+	}
+
+	t += num_examples;
+	float64_t eta = 1.0 / (lambda * (t - 1));
+
+	if (use_bias)
+	{
+		if (use_regularized_bias)
+			bias *= pow(1 - eta * lambda * bscale, num_updates);
+		bias += bias_update;
+	}
+
+	// weight decay every skip examples
+	int32_t num_decays = 0;
+	for (count -= num_examples; count <= 0; count += CMath::max(skip, 1))
+		num_decays++;
+
+	if (num_decays > 0)
+	{
+		float32_t r = 1 - eta * lambda * skip;
+		if (r < 0.8)
+			r = pow(1 - eta * lambda, skip);
+		linalg::scale(m_w, m_w, (float32_t) pow(r, num_decays));
+	}
+}
+
 void COnlineSVMSGD::calibrate(int32_t max_vec_num)
 {
 	int32_t c_dim=1;
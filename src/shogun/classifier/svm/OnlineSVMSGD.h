@@ -58,6 +58,13 @@ class COnlineSVMSGD : public COnlineLinearMachine
 		 */
 		virtual bool train(CFeatures* data=NULL);
 
+		/** train on a batch of examples in parallel. The weight decay
+		 * and the bias are updated once per batch.
+		 *
+		 * @param batch examples and their labels
+		 */
+		virtual void train_batch(const SExampleBatch& batch);
+
 		/** set C
 		 *
 		 * @param c_neg new C constant for negatively labeled examples
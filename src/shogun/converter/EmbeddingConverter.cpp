@@ -21,6 +21,7 @@ CEmbeddingConverter::CEmbeddingConverter()
 	SG_REF(m_distance);
 	m_kernel = new CLinearKernel();
 	SG_REF(m_kernel);
+	m_approximate_neighbors = false;
 
 	init();
 }
@@ -68,6 +69,16 @@ CKernel* CEmbeddingConverter::get_kernel() const
 	return m_kernel;
 }
 
+void CEmbeddingConverter::set_approximate_neighbors(bool approximate)
+{
+	m_approximate_neighbors = approximate;
+}
+
+bool CEmbeddingConverter::get_approximate_neighbors() const
+{
+	return m_approximate_neighbors;
+}
+
 void CEmbeddingConverter::init()
 {
 	SG_ADD(&m_target_dim, "target_dim",
@@ -77,5 +88,8 @@ void CEmbeddingConverter::init()
 		ParameterProperties::HYPER);
 	SG_ADD(
 		&m_kernel, "kernel", "kernel to be used for embedding", ParameterProperties::HYPER);
+	SG_ADD(
+		&m_approximate_neighbors, "approximate_neighbors",
+		"whether neighbors are searched approximately");
 }
 }
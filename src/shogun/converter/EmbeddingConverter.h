@@ -73,6 +73,19 @@ public:
 	 */
 	CKernel* get_kernel() const;
 
+	/** setter for approximate neighbors search. When enabled the
+	 * neighborhood graph of kNN-based converters is built by parallel
+	 * NN-descent instead of an exact search, trading a small recall loss
+	 * for much faster construction on large datasets.
+	 * @param approximate whether to search neighbors approximately
+	 */
+	void set_approximate_neighbors(bool approximate);
+
+	/** getter for approximate neighbors search
+	 * @return whether neighbors are searched approximately
+	 */
+	bool get_approximate_neighbors() const;
+
 	virtual const char* get_name() const { return "EmbeddingConverter"; };
 
 protected:
@@ -90,6 +103,9 @@ protected:
 
 	/** kernel to be used */
 	CKernel* m_kernel;
+
+	/** whether neighbors are searched approximately */
+	bool m_approximate_neighbors;
 };
 }
 
@@ -31,6 +31,7 @@ CHessianLocallyLinearEmbedding::transform(CFeatures* features, bool inplace)
 	CKernel* kernel = new CLinearKernel((CDotFeatures*)features,(CDotFeatures*)features);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	parameters.approximate_neighbors = m_approximate_neighbors;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_HESSIAN_LOCALLY_LINEAR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
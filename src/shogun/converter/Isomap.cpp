@@ -57,6 +57,7 @@ CDenseFeatures<float64_t>* CIsomap::embed_distance(CDistance* distance)
 		parameters.method = SHOGUN_ISOMAP;
 	}
 	parameters.n_neighbors = m_k;
+	parameters.approximate_neighbors = m_approximate_neighbors;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance;
 	CDenseFeatures<float64_t>* embedding = tapkee_embed(parameters);
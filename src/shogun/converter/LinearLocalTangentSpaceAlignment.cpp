@@ -32,6 +32,7 @@ CLinearLocalTangentSpaceAlignment::transform(CFeatures* features, bool inplace)
 	CKernel* kernel = new CLinearKernel((CDotFeatures*)features,(CDotFeatures*)features);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	parameters.approximate_neighbors = m_approximate_neighbors;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_LINEAR_LOCAL_TANGENT_SPACE_ALIGNMENT;
 	parameters.target_dimension = m_target_dim;
@@ -16,6 +16,7 @@ CTDistributedStochasticNeighborEmbedding::CTDistributedStochasticNeighborEmbeddi
 	// Default values
 	m_perplexity = 30.0;
 	m_theta = 0.5;
+	m_fft_interpolation = false;
 	init();
 }
 
@@ -23,6 +24,9 @@ void CTDistributedStochasticNeighborEmbedding::init()
 {
 	SG_ADD(&m_perplexity, "perplexity", "perplexity");
 	SG_ADD(&m_theta, "theta", "learning rate");
+	SG_ADD(
+	    &m_fft_interpolation, "fft_interpolation",
+	    "whether the gradient is computed by FFT-accelerated interpolation");
 }
 
 CTDistributedStochasticNeighborEmbedding::~CTDistributedStochasticNeighborEmbedding()
@@ -55,12 +59,24 @@ float64_t CTDistributedStochasticNeighborEmbedding::get_perplexity() const
 	return m_perplexity;
 }
 
+void CTDistributedStochasticNeighborEmbedding::set_fft_interpolation(
+    const bool fft_interpolation)
+{
+	m_fft_interpolation = fft_interpolation;
+}
+
+bool CTDistributedStochasticNeighborEmbedding::get_fft_interpolation() const
+{
+	return m_fft_interpolation;
+}
+
 CFeatures* CTDistributedStochasticNeighborEmbedding::transform(
     CFeatures* features, bool inplace)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.sne_theta = m_theta;
 	parameters.sne_perplexity = m_perplexity;
+	parameters.sne_fft_interpolation = m_fft_interpolation;
 	parameters.features = (CDotFeatures*)features;
 
 	parameters.method = SHOGUN_TDISTRIBUTED_STOCHASTIC_NEIGHBOR_EMBEDDING;
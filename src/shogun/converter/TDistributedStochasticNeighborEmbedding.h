@@ -64,6 +64,20 @@ public:
 	 */
 	float64_t get_perplexity() const;
 
+	/** setter for FFT-accelerated interpolation of the gradient, which
+	 * scales to larger data than Barnes-Hut but supports two dimensional
+	 * embeddings only
+	 *
+	 * @param fft_interpolation whether to use FFT-accelerated interpolation
+	 */
+	void set_fft_interpolation(const bool fft_interpolation);
+
+	/** getter for FFT-accelerated interpolation of the gradient
+	 *
+	 * @return whether FFT-accelerated interpolation is used
+	 */
+	bool get_fft_interpolation() const;
+
 private:
 
 	/** default init */
@@ -77,6 +91,9 @@ private:
 	/** perplexity */
 	float64_t m_perplexity;
 
+	/** whether the gradient is computed by FFT-accelerated interpolation */
+	bool m_fft_interpolation;
+
 }; /* class CTDistributedStochasticNeighborEmbedding */
 
 } /* namespace shogun */
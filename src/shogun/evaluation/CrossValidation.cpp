@@ -12,8 +12,13 @@
 #include <shogun/evaluation/CrossValidationStorage.h>
 #include <shogun/evaluation/Evaluation.h>
 #include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/kernel/KernelMatrixCache.h>
 #include <shogun/lib/List.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
+#include <shogun/machine/KernelMachine.h>
+#include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/lib/View.h>
@@ -45,13 +50,76 @@ CCrossValidation::CCrossValidation(
 
 CCrossValidation::~CCrossValidation()
 {
+	clear_warm_start();
+	SG_UNREF(m_kernel_cache);
 }
 
 void CCrossValidation::init()
 {
 	m_num_runs = 1;
+	m_kernel_cache = NULL;
+	m_warm_start = false;
 
 	SG_ADD(&m_num_runs, "num_runs", "Number of repetitions");
+	SG_ADD(
+	    &m_kernel_cache, "kernel_cache",
+	    "Cache of precomputed kernel matrices");
+	SG_ADD(
+	    &m_warm_start, "warm_start",
+	    "Whether consecutive evaluations warm start");
+}
+
+void CCrossValidation::set_kernel_cache(CKernelMatrixCache* cache)
+{
+	SG_REF(cache);
+	SG_UNREF(m_kernel_cache);
+	m_kernel_cache = cache;
+}
+
+CKernelMatrixCache* CCrossValidation::get_kernel_cache() const
+{
+	SG_REF(m_kernel_cache);
+	return m_kernel_cache;
+}
+
+void CCrossValidation::set_warm_start(bool warm_start)
+{
+	clear_warm_start();
+	m_warm_start = warm_start;
+}
+
+bool CCrossValidation::get_warm_start() const
+{
+	return m_warm_start;
+}
+
+void CCrossValidation::clear_warm_start() const
+{
+	for (auto machine : m_warm_start_machines)
+		SG_UNREF(machine);
+
+	m_warm_start_machines.clear();
+	m_warm_start_train.clear();
+	m_warm_start_test.clear();
+}
+
+/* initializes a machine with the model trained by a machine of the same type */
+static void copy_model(CMachine* from, CMachine* to)
+{
+	if (auto kernel_machine = dynamic_cast<CKernelMachine*>(from))
+	{
+		auto target = to->as<CKernelMachine>();
+		target->set_support_vectors(
+		    kernel_machine->get_support_vectors().clone());
+		target->set_alphas(kernel_machine->get_alphas().clone());
+		target->set_bias(kernel_machine->get_bias());
+	}
+	else if (auto linear_machine = dynamic_cast<CLinearMachine*>(from))
+	{
+		auto target = to->as<CLinearMachine>();
+		target->set_w(linear_machine->get_w().clone());
+		target->set_bias(linear_machine->get_bias());
+	}
 }
 
 CEvaluationResult* CCrossValidation::evaluate_impl() const
@@ -86,16 +154,58 @@ void CCrossValidation::set_num_runs(int32_t num_runs)
 	m_num_runs = num_runs;
 }
 
+CMachineEvaluation* CCrossValidation::clone_for_machine(
+    CMachine* machine, CFeatures* features, CLabels* labels) const
+{
+	auto result = CMachineEvaluation::clone_for_machine(
+	                  machine, features, labels)
+	                  ->as<CCrossValidation>();
+	result->m_num_runs = m_num_runs;
+	result->m_seed = m_seed;
+	result->set_kernel_cache(m_kernel_cache);
+
+	return result;
+}
+
 float64_t CCrossValidation::evaluate_one_run(int64_t index) const
 {
 	SG_DEBUG("entering %s::evaluate_one_run()\n", get_name())
 	index_t num_subsets = m_splitting_strategy->get_num_subsets();
 
-	SG_DEBUG("building index sets for %d-fold cross-validation\n", num_subsets)
-	m_splitting_strategy->build_subsets();
+	/* reuse the folds of the previous evaluation when warm starting */
+	index_t offset = index * num_subsets;
+	bool warm_start = m_warm_start &&
+	                  m_warm_start_machines.size() >= size_t(offset + num_subsets);
+	if (!warm_start)
+	{
+		SG_DEBUG(
+		    "building index sets for %d-fold cross-validation\n", num_subsets)
+		m_splitting_strategy->build_subsets();
+	}
+
+	if (m_warm_start && !warm_start)
+	{
+		m_warm_start_machines.resize(offset + num_subsets, NULL);
+		m_warm_start_train.resize(offset + num_subsets);
+		m_warm_start_test.resize(offset + num_subsets);
+	}
 
 	SGVector<float64_t> results(num_subsets);
 
+	/* all folds index into the same precomputed kernel matrix */
+	CCustomKernel* kernel_matrix = NULL;
+	auto kernel_machine = dynamic_cast<CKernelMachine*>(m_machine);
+	if (m_kernel_cache && kernel_machine)
+	{
+		auto kernel = kernel_machine->get_kernel();
+		if (kernel && kernel->get_kernel_type() != K_CUSTOM)
+		{
+			kernel_matrix =
+			    m_kernel_cache->get_kernel_matrix(kernel, m_features);
+		}
+		SG_UNREF(kernel);
+	}
+
 	#pragma omp parallel for shared(results)
 	for (auto i = 0; i<num_subsets; ++i)
 	{
@@ -104,15 +214,38 @@ float64_t CCrossValidation::evaluate_one_run(int64_t index) const
 		auto machine = make_clone(m_machine,
 				ParameterProperties::HYPER | ParameterProperties::SETTING);
 
-		SGVector<index_t> idx_train =
-			m_splitting_strategy->generate_subset_inverse(i);
+		SGVector<index_t> idx_train;
+		SGVector<index_t> idx_test;
+		if (warm_start)
+		{
+			idx_train = m_warm_start_train[offset + i];
+			idx_test = m_warm_start_test[offset + i];
+
+			copy_model(m_warm_start_machines[offset + i], machine);
+			machine->set_warm_start(true);
+		}
+		else
+		{
+			idx_train = m_splitting_strategy->generate_subset_inverse(i);
+			idx_test = m_splitting_strategy->generate_subset_indices(i);
+		}
 
-		SGVector<index_t> idx_test =
-			m_splitting_strategy->generate_subset_indices(i);
+		CFeatures* features_train;
+		CFeatures* features_test;
+		if (kernel_matrix)
+		{
+			machine->as<CKernelMachine>()->set_kernel(
+			    new CCustomKernel(kernel_matrix));
+			features_train = new CIndexFeatures(idx_train);
+			features_test = new CIndexFeatures(idx_test);
+		}
+		else
+		{
+			features_train = view(m_features, idx_train);
+			features_test = view(m_features, idx_test);
+		}
 
-		auto features_train = view(m_features, idx_train);
 		auto labels_train = view(m_labels, idx_train);
-		auto features_test = view(m_features, idx_test);
 		auto labels_test = view(m_labels, idx_test);
 		SG_REF(features_train);
 		SG_REF(labels_train);
@@ -130,6 +263,15 @@ float64_t CCrossValidation::evaluate_one_run(int64_t index) const
 		results[i] = evaluation_criterion->evaluate(result_labels, labels_test);
 		SG_INFO("Result of cross-validation fold %d/%d is %f\n", i+1, num_subsets, results[i])
 
+		if (m_warm_start)
+		{
+			SG_REF(machine);
+			SG_UNREF(m_warm_start_machines[offset + i]);
+			m_warm_start_machines[offset + i] = machine;
+			m_warm_start_train[offset + i] = idx_train;
+			m_warm_start_test[offset + i] = idx_test;
+		}
+
 		SG_UNREF(machine);
 		SG_UNREF(features_train);
 		SG_UNREF(labels_train);
@@ -139,6 +281,8 @@ float64_t CCrossValidation::evaluate_one_run(int64_t index) const
 		SG_UNREF(result_labels);
 	}
 
+	SG_UNREF(kernel_matrix);
+
 	/* build arithmetic mean of results */
 	float64_t mean = CStatistics::mean(results);
 
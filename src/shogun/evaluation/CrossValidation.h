@@ -15,6 +15,8 @@
 #include <shogun/evaluation/MachineEvaluation.h>
 #include <shogun/mathematics/Seedable.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -22,6 +24,7 @@ namespace shogun
 	class CCrossValidationOutput;
 	class CrossValidationStorage;
 	class CList;
+	class CKernelMatrixCache;
 
 	/** @brief type to encapsulate the results of an evaluation run.
 	 */
@@ -159,6 +162,41 @@ namespace shogun
 		/** setter for the number of runs to use for evaluation */
 		void set_num_runs(int32_t num_runs);
 
+		virtual CMachineEvaluation* clone_for_machine(
+		    CMachine* machine, CFeatures* features = NULL,
+		    CLabels* labels = NULL) const override;
+
+		/** Sets a cache of precomputed kernel matrices. If set and the
+		 * machine is a kernel machine, the kernel matrix on all features is
+		 * taken from the cache (and computed only if not cached), and each
+		 * fold indexes into it instead of evaluating the kernel again.
+		 * Sharing one cache between several evaluations (e.g. in model
+		 * selection) also avoids recomputing the kernel matrix for
+		 * combinations that only change parameters of the machine.
+		 *
+		 * @param cache kernel matrix cache, or NULL to disable caching
+		 */
+		void set_kernel_cache(CKernelMatrixCache* cache);
+
+		/** @return kernel matrix cache, or NULL if not set */
+		CKernelMatrixCache* get_kernel_cache() const;
+
+		/** Sets whether consecutive evaluations warm start from each other.
+		 * If enabled, the folds of the first evaluation are kept and reused
+		 * by all following evaluations, and the machine of each fold starts
+		 * training from the model trained on the same fold in the previous
+		 * evaluation (see CMachine::set_warm_start()). This speeds up
+		 * evaluating a sequence of similar hyperparameters, e.g. a
+		 * regularization path. Only meaningful as long as the features and
+		 * labels do not change. Calling this discards all kept folds.
+		 *
+		 * @param warm_start whether to warm start evaluations
+		 */
+		void set_warm_start(bool warm_start);
+
+		/** @return whether consecutive evaluations warm start */
+		bool get_warm_start() const;
+
 		/** @return name of the SGSerializable */
 		virtual const char* get_name() const
 		{
@@ -168,6 +206,9 @@ namespace shogun
 	private:
 		void init();
 
+		/** discards the folds and machines kept for warm starting */
+		void clear_warm_start() const;
+
 	protected:
 		/**
 		 * Does the actual evaluation.
@@ -188,6 +229,21 @@ namespace shogun
 
 		/** number of evaluation runs for one fold */
 		int32_t m_num_runs;
+
+		/** cache of precomputed kernel matrices */
+		CKernelMatrixCache* m_kernel_cache;
+
+		/** whether consecutive evaluations warm start */
+		bool m_warm_start;
+
+		/** training indices of all folds of all runs kept for warm starting */
+		mutable std::vector<SGVector<index_t>> m_warm_start_train;
+
+		/** test indices of all folds of all runs kept for warm starting */
+		mutable std::vector<SGVector<index_t>> m_warm_start_test;
+
+		/** machines of all folds of all runs kept for warm starting */
+		mutable std::vector<CMachine*> m_warm_start_machines;
 	};
 }
 
@@ -117,7 +117,45 @@ CMachine* CMachineEvaluation::get_machine() const
 	return m_machine;
 }
 
+void CMachineEvaluation::set_machine(CMachine* machine)
+{
+	SG_REF(machine);
+	SG_UNREF(m_machine);
+	m_machine = machine;
+}
+
 EEvaluationDirection CMachineEvaluation::get_evaluation_direction() const
 {
 	return m_evaluation_criterion->get_evaluation_direction();
 }
+
+CMachineEvaluation* CMachineEvaluation::clone_for_machine(
+    CMachine* machine, CFeatures* features, CLabels* labels) const
+{
+	REQUIRE(machine, "No machine provided.\n");
+
+	auto result = create_empty()->as<CMachineEvaluation>();
+
+	result->m_machine = machine;
+	result->m_features = features ? features : m_features;
+	result->m_labels = labels ? labels : m_labels;
+	result->m_evaluation_criterion = m_evaluation_criterion;
+	SG_REF(result->m_machine);
+	SG_REF(result->m_features);
+	SG_REF(result->m_labels);
+	SG_REF(result->m_evaluation_criterion);
+
+	if (m_splitting_strategy)
+	{
+		result->m_splitting_strategy = make_clone(m_splitting_strategy);
+		if (labels)
+		{
+			auto cloned_labels =
+			    result->m_splitting_strategy->get<CLabels*>("labels");
+			result->m_splitting_strategy->put("labels", labels);
+			SG_UNREF(cloned_labels);
+		}
+	}
+
+	return result;
+}
@@ -76,6 +76,29 @@ namespace shogun
 		/** @return underlying learning machine */
 		CMachine* get_machine() const;
 
+		/** set the learning machine to evaluate
+		 *
+		 * @param machine learning machine
+		 */
+		void set_machine(CMachine* machine);
+
+		/** Creates an evaluation object of the same type and with the same
+		 * settings that evaluates the given machine instead of the attached
+		 * one. Features, labels and the evaluation criterion are shared, the
+		 * splitting strategy is cloned. Therefore the returned object can be
+		 * evaluated concurrently with this one.
+		 *
+		 * @param machine learning machine to evaluate
+		 * @param features features to evaluate on, or NULL to use the
+		 * attached ones
+		 * @param labels labels that correspond to the features, or NULL to
+		 * use the attached ones
+		 * @return evaluation object (already SG_REF'ed)
+		 */
+		virtual CMachineEvaluation* clone_for_machine(
+		    CMachine* machine, CFeatures* features = NULL,
+		    CLabels* labels = NULL) const;
+
 	protected:
 		/** Initialize Object */
 		virtual void init();
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <shogun/mathematics/Math.h>
 #include <ctype.h>
+#include <type_traits>
 
 #include <shogun/features/Alphabet.h>
 #include <shogun/io/SGIO.h>
@@ -750,9 +751,47 @@ void CAlphabet::load_serializable_post() noexcept(false)
 
 namespace shogun
 {
+/* Computes the same words as the translate_from_single_order functions in a
+ * single pass, in which each word is obtained from the word of the previous
+ * position by shifting in one symbol. Only done for unsigned words that hold
+ * all symbols, as otherwise the results of the shifts differ. */
+template <class ST>
+static bool translate_from_single_order_rolling(ST* obs, int32_t sequence_length, int32_t start, int32_t p_order, int32_t max_val, bool reversed)
+{
+	const int32_t num_bits=max_val*p_order;
+	const int32_t word_bits=sizeof(ST)*8;
+
+	if (!std::is_unsigned<ST>::value || std::is_same<ST, bool>::value ||
+			num_bits>word_bits || p_order<1)
+		return false;
+
+	const ST mask=(ST) (num_bits>=64 ? ~uint64_t(0) : (uint64_t(1) << num_bits)-1);
+	const int32_t top=max_val*(p_order-1);
+	ST value=0;
+
+	for (int32_t i=0; i<sequence_length; i++)
+	{
+		if (reversed)
+			value=(ST) ((value >> max_val) | (obs[i] << top));
+		else
+			value=(ST) (((value << max_val) | obs[i]) & mask);
+		obs[i]=value;
+	}
+
+	if (start>0)
+	{
+		for (int32_t i=start; i<sequence_length; i++)
+			obs[i-start]=obs[i];
+	}
+	return true;
+}
+
 template <class ST>
 void CAlphabet::translate_from_single_order(ST* obs, int32_t sequence_length, int32_t start, int32_t p_order, int32_t max_val)
 {
+	if (translate_from_single_order_rolling(obs, sequence_length, start, p_order, max_val, false))
+		return;
+
 	int32_t i,j;
 	ST value=0;
 
@@ -791,6 +830,9 @@ void CAlphabet::translate_from_single_order(ST* obs, int32_t sequence_length, in
 template <class ST>
 void CAlphabet::translate_from_single_order_reversed(ST* obs, int32_t sequence_length, int32_t start, int32_t p_order, int32_t max_val)
 {
+	if (translate_from_single_order_rolling(obs, sequence_length, start, p_order, max_val, true))
+		return;
+
 	int32_t i,j;
 	ST value=0;
 
@@ -839,6 +881,9 @@ void CAlphabet::translate_from_single_order(ST* obs, int32_t sequence_length, in
 {
 	ASSERT(gap>=0)
 
+	if (gap==0 && translate_from_single_order_rolling(obs, sequence_length, start, p_order, max_val, false))
+		return;
+
 	const int32_t start_gap=(p_order-gap)/2;
 	const int32_t end_gap=start_gap+gap;
 
@@ -901,6 +946,9 @@ void CAlphabet::translate_from_single_order_reversed(ST* obs, int32_t sequence_l
 {
 	ASSERT(gap>=0)
 
+	if (gap==0 && translate_from_single_order_rolling(obs, sequence_length, start, p_order, max_val, true))
+		return;
+
 	const int32_t start_gap=(p_order-gap)/2;
 	const int32_t end_gap=start_gap+gap;
 
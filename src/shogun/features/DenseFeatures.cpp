@@ -14,6 +14,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/base/Parameter.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/SIMDKernels.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <algorithm>
@@ -478,6 +479,31 @@ void CDenseFeatures<float64_t>::add_to_dense_vec(float64_t alpha, int32_t vec_id
 	free_feature_vector(vec1, vec_idx1, vfree);
 }
 
+template<>
+void CDenseFeatures<float32_t>::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
+		float64_t* vec2, int32_t vec2_len, bool abs_val) const
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	float32_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * CMath::abs(vec1[i]);
+	}
+	else
+	{
+		simd::dense_axpy(alpha, vec1, vec2, num_features);
+	}
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+}
+
 template<class ST> int32_t CDenseFeatures<ST>::get_nnz_features_for_vector(int32_t num) const
 {
 	return num_features;
@@ -640,6 +666,74 @@ CDenseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 	return result;
 }
 
+template <>
+float64_t CDenseFeatures<float32_t>::dot(
+	int32_t vec_idx1, const SGVector<float64_t>& vec2) const
+{
+	SGVector<float32_t> vec1 = get_feature_vector(vec_idx1);
+	REQUIRE(
+		vec1.vlen == vec2.vlen,
+		"Dimension of vector (%d) should match number of features (%d)\n",
+		vec2.vlen, vec1.vlen);
+
+	float64_t result = simd::dense_dot(vec1.vector, vec2.vector, vec1.vlen);
+	free_feature_vector(vec1, vec_idx1);
+	return result;
+}
+
+template <class ST>
+void CDenseFeatures<ST>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	CDotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+}
+
+template <>
+void CDenseFeatures<float32_t>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	if (m_subset_stack->has_subsets() || !feature_matrix.matrix)
+	{
+		CDotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+		return;
+	}
+
+	ASSERT(output)
+	ASSERT(start >= 0)
+	ASSERT(start < stop)
+	ASSERT(stop <= get_num_vectors())
+	REQUIRE(
+		dim == num_features,
+		"Dimension of vector (%d) should match number of features (%d)\n",
+		dim, num_features);
+
+	/* vectors of a block share the loads of the dense vector */
+	const int32_t block_size = 64;
+	const int32_t num_blocks = (stop - start + block_size - 1) / block_size;
+
+#pragma omp parallel for schedule(static)
+	for (int32_t block = 0; block < num_blocks; block++)
+	{
+		int32_t offset = block * block_size;
+		int32_t len = CMath::min(block_size, stop - start - offset);
+		float64_t* block_output = output + offset;
+
+		simd::dense_dot_batch(
+			feature_matrix.matrix + int64_t(start + offset) * num_features,
+			num_features, len, vec, block_output);
+
+		for (int32_t i = 0; i < len; i++)
+		{
+			if (alphas)
+				block_output[i] = alphas[offset + i] * block_output[i] + b;
+			else
+				block_output[i] += b;
+		}
+	}
+}
+
 template<class ST> bool CDenseFeatures<ST>::is_equal(CDenseFeatures* rhs)
 {
 	if ( num_features != rhs->num_features || num_vectors != rhs->num_vectors )
@@ -346,6 +346,22 @@ public:
 	virtual float64_t
 	dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const override;
 
+	/** Compute the dot product for a range of vectors. Single precision
+	 * features stored in memory without subset are processed in blocks of
+	 * vectors, otherwise dot is called for each vector.
+	 *
+	 * @param output result for the given vector range
+	 * @param start first index of vector range
+	 * @param stop last index of vector range
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range(float64_t* output, int32_t start,
+			int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim,
+			float64_t b) const;
+
 	/** add vector 1 multiplied with alpha to dense vector2
 	 *
 	 * possible with subset
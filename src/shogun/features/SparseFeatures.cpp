@@ -3,6 +3,7 @@
 #include <shogun/features/SparseFeatures.h>
 #include <shogun/preprocessor/SparsePreprocessor.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/SIMDKernels.h>
 #include <shogun/io/SGIO.h>
 
 #include <string.h>
@@ -35,9 +36,19 @@ template<class ST> CSparseFeatures<ST>::CSparseFeatures(SGMatrix<ST> dense)
 	set_full_feature_matrix(dense);
 }
 
+template<class ST> CSparseFeatures<ST>::CSparseFeatures(SGVector<int64_t> indptr,
+	SGVector<index_t> indices, SGVector<ST> values, index_t num_features)
+: CDotFeatures(0), feature_cache(NULL)
+{
+	init();
+
+	set_csr_feature_matrix(indptr, indices, values, num_features);
+}
+
 template<class ST> CSparseFeatures<ST>::CSparseFeatures(const CSparseFeatures & orig)
 : CDotFeatures(orig), sparse_feature_matrix(orig.sparse_feature_matrix),
-	feature_cache(orig.feature_cache)
+	feature_cache(orig.feature_cache), m_csr_indptr(orig.m_csr_indptr),
+	m_csr_indices(orig.m_csr_indices), m_csr_values(orig.m_csr_values)
 {
 	init();
 
@@ -102,6 +113,12 @@ template<class ST> SGVector<ST> CSparseFeatures<ST>::get_full_feature_vector(int
 
 template<class ST> int32_t CSparseFeatures<ST>::get_nnz_features_for_vector(int32_t num) const
 {
+	if (is_csr())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		return m_csr_indptr[real_num+1]-m_csr_indptr[real_num];
+	}
+
 	SGSparseVector<ST> sv = get_sparse_feature_vector(num);
 	int32_t len=sv.num_feat_entries;
 	free_sparse_feature_vector(num);
@@ -119,6 +136,17 @@ template<class ST> SGSparseVector<ST> CSparseFeatures<ST>::get_sparse_feature_ve
 	{
 		return sparse_feature_matrix[real_num];
 	}
+	else if (is_csr())
+	{
+		int64_t begin=m_csr_indptr[real_num];
+		SGSparseVector<ST> result(m_csr_indptr[real_num+1]-begin);
+		for (int32_t i=0; i<result.num_feat_entries; i++)
+		{
+			result.features[i].feat_index=m_csr_indices[begin+i];
+			result.features[i].entry=m_csr_values[begin+i];
+		}
+		return result;
+	}
 	else
 	{
 		SGSparseVector<ST> result;
@@ -172,6 +200,22 @@ template<class ST> SGSparseVector<ST> CSparseFeatures<ST>::get_sparse_feature_ve
 
 template<class ST> ST CSparseFeatures<ST>::dense_dot(ST alpha, int32_t num, ST* vec, int32_t dim, ST b) const
 {
+	if (is_csr())
+	{
+		ASSERT(vec)
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		const index_t* indices=m_csr_indices.vector;
+		const ST* values=m_csr_values.vector;
+
+		ST result=b;
+		for (int64_t k=m_csr_indptr[real_num]; k<m_csr_indptr[real_num+1]; k++)
+		{
+			if (indices[k]<dim)
+				result+=alpha*vec[indices[k]]*values[k];
+		}
+		return result;
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
 	ST result = sv.dense_dot(alpha,vec,dim,b);
 	free_sparse_feature_vector(num);
@@ -186,6 +230,27 @@ template<class ST> void CSparseFeatures<ST>::add_to_dense_vec(float64_t alpha, i
 		"add_to_dense_vec(num=%d,dim=%d): dim should contain number of features %d\n",
 		num, dim, get_num_features());
 
+	if (is_csr())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(num);
+		const index_t* indices=m_csr_indices.vector;
+		const ST* values=m_csr_values.vector;
+		int64_t begin=m_csr_indptr[real_num];
+		int64_t end=m_csr_indptr[real_num+1];
+
+		if (abs_val)
+		{
+			for (int64_t k=begin; k<end; k++)
+				vec[indices[k]]+=alpha*CMath::abs(values[k]);
+		}
+		else
+		{
+			simd::sparse_axpy(alpha, indices+begin, 1, values+begin, 1,
+					end-begin, vec);
+		}
+		return;
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
 
 	if (sv.features)
@@ -199,13 +264,7 @@ template<class ST> void CSparseFeatures<ST>::add_to_dense_vec(float64_t alpha, i
 			}
 		}
 		else
-		{
-			for (int32_t i=0; i<sv.num_feat_entries; i++)
-			{
-				vec[sv.features[i].feat_index]+=alpha
-						*sv.features[i].entry;
-			}
-		}
+			simd::sparse_axpy(alpha, sv, vec);
 	}
 
 	free_sparse_feature_vector(num);
@@ -231,6 +290,15 @@ template<class ST> SGSparseMatrix<ST> CSparseFeatures<ST>::get_sparse_feature_ma
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 
+	if (is_csr())
+	{
+		SGSparseMatrix<ST> matrix(get_num_features(), get_num_vectors());
+		for (index_t i=0; i<matrix.num_vectors; i++)
+			matrix.sparse_matrix[i]=get_sparse_feature_vector(i);
+
+		return matrix;
+	}
+
 	return sparse_feature_matrix;
 }
 
@@ -239,7 +307,7 @@ template<class ST> CSparseFeatures<ST>* CSparseFeatures<ST>::get_transposed()
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 
-	return new CSparseFeatures<ST>(sparse_feature_matrix.get_transposed());
+	return new CSparseFeatures<ST>(get_sparse_feature_matrix().get_transposed());
 }
 
 template<class ST> void CSparseFeatures<ST>::set_sparse_feature_matrix(SGSparseMatrix<ST> sm)
@@ -247,6 +315,7 @@ template<class ST> void CSparseFeatures<ST>::set_sparse_feature_matrix(SGSparseM
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 
+	free_sparse_feature_matrix();
 	sparse_feature_matrix=sm;
 
 	// TODO: check should be implemented in sparse matrix class
@@ -258,13 +327,69 @@ template<class ST> void CSparseFeatures<ST>::set_sparse_feature_matrix(SGSparseM
 	}
 }
 
+template<class ST> void CSparseFeatures<ST>::set_csr_feature_matrix(SGVector<int64_t> indptr,
+	SGVector<index_t> indices, SGVector<ST> values, index_t num_features)
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("Not allowed with subset\n");
+
+	REQUIRE(indptr.vlen>0 && indptr[0]==0,
+		"Offsets of vectors should start with 0\n");
+	REQUIRE(indices.vlen==values.vlen,
+		"Number of indices (%d) and values (%d) should match\n",
+		indices.vlen, values.vlen);
+	REQUIRE(indptr[indptr.vlen-1]==indices.vlen,
+		"Last offset (%ld) should be the number of non-zero entries (%d)\n",
+		indptr[indptr.vlen-1], indices.vlen);
+
+	for (index_t i=0; i<indptr.vlen-1; i++)
+	{
+		REQUIRE(indptr[i]<=indptr[i+1],
+			"Offsets of vectors should not decrease (vector %d)\n", i);
+		for (int64_t k=indptr[i]; k<indptr[i+1]; k++)
+		{
+			REQUIRE(indices[k]>=0 && indices[k]<num_features,
+				"Feature index %d of vector %d exceeds [0;%d]\n",
+				indices[k], i, num_features-1);
+			REQUIRE(k==indptr[i] || indices[k-1]<indices[k],
+				"Feature indices of vector %d should be increasing\n", i);
+		}
+	}
+
+	free_sparse_feature_matrix();
+	m_csr_indptr=indptr;
+	m_csr_indices=indices;
+	m_csr_values=values;
+	// no vectors are kept in the array of sparse vectors
+	sparse_feature_matrix.num_features=num_features;
+}
+
+template<class ST> bool CSparseFeatures<ST>::is_csr() const
+{
+	return m_csr_indptr.vlen>0;
+}
+
 template<class ST> SGMatrix<ST> CSparseFeatures<ST>::get_full_feature_matrix()
 {
 	SGMatrix<ST> full(get_num_features(), get_num_vectors());
 	full.zero();
 
 	SG_INFO("converting sparse features to full feature matrix of %d x %d"
-			" entries\n", sparse_feature_matrix.num_vectors, get_num_features())
+			" entries\n", get_num_vectors(), get_num_features())
+
+	if (is_csr())
+	{
+		for (int32_t v=0; v<full.num_cols; v++)
+		{
+			int32_t idx=m_subset_stack->subset_idx_conversion(v);
+			ST* column=full.get_column_vector(v);
+
+			for (int64_t k=m_csr_indptr[idx]; k<m_csr_indptr[idx+1]; k++)
+				column[m_csr_indices[k]]=m_csr_values[k];
+		}
+
+		return full;
+	}
 
 	for (int32_t v=0; v<full.num_cols; v++)
 	{
@@ -292,6 +417,9 @@ template<class ST> void CSparseFeatures<ST>::free_sparse_features()
 template<class ST> void CSparseFeatures<ST>::free_sparse_feature_matrix()
 {
 	sparse_feature_matrix=SGSparseMatrix<ST>();
+	m_csr_indptr=SGVector<int64_t>();
+	m_csr_indices=SGVector<index_t>();
+	m_csr_values=SGVector<ST>();
 }
 
 template<class ST> void CSparseFeatures<ST>::set_full_feature_matrix(SGMatrix<ST> full)
@@ -303,7 +431,10 @@ template<class ST> void CSparseFeatures<ST>::set_full_feature_matrix(SGMatrix<ST
 
 template<class ST> int32_t  CSparseFeatures<ST>::get_num_vectors() const
 {
-	return m_subset_stack->has_subsets() ? m_subset_stack->get_size() : sparse_feature_matrix.num_vectors;
+	if (m_subset_stack->has_subsets())
+		return m_subset_stack->get_size();
+
+	return is_csr() ? m_csr_indptr.vlen-1 : sparse_feature_matrix.num_vectors;
 }
 
 template<class ST> int32_t  CSparseFeatures<ST>::get_num_features() const
@@ -336,6 +467,18 @@ template<class ST> int64_t CSparseFeatures<ST>::get_num_nonzero_entries()
 {
 	int64_t num=0;
 	index_t num_vec=get_num_vectors();
+
+	if (is_csr())
+	{
+		if (!m_subset_stack->has_subsets())
+			return m_csr_indices.vlen;
+
+		for (int32_t i=0; i<num_vec; i++)
+			num+=get_nnz_features_for_vector(i);
+
+		return num;
+	}
+
 	for (int32_t i=0; i<num_vec; i++)
 		num+=sparse_feature_matrix[m_subset_stack->subset_idx_conversion(i)].num_feat_entries;
 
@@ -347,6 +490,19 @@ template<class ST> float64_t* CSparseFeatures<ST>::compute_squared(float64_t* sq
 	ASSERT(sq)
 
 	index_t num_vec=get_num_vectors();
+	if (is_csr())
+	{
+		for (int32_t i=0; i<num_vec; i++)
+		{
+			index_t real_num=m_subset_stack->subset_idx_conversion(i);
+			sq[i]=0;
+			for (int64_t k=m_csr_indptr[real_num]; k<m_csr_indptr[real_num+1]; k++)
+				sq[i]+=m_csr_values[k]*m_csr_values[k];
+		}
+
+		return sq;
+	}
+
 	for (int32_t i=0; i<num_vec; i++)
 	{
 		sq[i]=0;
@@ -440,6 +596,30 @@ template<class ST> float64_t CSparseFeatures<ST>::dot(int32_t vec_idx1,
 	ASSERT(df->get_feature_class() == get_feature_class())
 	CSparseFeatures<ST>* sf = (CSparseFeatures<ST>*) df;
 
+	if (is_csr() && sf->is_csr())
+	{
+		index_t a=m_subset_stack->subset_idx_conversion(vec_idx1);
+		index_t b=sf->m_subset_stack->subset_idx_conversion(vec_idx2);
+		int64_t a_idx=m_csr_indptr[a];
+		int64_t a_end=m_csr_indptr[a+1];
+		int64_t b_idx=sf->m_csr_indptr[b];
+		int64_t b_end=sf->m_csr_indptr[b+1];
+		const index_t* a_indices=m_csr_indices.vector;
+		const index_t* b_indices=sf->m_csr_indices.vector;
+
+		ST result=0;
+		while (a_idx<a_end && b_idx<b_end)
+		{
+			if (a_indices[a_idx]<b_indices[b_idx])
+				a_idx++;
+			else if (a_indices[a_idx]>b_indices[b_idx])
+				b_idx++;
+			else
+				result+=m_csr_values[a_idx++]*sf->m_csr_values[b_idx++];
+		}
+		return result;
+	}
+
 	SGSparseVector<ST> avec=get_sparse_feature_vector(vec_idx1);
 	SGSparseVector<ST> bvec=sf->get_sparse_feature_vector(vec_idx2);
 
@@ -468,6 +648,16 @@ CSparseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) cons
 		vec_idx1, vec2.size(), get_num_features());
 
 	float64_t result=0;
+	if (is_csr())
+	{
+		index_t real_num=m_subset_stack->subset_idx_conversion(vec_idx1);
+		int64_t begin=m_csr_indptr[real_num];
+
+		return simd::sparse_dot(m_csr_indices.vector+begin, 1,
+				m_csr_values.vector+begin, 1, m_csr_indptr[real_num+1]-begin,
+				vec2.vector);
+	}
+
 	SGSparseVector<ST> sv=get_sparse_feature_vector(vec_idx1);
 
 	if (sv.features)
@@ -482,8 +672,7 @@ CSparseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) cons
 			"vector dimension %d)\n",
 			vec_idx1, vec2.size(), sv.get_num_dimensions());
 
-		for (int32_t i=0; i<sv.num_feat_entries; i++)
-			result+=vec2[sv.features[i].feat_index]*sv.features[i].entry;
+		result=simd::sparse_dot(sv, vec2.vector);
 	}
 
 	free_sparse_feature_vector(vec_idx1);
@@ -507,7 +696,7 @@ template<class ST> void* CSparseFeatures<ST>::get_feature_iterator(int32_t vecto
 				"requested %d)\n", get_num_vectors(), vector_index);
 	}
 
-	if (!sparse_feature_matrix.sparse_matrix)
+	if (!sparse_feature_matrix.sparse_matrix && !is_csr())
 		SG_ERROR("Requires a in-memory feature matrix\n")
 
 	sparse_feature_iterator* it=new sparse_feature_iterator();
@@ -549,6 +738,30 @@ template<class ST> void CSparseFeatures<ST>::free_feature_iterator(void* iterato
 
 template<class ST> CFeatures* CSparseFeatures<ST>::copy_subset(SGVector<index_t> indices) const
 {
+	if (is_csr())
+	{
+		SGVector<int64_t> indptr(indices.vlen+1);
+		indptr[0]=0;
+		for (index_t i=0; i<indices.vlen; ++i)
+			indptr[i+1]=indptr[i]+get_nnz_features_for_vector(indices.vector[i]);
+
+		SGVector<index_t> feature_indices(indptr[indices.vlen]);
+		SGVector<ST> values(indptr[indices.vlen]);
+		for (index_t i=0; i<indices.vlen; ++i)
+		{
+			index_t real_index=m_subset_stack->subset_idx_conversion(indices.vector[i]);
+			int64_t begin=m_csr_indptr[real_index];
+			int64_t len=indptr[i+1]-indptr[i];
+			sg_memcpy(feature_indices.vector+indptr[i], m_csr_indices.vector+begin,
+					sizeof(index_t)*len);
+			sg_memcpy(values.vector+indptr[i], m_csr_values.vector+begin,
+					sizeof(ST)*len);
+		}
+
+		return new CSparseFeatures<ST>(indptr, feature_indices, values,
+				get_num_features());
+	}
+
 	SGSparseMatrix<ST> matrix_copy=SGSparseMatrix<ST>(get_dim_feature_space(),
 			indices.vlen);
 
@@ -580,6 +793,10 @@ template<class ST> SGSparseVectorEntry<ST>* CSparseFeatures<ST>::compute_sparse_
 
 template<class ST> void CSparseFeatures<ST>::sort_features()
 {
+	// indices are checked to be increasing in the compressed sparse row layout
+	if (is_csr())
+		return;
+
 	sparse_feature_matrix.sort_features();
 }
 
@@ -597,6 +814,13 @@ template<class ST> void CSparseFeatures<ST>::init()
 
 	m_parameters->add(&sparse_feature_matrix.num_features, "sparse_feature_matrix.num_features",
 			"Total number of features.");
+
+	SG_ADD(&m_csr_indptr, "csr_indptr",
+			"Offsets of vectors in the compressed sparse row layout.");
+	SG_ADD(&m_csr_indices, "csr_indices",
+			"Feature indices in the compressed sparse row layout.");
+	SG_ADD(&m_csr_values, "csr_values",
+			"Non-zero entries in the compressed sparse row layout.");
 }
 
 #define GET_FEATURE_TYPE(sg_type, f_type)									\
@@ -641,7 +865,7 @@ template<class ST> void CSparseFeatures<ST>::save(CFile* writer)
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 	ASSERT(writer)
-	sparse_feature_matrix.save(writer);
+	get_sparse_feature_matrix().save(writer);
 }
 
 template<class ST> void CSparseFeatures<ST>::save_with_labels(CLibSVMFile* writer, SGVector<float64_t> labels)
@@ -649,7 +873,7 @@ template<class ST> void CSparseFeatures<ST>::save_with_labels(CLibSVMFile* write
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Not allowed with subset\n");
 	ASSERT(writer)
-	sparse_feature_matrix.save_with_labels(writer, labels);
+	get_sparse_feature_matrix().save_with_labels(writer, labels);
 }
 
 template class CSparseFeatures<bool>;
@@ -37,6 +37,13 @@ template <class T> class CCache;
  * should be freed (this operation is a NOP in most cases) via
  * free_sparse_feature_vector().
  *
+ * Alternatively, features can be stored in the compressed sparse row (CSR)
+ * layout, see set_csr_feature_matrix(): offsets of the vectors, indices and
+ * values of all non-zero features are then kept in three contiguous arrays,
+ * which may be owned by the caller. Dot products and additions to dense
+ * vectors stream over these arrays while get_sparse_feature_vector()
+ * returns a copy of the requested vector.
+ *
  * As this is a template class it can directly be used for different data types
  * like sparse matrices of real valued, integer, byte etc type.
  *
@@ -75,6 +82,19 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		/** copy constructor from DenseFeatures */
 		CSparseFeatures(CDenseFeatures<ST>* dense);
 
+		/** convenience constructor that creates sparse features from
+		 * a matrix in the compressed sparse row layout
+		 *
+		 * @see set_csr_feature_matrix
+		 *
+		 * @param indptr offsets of vectors, of length num_vectors+1
+		 * @param indices feature indices of non-zero entries
+		 * @param values non-zero entries
+		 * @param num_features dimension of the feature space
+		 */
+		CSparseFeatures(SGVector<int64_t> indptr, SGVector<index_t> indices,
+				SGVector<ST> values, index_t num_features);
+
 		/** constructor loading features from file
 		 *
 		 * @param loader File object to load data from
@@ -185,7 +205,8 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		SGSparseVector<ST>* get_sparse_feature_matrix(int32_t &num_feat, int32_t &num_vec);
 
-		/** get the sparse feature matrix
+		/** get the sparse feature matrix, converted from the compressed
+		 * sparse row layout if necessary
 		 *
 		 * not possible with subset
 		 *
@@ -224,6 +245,28 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
         void set_sparse_feature_matrix(SGSparseMatrix<ST> sm);
 
+		/** set sparse feature matrix in the compressed sparse row layout.
+		 * Non-zero entries of vector i are indices[k],values[k] for k in
+		 * [indptr[i],indptr[i+1]), with indices increasing. The arrays are
+		 * not copied, so they can wrap external buffers without reference
+		 * counting as long as these outlive the features.
+		 *
+		 * not possible with subset
+		 *
+		 * @param indptr offsets of vectors, of length num_vectors+1
+		 * @param indices feature indices of non-zero entries
+		 * @param values non-zero entries
+		 * @param num_features dimension of the feature space
+		 */
+		void set_csr_feature_matrix(SGVector<int64_t> indptr,
+				SGVector<index_t> indices, SGVector<ST> values,
+				index_t num_features);
+
+		/** @return whether features are stored in the compressed sparse
+		 * row layout
+		 */
+		bool is_csr() const;
+
 		/** gets a copy of a full feature matrix
 		 *
 		 * possible with subset
@@ -482,6 +525,16 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 
 		/** feature cache */
 		CCache< SGSparseVectorEntry<ST> >* feature_cache;
+
+		/** offsets of vectors in the compressed sparse row layout */
+		SGVector<int64_t> m_csr_indptr;
+
+		/** feature indices of non-zero entries in the compressed sparse
+		 * row layout */
+		SGVector<index_t> m_csr_indices;
+
+		/** non-zero entries in the compressed sparse row layout */
+		SGVector<ST> m_csr_values;
 };
 }
 #endif /* _SPARSEFEATURES__H__ */
@@ -26,6 +26,8 @@
 
 #endif
 
+#include <limits>
+
 namespace shogun
 {
 
@@ -104,6 +106,7 @@ template<class ST> void CStringFeatures<ST>::cleanup()
 	*/
 
 	features.clear();
+	m_packed_strings.reset();
 	symbol_mask_table = SGVector<ST>();
 
 	/* start with a fresh alphabet, but instead of emptying the histogram
@@ -545,8 +548,15 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 	alphabet=new CAlphabet(DNA);
 	num_symbols=alphabet->get_num_symbols();
 
-	std::vector<SGVector<ST>> strings;
-	strings.reserve(num);
+	/* hunks are located first, so that all strings are packed into one
+	 * buffer of their total length */
+	std::vector<char*> hunks;
+	std::vector<int32_t> hunk_lengths;
+	std::vector<int32_t> string_lengths;
+	hunks.reserve(num);
+	hunk_lengths.reserve(num);
+	string_lengths.reserve(num);
+	int64_t num_string_symbols=0;
 	offs=0;
 
 	for (i=0;i<num; i++)
@@ -574,27 +584,12 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 				}
 
 				len=fasta_len-spanned_lines;
-				strings.emplace_back(len);
-
-				ST* str=strings.back().vector;
-				int32_t idx=0;
 				SG_DEBUG("'%.*s', len=%d, spanned_lines=%d\n", (int32_t) id_len, id, (int32_t) len, (int32_t) spanned_lines)
 
-				for (int32_t j=0; j<fasta_len; j++)
-				{
-					if (fasta[j]=='\n')
-						continue;
-
-					ST c=(ST) fasta[j];
-
-					if (ignore_invalid  && !alphabet->is_valid((uint8_t) fasta[j]))
-						c=(ST) 'A';
-
-					if (uint64_t(idx)>=len)
-						SG_ERROR("idx=%d j=%d fasta_len=%d, spanned_lines=%d str='%.*s'\n", idx, j, fasta_len, spanned_lines, idx, str)
-					str[idx++]=c;
-				}
-
+				hunks.push_back(fasta);
+				hunk_lengths.push_back(fasta_len);
+				string_lengths.push_back(len);
+				num_string_symbols+=len;
 				break;
 			}
 
@@ -603,7 +598,36 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 			s=f.get_line(len, offs);
 		}
 	}
-	return set_features(strings);
+
+	std::shared_ptr<ST> packed(SG_MALLOC(ST, num_string_symbols), [](ST* p) { SG_FREE(p); });
+	std::vector<SGVector<ST>> strings;
+	strings.reserve(num);
+	ST* str=packed.get();
+
+	for (i=0; i<num; i++)
+	{
+		char* fasta=hunks[i];
+		int32_t idx=0;
+
+		for (int32_t j=0; j<hunk_lengths[i]; j++)
+		{
+			if (fasta[j]=='\n')
+				continue;
+
+			ST c=(ST) fasta[j];
+
+			if (ignore_invalid  && !alphabet->is_valid((uint8_t) fasta[j]))
+				c=(ST) 'A';
+
+			if (idx>=string_lengths[i])
+				SG_ERROR("idx=%d j=%d fasta_len=%d, str='%.*s'\n", idx, j, hunk_lengths[i], idx, str)
+			str[idx++]=c;
+		}
+
+		strings.emplace_back(str, string_lengths[i], false);
+		str+=string_lengths[i];
+	}
+	return set_packed_features(packed, strings);
 }
 
 template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
@@ -629,6 +653,7 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 	alphabet=new CAlphabet(DNA);
 
 	std::vector<SGVector<ST>> strings;
+	std::shared_ptr<ST> packed;
 
 	ST* str=NULL;
 	if (bitremap_in_single_string)
@@ -644,7 +669,23 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 		str=SG_MALLOC(ST, len);
 	}
 	else
-		strings.resize(num);
+	{
+		/* reads are packed into one buffer of their total length */
+		int64_t num_read_symbols=0;
+		for (i=0; i<num; i++)
+		{
+			f.get_line(len, offs);
+			f.get_line(len, offs);
+			num_read_symbols+=len;
+			f.get_line(len, offs);
+			f.get_line(len, offs);
+		}
+		offs=0;
+
+		packed=std::shared_ptr<ST>(SG_MALLOC(ST, num_read_symbols), [](ST* p) { SG_FREE(p); });
+		str=packed.get();
+		strings.reserve(num);
+	}
 
 	for (i=0;i<num; i++)
 	{
@@ -666,8 +707,9 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 		}
 		else
 		{
-			strings[i] = SGVector<ST>(len);
-			str=strings[i].vector;
+			if (i>0)
+				str+=strings.back().vlen;
+			strings.emplace_back(str, (index_t) len, false);
 
 			if (ignore_invalid)
 			{
@@ -699,6 +741,7 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 		num=1;
 
 	features=std::move(strings);
+	set_packed_buffer(packed);
 
 	return true;
 }
@@ -879,6 +922,202 @@ template<class ST> bool CStringFeatures<ST>::append_features(const std::vector<S
 	return false;
 }
 
+template<class ST> void CStringFeatures<ST>::pack_strings()
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("pack_strings() is not possible on subset")
+
+	int64_t num_symbols=0;
+	for (const auto& str : features)
+		num_symbols+=str.vlen;
+
+	std::shared_ptr<ST> packed(SG_MALLOC(ST, num_symbols), [](ST* p) { SG_FREE(p); });
+	ST* dst=packed.get();
+
+	for (auto& str : features)
+	{
+		index_t len=str.vlen;
+		sg_memcpy(dst, str.vector, sizeof(ST)*len);
+		str=SGVector<ST>(dst, len, false);
+		dst+=len;
+	}
+	set_packed_buffer(packed);
+}
+
+template<class ST> bool CStringFeatures<ST>::is_packed() const
+{
+	return m_packed_strings!=nullptr;
+}
+
+template<class ST> bool CStringFeatures<ST>::set_packed_features(
+		std::shared_ptr<void> buffer, const std::vector<SGVector<ST>>& strings)
+{
+	// set_features() cleans up the previous buffer
+	if (!set_features(strings))
+		return false;
+
+	set_packed_buffer(buffer);
+	return true;
+}
+
+template<class ST> void CStringFeatures<ST>::set_packed_buffer(std::shared_ptr<void> buffer)
+{
+	// strings handed out keep the buffer alive after the features are gone
+	for (auto& str : features)
+		str.set_owner(buffer);
+
+	m_packed_strings=buffer;
+}
+
+/* packed files start with a header of 24 bytes, followed by the offsets of
+ * strings and their symbols at the next multiple of 64 bytes */
+static int64_t packed_file_data_offset(int32_t num_vectors)
+{
+	int64_t end_of_offsets=24+((int64_t) num_vectors+1)*sizeof(int64_t);
+	return (end_of_offsets+63)/64*64;
+}
+
+template<class ST> bool CStringFeatures<ST>::save_packed_file(const char* fname, bool two_bit_dna)
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("save_packed_file() is not possible on subset")
+
+	REQUIRE(!two_bit_dna || alphabet->get_alphabet()==DNA,
+		"Two bits per symbol are only possible with DNA alphabet\n")
+
+	int32_t num_vectors=get_num_vectors();
+	std::vector<int64_t> offsets(num_vectors+1, 0);
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1]=offsets[i]+features[i].vlen;
+	int64_t num_symbols=offsets[num_vectors];
+
+	FILE* file=NULL;
+
+	if (!(file=fopen(fname, "wb")))
+		return false;
+
+	// header
+	const char* id="SGPS";
+	fwrite(id, sizeof(char), 4, file);
+	// alphabet
+	uint8_t a=(uint8_t) alphabet->get_alphabet();
+	fwrite(&a, sizeof(uint8_t), 1, file);
+	// bits per symbol, zero if stored as ST
+	uint8_t bits_per_symbol=two_bit_dna ? 2 : 0;
+	fwrite(&bits_per_symbol, sizeof(uint8_t), 1, file);
+	// size of ST
+	uint16_t symbol_size=sizeof(ST);
+	fwrite(&symbol_size, sizeof(uint16_t), 1, file);
+	// number of vectors
+	fwrite(&num_vectors, sizeof(int32_t), 1, file);
+	// total number of symbols
+	fwrite(&num_symbols, sizeof(int64_t), 1, file);
+	int32_t reserved=0;
+	fwrite(&reserved, sizeof(int32_t), 1, file);
+
+	bool success=fwrite(offsets.data(), sizeof(int64_t), num_vectors+1, file)==size_t(num_vectors+1);
+
+	std::vector<uint8_t> padding(packed_file_data_offset(num_vectors)-24-(num_vectors+1)*sizeof(int64_t), 0);
+	fwrite(padding.data(), sizeof(uint8_t), padding.size(), file);
+
+	if (two_bit_dna)
+	{
+		// four symbols per byte, lowest bits first
+		std::vector<uint8_t> codes((num_symbols+3)/4, 0);
+		int64_t k=0;
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			for (int32_t j=0; j<features[i].vlen; j++, k++)
+			{
+				uint8_t code=alphabet->remap_to_bin((uint8_t) features[i].vector[j]) & 3;
+				codes[k/4]|=code << (2*(k%4));
+			}
+		}
+		success&=fwrite(codes.data(), sizeof(uint8_t), codes.size(), file)==codes.size();
+	}
+	else
+	{
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			success&=fwrite(features[i].vector, sizeof(ST), features[i].vlen,
+					file)==size_t(features[i].vlen);
+		}
+	}
+
+	success&=fclose(file)==0;
+	return success;
+}
+
+template<class ST> bool CStringFeatures<ST>::load_packed_file(const char* fname)
+{
+	remove_all_subsets();
+
+	CMemoryMappedFile<uint8_t>* file=new CMemoryMappedFile<uint8_t>(fname, 'c');
+	SG_REF(file);
+	std::shared_ptr<void> mapping(file,
+			[](CMemoryMappedFile<uint8_t>* f) { SG_UNREF(f); });
+
+	uint8_t* map=file->get_map();
+	int64_t size=file->get_size();
+
+	REQUIRE(size>=24 && memcmp(map, "SGPS", 4)==0,
+		"File %s does not contain packed strings\n", fname)
+
+	uint8_t a=map[4];
+	uint8_t bits_per_symbol=map[5];
+	uint16_t symbol_size;
+	int32_t num_vectors;
+	int64_t num_symbols;
+	sg_memcpy(&symbol_size, map+6, sizeof(uint16_t));
+	sg_memcpy(&num_vectors, map+8, sizeof(int32_t));
+	sg_memcpy(&num_symbols, map+12, sizeof(int64_t));
+
+	REQUIRE(symbol_size==sizeof(ST),
+		"Symbols in %s have %d bytes, features expect %d bytes\n",
+		fname, symbol_size, (int32_t) sizeof(ST))
+	REQUIRE(bits_per_symbol==0 || (bits_per_symbol==2 && a==DNA),
+		"Unsupported encoding of symbols in %s\n", fname)
+	REQUIRE(num_vectors>=0 && num_symbols>=0,
+		"Invalid header in %s\n", fname)
+
+	int64_t data_offset=packed_file_data_offset(num_vectors);
+	int64_t data_size=bits_per_symbol==2 ? (num_symbols+3)/4 : num_symbols*symbol_size;
+	REQUIRE(size>=data_offset+data_size, "File %s is truncated\n", fname)
+
+	const int64_t* offsets=(const int64_t*) (map+24);
+	REQUIRE(offsets[0]==0 && offsets[num_vectors]==num_symbols,
+		"Invalid offsets of strings in %s\n", fname)
+
+	SG_UNREF(alphabet);
+	alphabet=new CAlphabet((EAlphabet) a);
+	SG_REF(alphabet);
+
+	std::shared_ptr<void> buffer=mapping;
+	ST* symbols=(ST*) (map+data_offset);
+
+	if (bits_per_symbol==2)
+	{
+		std::shared_ptr<ST> decoded(SG_MALLOC(ST, num_symbols), [](ST* p) { SG_FREE(p); });
+		const uint8_t* codes=map+data_offset;
+		for (int64_t k=0; k<num_symbols; k++)
+			decoded.get()[k]=(ST) alphabet->remap_to_char((codes[k/4] >> (2*(k%4))) & 3);
+
+		symbols=decoded.get();
+		buffer=decoded;
+	}
+
+	std::vector<SGVector<ST>> strings;
+	strings.reserve(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		REQUIRE(offsets[i]<=offsets[i+1] && offsets[i+1]-offsets[i]<=std::numeric_limits<index_t>::max(),
+			"Invalid offsets of strings in %s\n", fname)
+		strings.emplace_back(symbols+offsets[i], (index_t) (offsets[i+1]-offsets[i]), false);
+	}
+
+	return set_packed_features(buffer, strings);
+}
+
 template<class ST> const std::vector<SGVector<ST>>& CStringFeatures<ST>::get_string_list() const
 {
 	if (m_subset_stack->has_subsets())
@@ -1841,22 +2080,41 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 
 	int32_t num_vectors=sf->get_num_vectors();
 	ASSERT(num_vectors>0)
-	features.reserve(num_vectors);
 
 	SG_DEBUG("%1.0llf symbols in StringFeatures<*> %d symbols in histogram\n", sf->get_num_symbols(),
 			alpha->get_num_symbols_in_histogram());
 
+	std::vector<CT*> char_strings(num_vectors);
+	std::vector<int32_t> lengths(num_vectors);
+	int64_t num_string_symbols=0;
+
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		int32_t len=-1;
 		bool vfree;
-		CT* c=sf->get_feature_vector(i, len, vfree);
+		char_strings[i]=sf->get_feature_vector(i, lengths[i], vfree);
 		ASSERT(!vfree) // won't work when preprocessors are attached
+		num_string_symbols+=lengths[i];
+	}
 
-		features.emplace_back(len);
+	/* strings are packed into one buffer and then remapped and embedded
+	 * independently of each other */
+	std::shared_ptr<ST> packed(SG_MALLOC(ST, num_string_symbols), [](ST* p) { SG_FREE(p); });
+	ST* str=packed.get();
+	features.reserve(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		features.emplace_back(str, lengths[i], false);
+		str+=lengths[i];
+	}
+	set_packed_buffer(packed);
 
-		for (int32_t j=0; j<len; j++)
-			features.back()[j]=(ST) alpha->remap_to_bin(c[j]);
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		ST* fv=features[i].vector;
+		const CT* c=char_strings[i];
+		for (int32_t j=0; j<lengths[i]; j++)
+			fv[j]=(ST) alpha->remap_to_bin(c[j]);
 	}
 
 	original_num_symbols=alpha->get_num_symbols();
@@ -1877,12 +2135,11 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	}
 
 	SG_DEBUG("translate: start=%i order=%i gap=%i(size:%i)\n", start, p_order, gap, sizeof(ST))
+#pragma omp parallel for schedule(dynamic, 64)
 	for (int32_t line=0; line<num_vectors; line++)
 	{
-		int32_t len=0;
-		bool vfree;
-		ST* fv=get_feature_vector(line, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
+		int32_t len=features[line].vlen;
+		ST* fv=features[line].vector;
 
 		if (rev)
 			CAlphabet::translate_from_single_order_reversed(fv, len, start+gap, p_order+gap, max_val, gap);
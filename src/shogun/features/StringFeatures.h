@@ -20,12 +20,15 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/Alphabet.h>
 
+#include <memory>
+
 namespace shogun
 {
 class CAlphabet;
 template <class T> class CDynamicArray;
 class CFile;
 template <class T> class SGVector;
+template <class T> class CMemoryMappedFile;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 struct SSKDoubleFeature
@@ -61,6 +64,11 @@ struct SSKTripleFeature
  *
  * Also note that string features cannot currently be computed on-the-fly.
  *
+ * Large numbers of short strings are better stored packed in one contiguous
+ * buffer, see pack_strings(), which the FASTA and FASTQ loaders do. Packed
+ * strings can be saved and memory mapped from disk with save_packed_file()
+ * and load_packed_file().
+ *
  * (Partly) subset access is supported for this feature type.
  * Simple use the (inherited) add_subset(), remove_subset() functions.
  * If done, all calls that work with features are translated to the subset.
@@ -415,6 +423,42 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		bool append_features(const std::vector<SGVector<ST>>& p_features);
 
+		/** store all strings in one contiguous buffer instead of
+		 * allocating them separately. Strings returned by
+		 * get_string_list() refer to this buffer afterwards and keep
+		 * it alive.
+		 *
+		 * not possible with subset
+		 */
+		void pack_strings();
+
+		/** @return whether strings are stored in one contiguous buffer */
+		bool is_packed() const;
+
+		/** save strings in the packed layout, i.e. offsets of strings
+		 * followed by all their symbols, which load_packed_file() memory
+		 * maps. Strings over the DNA alphabet can be stored with two bits
+		 * per symbol instead.
+		 *
+		 * not possible with subset
+		 *
+		 * @param fname name of file
+		 * @param two_bit_dna whether to store two bits per DNA symbol
+		 * @return whether saving was successful
+		 */
+		bool save_packed_file(const char* fname, bool two_bit_dna=false);
+
+		/** load strings saved by save_packed_file(). Unless stored with
+		 * two bits per symbol, the file is memory mapped copy-on-write and
+		 * strings refer to the mapping directly.
+		 *
+		 * any subset is removed before
+		 *
+		 * @param fname name of file
+		 * @return whether loading was successful
+		 */
+		bool load_packed_file(const char* fname);
+
 		/** returns a copy of the string_list vector (swig friendly)
 		 * @return string_list
 		 */
@@ -636,6 +680,22 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual ST* compute_feature_vector(int32_t num, int32_t& len);
 
+		/** set strings that refer to a contiguous buffer
+		 *
+		 * @param buffer owner of the buffer
+		 * @param strings strings referring to the buffer
+		 * @return whether setting was successful
+		 */
+		bool set_packed_features(std::shared_ptr<void> buffer,
+				const std::vector<SGVector<ST>>& strings);
+
+		/** make the current strings owners of the contiguous buffer
+		 * they refer to
+		 *
+		 * @param buffer owner of the buffer
+		 */
+		void set_packed_buffer(std::shared_ptr<void> buffer);
+
 	private:
 		void init();
 
@@ -666,6 +726,10 @@ template <class ST> class CStringFeatures : public CFeatures
 
 		/** feature cache */
 		CCache<ST>* feature_cache;
+
+		/** owner of the contiguous buffer that strings refer to when
+		 * packed, either allocated or a memory mapped file */
+		std::shared_ptr<void> m_packed_strings;
 };
 }
 #endif // _CSTRINGFEATURES__H__
@@ -7,14 +7,24 @@
 
 #include <shogun/io/CSVFile.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/io/LineReader.h>
+#include <shogun/io/NumberParser.h>
 #include <shogun/io/Parser.h>
 #include <shogun/lib/DelimiterTokenizer.h>
+#include <shogun/mathematics/SIMDKernels.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 using namespace shogun;
 
+/* size of blocks of the file which are parsed at once */
+static const int64_t csv_block_size=16*1024*1024;
+
 CCSVFile::CCSVFile()
 {
 	init();
@@ -205,7 +215,7 @@ void CCSVFile::get_matrix(sg_type*& matrix, int32_t& num_feat, int32_t& num_vec)
 			if (!is_data_transposed) \
 				matrix[i+current_line_idx*num_tokens]=m_parser->read_func(); \
 			else \
-				matrix[current_line_idx+i*num_tokens]=m_parser->read_func(); \
+				matrix[current_line_idx+i*num_lines]=m_parser->read_func(); \
 		} \
 		current_line_idx++; \
 	} \
@@ -229,8 +239,6 @@ GET_MATRIX(read_byte, uint8_t)
 GET_MATRIX(read_char, char)
 GET_MATRIX(read_int, int32_t)
 GET_MATRIX(read_uint, uint32_t)
-GET_MATRIX(read_short_real, float32_t)
-GET_MATRIX(read_real, float64_t)
 GET_MATRIX(read_long_real, floatmax_t)
 GET_MATRIX(read_short, int16_t)
 GET_MATRIX(read_word, uint16_t)
@@ -238,6 +246,238 @@ GET_MATRIX(read_long, int64_t)
 GET_MATRIX(read_ulong, uint64_t)
 #undef GET_MATRIX
 
+/* skips num_lines non-empty lines, as the line reader skips empty ones */
+static const char* skip_csv_lines(const char* begin, const char* end, int32_t& num_lines)
+{
+	while (num_lines>0 && begin<end)
+	{
+		while (begin<end && *begin=='\n')
+			begin++;
+		if (begin==end)
+			break;
+
+		const char* line_end=(const char*) memchr(begin, '\n', end-begin);
+		begin=line_end ? line_end+1 : end;
+		num_lines--;
+	}
+	return begin;
+}
+
+static inline bool is_csv_separator(char c, char delimiter)
+{
+	return c==delimiter || c==' ' || c=='\r';
+}
+
+/* parses lines into rows of values appended to the given vector, a zero
+ * num_fields is set to the number of fields of the first non-empty line,
+ * returns the number of fields of a line which has not num_fields of them
+ * or -1 */
+template <class T>
+static int32_t parse_csv_lines(const char* begin, const char* end, char delimiter,
+		int32_t& num_fields, std::vector<T>& values)
+{
+	const char* p=begin;
+	while (p<end)
+	{
+		int32_t line_fields=0;
+		for (;;)
+		{
+			while (p<end && is_csv_separator(*p, delimiter))
+				p++;
+			if (p==end || *p=='\n')
+				break;
+
+			/* fields which are not numbers are read as zero, as by strtod */
+			T value=0;
+			p=number_parser::parse_real(p, end, value);
+			while (p<end && *p!='\n' && !is_csv_separator(*p, delimiter))
+				p++;
+
+			values.push_back(value);
+			line_fields++;
+		}
+		if (p<end)
+			p++;
+
+		if (line_fields==0)
+			continue;
+		if (num_fields==0)
+			num_fields=line_fields;
+		else if (line_fields!=num_fields)
+			return line_fields;
+	}
+	return -1;
+}
+
+/* appends values to a buffer that grows geometrically */
+template <class T>
+static void append_csv_values(T*& buffer, int64_t& len, int64_t& capacity,
+		const std::vector<T>& values)
+{
+	if (len+int64_t(values.size())>capacity)
+	{
+		int64_t new_capacity=std::max(2*capacity, len+int64_t(values.size()));
+		buffer=SG_REALLOC(T, buffer, capacity, new_capacity);
+		capacity=new_capacity;
+	}
+	std::copy(values.begin(), values.end(), buffer+len);
+	len+=values.size();
+}
+
+/* transposes a row major num_rows x num_cols matrix in place by following
+ * the cycles of the permutation, which needs one bit per element */
+template <class T>
+static void transpose_in_place(T* matrix, int64_t num_rows, int64_t num_cols)
+{
+	int64_t size=num_rows*num_cols;
+	std::vector<bool> moved(size);
+	for (int64_t start=1; start+1<size; start++)
+	{
+		if (moved[start])
+			continue;
+
+		T value=matrix[start];
+		int64_t p=start;
+		do
+		{
+			/* element (i,j) at i*num_cols+j goes to j*num_rows+i */
+			int64_t next=(p%num_cols)*num_rows+p/num_cols;
+			std::swap(matrix[next], value);
+			moved[next]=true;
+			p=next;
+		}
+		while (p!=start);
+	}
+}
+
+template <class T>
+void CCSVFile::read_real_matrix(T*& matrix, int32_t& num_feat, int32_t& num_vec)
+{
+	m_line_reader->reset();
+
+	std::vector<char> block(csv_block_size+1);
+	int64_t block_len=0;
+	int32_t num_to_skip=m_num_to_skip;
+	int32_t num_fields=0;
+	int32_t num_chunks=4*env()->get_num_threads();
+
+	/* values are appended to the output row by row, only the values of
+	 * one block are held besides */
+	matrix=NULL;
+	int64_t num_values=0;
+	int64_t capacity=0;
+	std::vector<T> first_line;
+	std::vector<std::vector<T> > chunk_values(num_chunks);
+	std::vector<int32_t> chunk_errors(num_chunks);
+	std::vector<const char*> chunk_bounds(num_chunks+1);
+
+	SG_SET_LOCALE_C;
+
+	bool eof=false;
+	while (!eof)
+	{
+		block_len+=fread(&block[block_len], 1, block.size()-1-block_len, file);
+		eof=block_len<int64_t(block.size()-1);
+
+		/* parse complete lines only, the rest is kept for the next block */
+		int64_t lines_len=block_len;
+		if (!eof)
+		{
+			while (lines_len>0 && block[lines_len-1]!='\n')
+				lines_len--;
+			if (lines_len==0)
+			{
+				/* a line does not fit into the block */
+				block.resize(2*(block.size()-1)+1);
+				continue;
+			}
+		}
+		block[block_len]='\0';
+
+		const char* begin=skip_csv_lines(&block[0], &block[0]+lines_len, num_to_skip);
+		const char* end=&block[0]+lines_len;
+
+		/* the number of fields is given by the first line */
+		while (num_fields==0 && begin<end)
+		{
+			const char* line_end=(const char*) memchr(begin, '\n', end-begin);
+			line_end=line_end ? line_end+1 : end;
+			parse_csv_lines(begin, line_end, m_delimiter, num_fields, first_line);
+			begin=line_end;
+		}
+		append_csv_values(matrix, num_values, capacity, first_line);
+		first_line.clear();
+
+		/* chunks of lines are parsed in parallel */
+		chunk_bounds[0]=begin;
+		for (int32_t c=1; c<num_chunks; c++)
+		{
+			const char* split=begin+(end-begin)*c/num_chunks;
+			if (split<chunk_bounds[c-1])
+				split=chunk_bounds[c-1];
+			const char* line_end=(const char*) memchr(split, '\n', end-split);
+			chunk_bounds[c]=line_end ? line_end+1 : end;
+		}
+		chunk_bounds[num_chunks]=end;
+
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int32_t c=0; c<num_chunks; c++)
+		{
+			int32_t chunk_fields=num_fields;
+			int64_t num_lines=simd::count_char(
+				chunk_bounds[c], chunk_bounds[c+1]-chunk_bounds[c], '\n')+1;
+
+			chunk_values[c].clear();
+			chunk_values[c].reserve(num_lines*chunk_fields);
+			chunk_errors[c]=parse_csv_lines(chunk_bounds[c], chunk_bounds[c+1],
+				m_delimiter, chunk_fields, chunk_values[c]);
+		}
+
+		for (int32_t c=0; c<num_chunks; c++)
+		{
+			if (chunk_errors[c]!=-1)
+			{
+				SG_FREE(matrix);
+				matrix=NULL;
+				SG_RESET_LOCALE;
+				SG_ERROR("Line with %d fields instead of %d in file %s\n",
+					chunk_errors[c], num_fields, get_filename())
+			}
+			append_csv_values(matrix, num_values, capacity, chunk_values[c]);
+		}
+
+		block_len-=lines_len;
+		memmove(&block[0], &block[lines_len], block_len);
+	}
+
+	SG_RESET_LOCALE;
+
+	int64_t num_lines=num_fields>0 ? num_values/num_fields : 0;
+	if (num_values>0 && num_values<capacity)
+		matrix=SG_REALLOC(T, matrix, capacity, num_values);
+	if (!is_data_transposed)
+	{
+		num_feat=num_fields;
+		num_vec=num_lines;
+	}
+	else
+	{
+		transpose_in_place(matrix, num_lines, num_fields);
+		num_feat=num_lines;
+		num_vec=num_fields;
+	}
+}
+
+void CCSVFile::get_matrix(float32_t*& matrix, int32_t& num_feat, int32_t& num_vec)
+{
+	read_real_matrix(matrix, num_feat, num_vec);
+}
+
+void CCSVFile::get_matrix(float64_t*& matrix, int32_t& num_feat, int32_t& num_vec)
+{
+	read_real_matrix(matrix, num_feat, num_vec);
+}
+
 #define GET_NDARRAY(read_func, sg_type) \
 void CCSVFile::get_ndarray(sg_type*& array, int32_t*& dims, int32_t& num_dims) \
 { \
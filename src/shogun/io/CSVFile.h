@@ -385,6 +385,16 @@ private:
 	/** skip m_num_skipped lines */
 	void skip_lines(int32_t num_lines);
 
+	/** read a matrix of reals by parsing blocks of the file in parallel,
+	 * bypassing the line reader and parser
+	 *
+	 * @param matrix matrix to read into
+	 * @param num_feat number of features
+	 * @param num_vec number of vectors
+	 */
+	template <class T>
+	void read_real_matrix(T*& matrix, int32_t& num_feat, int32_t& num_vec);
+
 private:
 	/** object for reading lines from file */
 	CLineReader* m_line_reader;
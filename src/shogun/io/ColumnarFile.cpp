@@ -0,0 +1,761 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/ColumnarFile.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/some.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/io/fs/FileSystem.h>
+#include <shogun/labels/DenseLabels.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+
+using namespace shogun;
+
+static const char columnar_magic[4]={'S', 'G', 'C', 'F'};
+static const uint32_t columnar_version=1;
+
+/* magic and version */
+static const uint64_t columnar_header_size=8;
+
+/* index offset and magic */
+static const uint64_t columnar_trailer_size=12;
+
+/* number of vectors per chunk unless set otherwise */
+static const int32_t columnar_default_chunk_size=65536;
+
+template <class T>
+static EPrimitiveType columnar_ptype();
+
+template <>
+EPrimitiveType columnar_ptype<float32_t>()
+{
+	return PT_FLOAT32;
+}
+
+template <>
+EPrimitiveType columnar_ptype<float64_t>()
+{
+	return PT_FLOAT64;
+}
+
+static size_t columnar_value_size(EPrimitiveType ptype)
+{
+	return ptype==PT_FLOAT32 ? sizeof(float32_t) : sizeof(float64_t);
+}
+
+template <class T>
+static void append_value(std::string& buffer, T value)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static T extract_value(const char*& p)
+{
+	T value;
+	sg_memcpy(&value, p, sizeof(T));
+	p+=sizeof(T);
+	return value;
+}
+
+/* appends strided values to a column and updates their range, values of
+ * sparse columns follow the indices and may not be aligned */
+template <class T>
+static void append_values(const T* values, int64_t n, int64_t stride,
+	std::vector<uint8_t>& data, float64_t& min, float64_t& max)
+{
+	size_t begin=data.size();
+	data.resize(begin+n*sizeof(T));
+	uint8_t* dst=data.data()+begin;
+	for (int64_t i=0; i<n; i++)
+	{
+		T value=values[i*stride];
+		sg_memcpy(dst+i*sizeof(T), &value, sizeof(T));
+		min=std::min<float64_t>(min, value);
+		max=std::max<float64_t>(max, value);
+	}
+}
+
+template <class S, class T>
+static void convert_values(const uint8_t* src, int64_t n, T* dst, int64_t stride)
+{
+	for (int64_t i=0; i<n; i++)
+	{
+		S value;
+		sg_memcpy(&value, src+i*sizeof(S), sizeof(S));
+		dst[i*stride]=value;
+	}
+}
+
+/* converts stored values of the given type to strided values of type T */
+template <class T>
+static void convert_values(const uint8_t* src, EPrimitiveType ptype,
+	int64_t n, T* dst, int64_t stride)
+{
+	if (ptype==PT_FLOAT32)
+		convert_values<float32_t>(src, n, dst, stride);
+	else
+		convert_values<float64_t>(src, n, dst, stride);
+}
+
+/* runs a loop over columns in parallel with a compressor for each thread,
+ * rethrowing the first error after the loop */
+template <class F>
+static void for_each_column(int64_t n, E_COMPRESSION_TYPE ct, F body)
+{
+	std::exception_ptr error;
+	/* lzo is the only backend of CCompressor which is not thread safe */
+#pragma omp parallel if (ct!=LZO)
+	{
+		auto compressor=some<CCompressor>(ct);
+#pragma omp for schedule(dynamic, 1)
+		for (int64_t i=0; i<n; i++)
+		{
+			try
+			{
+				body(compressor, i);
+			}
+			catch (...)
+			{
+#pragma omp critical
+				error=std::current_exception();
+			}
+		}
+	}
+	if (error)
+		std::rethrow_exception(error);
+}
+
+CColumnarFile::CColumnarFile() : CSGObject()
+{
+	init();
+}
+
+CColumnarFile::CColumnarFile(const char* fname, char rw) : CSGObject()
+{
+	init();
+	REQUIRE(fname, "Filename not given\n");
+	m_filename=fname;
+
+	switch (rw)
+	{
+		case 'r':
+		{
+			auto ec=env()->new_random_access_file(m_filename, &m_input);
+			REQUIRE(!ec, "Error opening file '%s': %s\n",
+				fname, ec.message().c_str());
+			read_index();
+			break;
+		}
+		case 'w':
+		{
+			auto ec=env()->new_writable_file(m_filename, &m_output);
+			REQUIRE(!ec, "Error opening file '%s': %s\n",
+				fname, ec.message().c_str());
+			break;
+		}
+		default:
+			SG_ERROR("Unknown mode '%c'\n", rw)
+	}
+}
+
+CColumnarFile::~CColumnarFile()
+{
+	if (m_output)
+		m_output->close();
+}
+
+void CColumnarFile::init()
+{
+	m_output_size=0;
+	m_compression=UNCOMPRESSED;
+	m_compression_level=1;
+	m_chunk_size=columnar_default_chunk_size;
+	m_sparse=false;
+	m_ptype=PT_FLOAT64;
+	m_has_labels=false;
+	m_num_features=0;
+	m_num_vectors=0;
+	m_num_chunks=0;
+}
+
+void CColumnarFile::set_compression(E_COMPRESSION_TYPE ct, int32_t level)
+{
+	REQUIRE(level>=1 && level<=9,
+		"Compression level (%d) should be between 1 and 9\n", level);
+	m_compression=ct;
+	m_compression_level=level;
+}
+
+void CColumnarFile::set_chunk_size(int32_t num_vectors)
+{
+	REQUIRE(num_vectors>0,
+		"Number of vectors per chunk (%d) should be positive\n", num_vectors);
+	m_chunk_size=num_vectors;
+}
+
+int32_t CColumnarFile::get_chunk_num_vectors(int32_t chunk) const
+{
+	REQUIRE(chunk>=0 && chunk<m_num_chunks,
+		"Chunk index (%d) out of bounds [0, %d)\n", chunk, m_num_chunks);
+	return std::min(m_chunk_size, m_num_vectors-chunk*m_chunk_size);
+}
+
+const CColumnarFile::ColumnChunk& CColumnarFile::get_column(
+	int32_t column, int32_t chunk) const
+{
+	int32_t num_columns=m_num_features+(m_has_labels ? 1 : 0);
+	return m_columns[int64_t(chunk)*num_columns+column];
+}
+
+void CColumnarFile::get_statistics(int32_t feature, int32_t chunk,
+	float64_t& min, float64_t& max) const
+{
+	REQUIRE(feature>=0 && feature<m_num_features,
+		"Feature index (%d) out of bounds [0, %d)\n", feature, m_num_features);
+	REQUIRE(chunk>=0 && chunk<m_num_chunks,
+		"Chunk index (%d) out of bounds [0, %d)\n", chunk, m_num_chunks);
+
+	const ColumnChunk& column=get_column(feature, chunk);
+	min=column.min;
+	max=column.max;
+}
+
+SGVector<index_t> CColumnarFile::get_chunks_in_range(
+	int32_t feature, float64_t min, float64_t max) const
+{
+	REQUIRE(feature>=0 && feature<m_num_features,
+		"Feature index (%d) out of bounds [0, %d)\n", feature, m_num_features);
+
+	std::vector<index_t> chunks;
+	for (int32_t c=0; c<m_num_chunks; c++)
+	{
+		const ColumnChunk& column=get_column(feature, c);
+		bool has_values=column.min<=max && column.max>=min;
+		/* sparse columns contain zeros for the vectors they do not store */
+		bool has_zeros=m_sparse && column.num_entries<get_chunk_num_vectors(c)
+			&& min<=0 && max>=0;
+		if (has_values || has_zeros)
+			chunks.push_back(c);
+	}
+
+	SGVector<index_t> result(chunks.size());
+	std::copy(chunks.begin(), chunks.end(), result.vector);
+	return result;
+}
+
+SGVector<index_t> CColumnarFile::check_features(SGVector<index_t> features) const
+{
+	if (!features.vlen)
+	{
+		SGVector<index_t> all(m_num_features);
+		all.range_fill();
+		return all;
+	}
+
+	for (index_t i=0; i<features.vlen; i++)
+	{
+		REQUIRE(features[i]>=0 && features[i]<m_num_features,
+			"Feature index (%d) out of bounds [0, %d)\n",
+			features[i], m_num_features);
+	}
+	return features;
+}
+
+void CColumnarFile::begin_write(bool sparse, EPrimitiveType ptype,
+	int32_t num_features, int32_t num_vectors, bool has_labels)
+{
+	REQUIRE(m_output, "File '%s' is not opened for writing\n",
+		m_filename.c_str());
+	REQUIRE(m_output_size==0, "File '%s' was already written\n",
+		m_filename.c_str());
+
+	m_sparse=sparse;
+	m_ptype=ptype;
+	m_num_features=num_features;
+	m_num_vectors=num_vectors;
+	m_has_labels=has_labels;
+	m_num_chunks=(num_vectors+m_chunk_size-1)/m_chunk_size;
+	m_columns.clear();
+
+	std::string header(columnar_magic, sizeof(columnar_magic));
+	append_value(header, columnar_version);
+	auto ec=m_output->append(header);
+	REQUIRE(!ec, "Error writing file '%s': %s\n",
+		m_filename.c_str(), ec.message().c_str());
+	m_output_size+=header.size();
+}
+
+void CColumnarFile::compress_column(CCompressor* compressor,
+	std::vector<uint8_t>& data, ColumnChunk& column) const
+{
+	uint8_t* compressed=NULL;
+	uint64_t compressed_size=0;
+	compressor->compress(data.data(), data.size(),
+		compressed, compressed_size, m_compression_level);
+
+	column.uncompressed_size=data.size();
+	column.compressed_size=compressed_size;
+	data.assign(compressed, compressed+compressed_size);
+	SG_FREE(compressed);
+}
+
+void CColumnarFile::append_columns(
+	const std::vector<std::vector<uint8_t>>& data,
+	std::vector<ColumnChunk>& columns)
+{
+	for (size_t i=0; i<data.size(); i++)
+	{
+		columns[i].offset=m_output_size;
+		auto ec=m_output->append(std::string_view(
+			reinterpret_cast<const char*>(data[i].data()), data[i].size()));
+		REQUIRE(!ec, "Error writing file '%s': %s\n",
+			m_filename.c_str(), ec.message().c_str());
+		m_output_size+=data[i].size();
+		m_columns.push_back(columns[i]);
+	}
+}
+
+void CColumnarFile::write_index()
+{
+	std::string index;
+	append_value<uint8_t>(index, m_sparse);
+	append_value<uint8_t>(index, m_ptype);
+	append_value<uint8_t>(index, m_compression);
+	append_value<uint8_t>(index, m_has_labels);
+	append_value<int32_t>(index, m_num_features);
+	append_value<int32_t>(index, m_num_vectors);
+	append_value<int32_t>(index, m_chunk_size);
+	append_value<int32_t>(index, m_num_chunks);
+	for (const auto& column : m_columns)
+	{
+		append_value(index, column.offset);
+		append_value(index, column.compressed_size);
+		append_value(index, column.uncompressed_size);
+		append_value(index, column.num_entries);
+		append_value(index, column.min);
+		append_value(index, column.max);
+	}
+	append_value<uint64_t>(index, m_output_size);
+	index.append(columnar_magic, sizeof(columnar_magic));
+
+	auto ec=m_output->append(index);
+	if (!ec)
+		ec=m_output->close();
+	REQUIRE(!ec, "Error writing file '%s': %s\n",
+		m_filename.c_str(), ec.message().c_str());
+	m_output_size+=index.size();
+	m_output.reset();
+}
+
+template <class T>
+void CColumnarFile::write(CDenseFeatures<T>* features, CDenseLabels* labels)
+{
+	REQUIRE(features, "Features not given\n");
+	SGMatrix<T> matrix=features->get_feature_matrix();
+	SGVector<float64_t> lab;
+	if (labels)
+	{
+		lab=labels->get_labels();
+		REQUIRE(lab.vlen==matrix.num_cols,
+			"Number of labels (%d) does not match number of vectors (%d)\n",
+			lab.vlen, matrix.num_cols);
+	}
+
+	begin_write(false, columnar_ptype<T>(),
+		matrix.num_rows, matrix.num_cols, labels!=NULL);
+
+	int32_t num_columns=m_num_features+(m_has_labels ? 1 : 0);
+	std::vector<std::vector<uint8_t>> data(num_columns);
+	std::vector<ColumnChunk> columns(num_columns);
+	for (int32_t c=0; c<m_num_chunks; c++)
+	{
+		int32_t begin=c*m_chunk_size;
+		int32_t n=get_chunk_num_vectors(c);
+
+		for_each_column(num_columns, m_compression,
+			[&](CCompressor* compressor, int64_t i) {
+				float64_t min=std::numeric_limits<float64_t>::infinity();
+				float64_t max=-std::numeric_limits<float64_t>::infinity();
+				data[i].clear();
+				if (i<m_num_features)
+					append_values(matrix.get_column_vector(begin)+i, n,
+						matrix.num_rows, data[i], min, max);
+				else
+					append_values(lab.vector+begin, n, 1, data[i], min, max);
+
+				columns[i].num_entries=n;
+				columns[i].min=min;
+				columns[i].max=max;
+				compress_column(compressor, data[i], columns[i]);
+			});
+		append_columns(data, columns);
+	}
+	write_index();
+}
+
+template <class T>
+void CColumnarFile::write(CSparseFeatures<T>* features, CDenseLabels* labels)
+{
+	REQUIRE(features, "Features not given\n");
+	int32_t num_vectors=features->get_num_vectors();
+	SGVector<float64_t> lab;
+	if (labels)
+	{
+		lab=labels->get_labels();
+		REQUIRE(lab.vlen==num_vectors,
+			"Number of labels (%d) does not match number of vectors (%d)\n",
+			lab.vlen, num_vectors);
+	}
+
+	begin_write(true, columnar_ptype<T>(),
+		features->get_num_features(), num_vectors, labels!=NULL);
+
+	int32_t num_columns=m_num_features+(m_has_labels ? 1 : 0);
+	std::vector<std::vector<uint8_t>> data(num_columns);
+	std::vector<ColumnChunk> columns(num_columns);
+	std::vector<std::vector<index_t>> rows(m_num_features);
+	std::vector<std::vector<T>> entries(m_num_features);
+	for (int32_t c=0; c<m_num_chunks; c++)
+	{
+		int32_t begin=c*m_chunk_size;
+		int32_t n=get_chunk_num_vectors(c);
+
+		/* transpose the vectors of the chunk into columns */
+		for (int32_t i=0; i<m_num_features; i++)
+		{
+			rows[i].clear();
+			entries[i].clear();
+		}
+		for (int32_t j=0; j<n; j++)
+		{
+			SGSparseVector<T> vec=features->get_sparse_feature_vector(begin+j);
+			for (int32_t k=0; k<vec.num_feat_entries; k++)
+			{
+				index_t feature=vec.features[k].feat_index;
+				REQUIRE(feature>=0 && feature<m_num_features,
+					"Feature index (%d) out of bounds [0, %d)\n",
+					feature, m_num_features);
+				rows[feature].push_back(j);
+				entries[feature].push_back(vec.features[k].entry);
+			}
+			features->free_sparse_feature_vector(begin+j);
+		}
+
+		for_each_column(num_columns, m_compression,
+			[&](CCompressor* compressor, int64_t i) {
+				float64_t min=std::numeric_limits<float64_t>::infinity();
+				float64_t max=-std::numeric_limits<float64_t>::infinity();
+				data[i].clear();
+				if (i<m_num_features)
+				{
+					int64_t nnz=rows[i].size();
+					const uint8_t* indices=
+						reinterpret_cast<const uint8_t*>(rows[i].data());
+					data[i].assign(indices, indices+nnz*sizeof(index_t));
+					append_values(entries[i].data(), nnz, 1, data[i], min, max);
+					columns[i].num_entries=nnz;
+				}
+				else
+				{
+					append_values(lab.vector+begin, n, 1, data[i], min, max);
+					columns[i].num_entries=n;
+				}
+
+				columns[i].min=min;
+				columns[i].max=max;
+				compress_column(compressor, data[i], columns[i]);
+			});
+		append_columns(data, columns);
+	}
+	write_index();
+}
+
+void CColumnarFile::read_bytes(uint64_t offset, size_t n, char* data) const
+{
+	std::string_view result;
+	auto ec=m_input->read(offset, n, &result, data);
+	REQUIRE(!ec && result.size()==n, "Error reading file '%s': %s\n",
+		m_filename.c_str(), ec ? ec.message().c_str() : "truncated file");
+	if (result.data()!=data)
+		sg_memcpy(data, result.data(), n);
+}
+
+void CColumnarFile::read_index()
+{
+	int64_t file_size=env()->get_file_size(m_filename);
+	REQUIRE(file_size>=int64_t(columnar_header_size+columnar_trailer_size),
+		"File '%s' is not a columnar file\n", m_filename.c_str());
+
+	char header[columnar_header_size];
+	read_bytes(0, columnar_header_size, header);
+	const char* p=header+sizeof(columnar_magic);
+	REQUIRE(!memcmp(header, columnar_magic, sizeof(columnar_magic)),
+		"File '%s' is not a columnar file\n", m_filename.c_str());
+	uint32_t version=extract_value<uint32_t>(p);
+	REQUIRE(version==columnar_version,
+		"Unsupported version (%d) of columnar file '%s'\n",
+		version, m_filename.c_str());
+
+	char trailer[columnar_trailer_size];
+	read_bytes(file_size-columnar_trailer_size, columnar_trailer_size, trailer);
+	p=trailer;
+	uint64_t index_offset=extract_value<uint64_t>(p);
+	REQUIRE(!memcmp(p, columnar_magic, sizeof(columnar_magic)) &&
+		index_offset>=columnar_header_size &&
+		index_offset<=file_size-columnar_trailer_size,
+		"File '%s' is truncated\n", m_filename.c_str());
+
+	std::vector<char> index(file_size-columnar_trailer_size-index_offset);
+	read_bytes(index_offset, index.size(), index.data());
+	p=index.data();
+	const char* end=index.data()+index.size();
+
+	const size_t fields_size=4*sizeof(uint8_t)+4*sizeof(int32_t);
+	const size_t column_size=4*sizeof(uint64_t)+2*sizeof(float64_t);
+	REQUIRE(index.size()>=fields_size, "File '%s' is corrupt\n",
+		m_filename.c_str());
+	m_sparse=extract_value<uint8_t>(p);
+	m_ptype=(EPrimitiveType) extract_value<uint8_t>(p);
+	m_compression=(E_COMPRESSION_TYPE) extract_value<uint8_t>(p);
+	m_has_labels=extract_value<uint8_t>(p);
+	m_num_features=extract_value<int32_t>(p);
+	m_num_vectors=extract_value<int32_t>(p);
+	m_chunk_size=extract_value<int32_t>(p);
+	m_num_chunks=extract_value<int32_t>(p);
+
+	int64_t num_columns=
+		int64_t(m_num_features+(m_has_labels ? 1 : 0))*m_num_chunks;
+	REQUIRE(m_ptype==PT_FLOAT32 || m_ptype==PT_FLOAT64,
+		"Unsupported type of values in file '%s'\n", m_filename.c_str());
+	REQUIRE(m_num_features>=0 && m_num_vectors>=0 && m_chunk_size>0 &&
+		m_num_chunks==(m_num_vectors+m_chunk_size-1)/m_chunk_size &&
+		int64_t(end-p)==num_columns*int64_t(column_size),
+		"File '%s' is corrupt\n", m_filename.c_str());
+
+	m_columns.resize(num_columns);
+	for (auto& column : m_columns)
+	{
+		column.offset=extract_value<uint64_t>(p);
+		column.compressed_size=extract_value<uint64_t>(p);
+		column.uncompressed_size=extract_value<uint64_t>(p);
+		column.num_entries=extract_value<int64_t>(p);
+		column.min=extract_value<float64_t>(p);
+		column.max=extract_value<float64_t>(p);
+		REQUIRE(column.offset+column.compressed_size<=index_offset,
+			"File '%s' is corrupt\n", m_filename.c_str());
+	}
+}
+
+void CColumnarFile::advise_columns(int32_t first_chunk, int32_t num_chunks,
+	SGVector<index_t> features) const
+{
+	for (int32_t c=first_chunk; c<first_chunk+num_chunks; c++)
+	{
+		for (index_t i=0; i<features.vlen; i++)
+		{
+			const ColumnChunk& column=get_column(features[i], c);
+			if (column.compressed_size)
+				m_input->advise(column.offset, column.compressed_size,
+					io::AccessAdvice::WillNeed);
+		}
+	}
+}
+
+void CColumnarFile::read_column(CCompressor* compressor,
+	const ColumnChunk& column, std::vector<uint8_t>& data) const
+{
+	std::vector<uint8_t> compressed(column.compressed_size);
+	read_bytes(column.offset, column.compressed_size,
+		reinterpret_cast<char*>(compressed.data()));
+
+	data.resize(column.uncompressed_size);
+	uint64_t size=column.uncompressed_size;
+	compressor->decompress(compressed.data(), compressed.size(),
+		data.data(), size);
+	REQUIRE(size==column.uncompressed_size,
+		"File '%s' is corrupt\n", m_filename.c_str());
+}
+
+template <class T>
+void CColumnarFile::read_dense_chunks(int32_t first_chunk, int32_t num_chunks,
+	SGVector<index_t> features, SGMatrix<T> result) const
+{
+	REQUIRE(!m_sparse, "File '%s' holds sparse features\n", m_filename.c_str());
+
+	advise_columns(first_chunk, num_chunks, features);
+	for_each_column(int64_t(num_chunks)*features.vlen, m_compression,
+		[&](CCompressor* compressor, int64_t t) {
+			int32_t c=first_chunk+t/features.vlen;
+			index_t i=t%features.vlen;
+			int32_t n=get_chunk_num_vectors(c);
+			std::vector<uint8_t> data;
+			read_column(compressor, get_column(features[i], c), data);
+			REQUIRE(data.size()==n*columnar_value_size(m_ptype),
+				"File '%s' is corrupt\n", m_filename.c_str());
+
+			int64_t begin=int64_t(c-first_chunk)*m_chunk_size;
+			convert_values(data.data(), m_ptype, n,
+				result.get_column_vector(begin)+i, result.num_rows);
+		});
+}
+
+template <class T>
+void CColumnarFile::read_sparse_vectors(int32_t chunk,
+	SGVector<index_t> features, SGSparseVector<T>* vectors) const
+{
+	REQUIRE(m_sparse, "File '%s' holds dense features\n", m_filename.c_str());
+
+	int32_t n=get_chunk_num_vectors(chunk);
+	std::vector<std::vector<uint8_t>> data(features.vlen);
+	for_each_column(features.vlen, m_compression,
+		[&](CCompressor* compressor, int64_t i) {
+			const ColumnChunk& column=get_column(features[i], chunk);
+			if (!column.num_entries)
+				return;
+			read_column(compressor, column, data[i]);
+			REQUIRE(data[i].size()==column.num_entries*
+				(sizeof(index_t)+columnar_value_size(m_ptype)),
+				"File '%s' is corrupt\n", m_filename.c_str());
+		});
+
+	/* count the entries of each vector, then fill them feature by feature,
+	 * which keeps the entries of the vectors sorted by feature index */
+	std::vector<index_t> num_entries(n, 0);
+	for (index_t i=0; i<features.vlen; i++)
+	{
+		int64_t nnz=get_column(features[i], chunk).num_entries;
+		const index_t* rows=reinterpret_cast<const index_t*>(data[i].data());
+		for (int64_t k=0; k<nnz; k++)
+		{
+			REQUIRE(rows[k]>=0 && rows[k]<n,
+				"File '%s' is corrupt\n", m_filename.c_str());
+			num_entries[rows[k]]++;
+		}
+	}
+
+	for (int32_t j=0; j<n; j++)
+	{
+		vectors[j]=SGSparseVector<T>(num_entries[j]);
+		num_entries[j]=0;
+	}
+
+	for (index_t i=0; i<features.vlen; i++)
+	{
+		int64_t nnz=get_column(features[i], chunk).num_entries;
+		const index_t* rows=reinterpret_cast<const index_t*>(data[i].data());
+		const uint8_t* values=data[i].data()+nnz*sizeof(index_t);
+		for (int64_t k=0; k<nnz; k++)
+		{
+			SGSparseVectorEntry<T>& entry=
+				vectors[rows[k]].features[num_entries[rows[k]]++];
+			entry.feat_index=i;
+			convert_values(values+k*columnar_value_size(m_ptype),
+				m_ptype, 1, &entry.entry, 1);
+		}
+	}
+}
+
+template <class T>
+CDenseFeatures<T>* CColumnarFile::read_dense(SGVector<index_t> features)
+{
+	features=check_features(features);
+	SGMatrix<T> matrix(features.vlen, m_num_vectors);
+	read_dense_chunks(0, m_num_chunks, features, matrix);
+	return new CDenseFeatures<T>(matrix);
+}
+
+template <class T>
+CSparseFeatures<T>* CColumnarFile::read_sparse(SGVector<index_t> features)
+{
+	features=check_features(features);
+	SGSparseMatrix<T> matrix(features.vlen, m_num_vectors);
+	advise_columns(0, m_num_chunks, features);
+	for (int32_t c=0; c<m_num_chunks; c++)
+		read_sparse_vectors(c, features, matrix.sparse_matrix+c*m_chunk_size);
+	return new CSparseFeatures<T>(matrix);
+}
+
+template <class T>
+SGMatrix<T> CColumnarFile::read_dense_chunk(
+	int32_t chunk, SGVector<index_t> features)
+{
+	int32_t n=get_chunk_num_vectors(chunk);
+	features=check_features(features);
+	SGMatrix<T> matrix(features.vlen, n);
+	read_dense_chunks(chunk, 1, features, matrix);
+	/* chunks are usually read in order */
+	if (chunk+1<m_num_chunks)
+		advise_columns(chunk+1, 1, features);
+	return matrix;
+}
+
+template <class T>
+SGSparseMatrix<T> CColumnarFile::read_sparse_chunk(
+	int32_t chunk, SGVector<index_t> features)
+{
+	int32_t n=get_chunk_num_vectors(chunk);
+	features=check_features(features);
+	SGSparseMatrix<T> matrix(features.vlen, n);
+	advise_columns(chunk, 1, features);
+	read_sparse_vectors(chunk, features, matrix.sparse_matrix);
+	/* chunks are usually read in order */
+	if (chunk+1<m_num_chunks)
+		advise_columns(chunk+1, 1, features);
+	return matrix;
+}
+
+SGVector<float64_t> CColumnarFile::read_labels_chunk(int32_t chunk)
+{
+	REQUIRE(m_has_labels, "File '%s' holds no labels\n", m_filename.c_str());
+	int32_t n=get_chunk_num_vectors(chunk);
+
+	auto compressor=some<CCompressor>(m_compression);
+	std::vector<uint8_t> data;
+	read_column(compressor, get_column(m_num_features, chunk), data);
+	REQUIRE(data.size()==n*sizeof(float64_t),
+		"File '%s' is corrupt\n", m_filename.c_str());
+
+	SGVector<float64_t> labels(n);
+	sg_memcpy(labels.vector, data.data(), data.size());
+	return labels;
+}
+
+SGVector<float64_t> CColumnarFile::read_labels()
+{
+	REQUIRE(m_has_labels, "File '%s' holds no labels\n", m_filename.c_str());
+
+	SGVector<float64_t> labels(m_num_vectors);
+	for (int32_t c=0; c<m_num_chunks; c++)
+	{
+		SGVector<float64_t> chunk=read_labels_chunk(c);
+		sg_memcpy(labels.vector+c*m_chunk_size, chunk.vector,
+			chunk.vlen*sizeof(float64_t));
+	}
+	return labels;
+}
+
+namespace shogun
+{
+#define COLUMNAR_FILE_METHODS(T)                                             \
+	template void CColumnarFile::write<T>(CDenseFeatures<T>*, CDenseLabels*); \
+	template void CColumnarFile::write<T>(CSparseFeatures<T>*, CDenseLabels*);\
+	template CDenseFeatures<T>* CColumnarFile::read_dense<T>(SGVector<index_t>); \
+	template CSparseFeatures<T>* CColumnarFile::read_sparse<T>(SGVector<index_t>); \
+	template SGMatrix<T> CColumnarFile::read_dense_chunk<T>(                  \
+		int32_t, SGVector<index_t>);                                          \
+	template SGSparseMatrix<T> CColumnarFile::read_sparse_chunk<T>(           \
+		int32_t, SGVector<index_t>);
+
+COLUMNAR_FILE_METHODS(float32_t)
+COLUMNAR_FILE_METHODS(float64_t)
+#undef COLUMNAR_FILE_METHODS
+}
@@ -0,0 +1,301 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __COLUMNAR_FILE_H__
+#define __COLUMNAR_FILE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/Compressor.h>
+#include <shogun/lib/DataType.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+namespace io
+{
+	class RandomAccessFile;
+	class WritableFile;
+}
+
+template <class ST> class CDenseFeatures;
+template <class ST> class CSparseFeatures;
+class CDenseLabels;
+
+/** @brief Chunked columnar binary file for dense or sparse real valued
+ * features and optional labels.
+ *
+ * The vectors are split into chunks of a fixed number of vectors. Within
+ * a chunk every feature is stored as a separate column, which is
+ * compressed on its own with one of the CCompressor backends and
+ * annotated with the minimum and maximum of its values. Labels, if any,
+ * are stored as an additional column. Dense columns hold the values of
+ * all vectors of the chunk, sparse columns the indices of the vectors
+ * with a non-zero entry within the chunk followed by these entries.
+ *
+ * As columns are independent, a subset of the features can be read
+ * without touching the others, and chunks are decompressed in parallel.
+ * The file is laid out as
+ *
+ *   magic, version, column data, index, index offset, magic
+ *
+ * where the index, which describes the data and the position and
+ * statistics of every column of every chunk, is written after the data
+ * so that writing is sequential. Numbers are stored in the byte order of
+ * the machine.
+ *
+ * Files are written at once from CDenseFeatures or CSparseFeatures of
+ * 32 or 64 bit floats and read back as either, see also
+ * CStreamingColumnarFile to read them vector by vector.
+ */
+class CColumnarFile : public CSGObject
+{
+public:
+	/** default constructor */
+	CColumnarFile();
+
+	/** constructor
+	 *
+	 * @param fname filename to open
+	 * @param rw mode, 'r' or 'w'
+	 */
+	CColumnarFile(const char* fname, char rw='r');
+
+	/** destructor */
+	virtual ~CColumnarFile();
+
+	/** set compression of the columns written
+	 *
+	 * @param ct compression type
+	 * @param level compression level between 1 and 9
+	 */
+	void set_compression(E_COMPRESSION_TYPE ct, int32_t level=1);
+
+	/** set number of vectors per chunk written
+	 *
+	 * @param num_vectors number of vectors
+	 */
+	void set_chunk_size(int32_t num_vectors);
+
+	/** write dense features and optional labels
+	 *
+	 * @param features features to write
+	 * @param labels labels to write, or NULL
+	 */
+	template <class T>
+	void write(CDenseFeatures<T>* features, CDenseLabels* labels=NULL);
+
+	/** write sparse features and optional labels
+	 *
+	 * @param features features to write
+	 * @param labels labels to write, or NULL
+	 */
+	template <class T>
+	void write(CSparseFeatures<T>* features, CDenseLabels* labels=NULL);
+
+	/** @return whether the file holds sparse features */
+	bool is_sparse() const { return m_sparse; }
+
+	/** @return type of the stored values */
+	EPrimitiveType get_primitive_type() const { return m_ptype; }
+
+	/** @return whether the file holds labels */
+	bool has_labels() const { return m_has_labels; }
+
+	/** @return number of features */
+	int32_t get_num_features() const { return m_num_features; }
+
+	/** @return number of vectors */
+	int32_t get_num_vectors() const { return m_num_vectors; }
+
+	/** @return number of chunks */
+	int32_t get_num_chunks() const { return m_num_chunks; }
+
+	/** @return number of vectors in a chunk
+	 *
+	 * @param chunk index of the chunk
+	 */
+	int32_t get_chunk_num_vectors(int32_t chunk) const;
+
+	/** get the range of the values of a feature within a chunk, which is
+	 * empty (min > max) if the chunk does not store any value of it
+	 *
+	 * @param feature index of the feature
+	 * @param chunk index of the chunk
+	 * @param min minimum value (returned)
+	 * @param max maximum value (returned)
+	 */
+	void get_statistics(int32_t feature, int32_t chunk,
+		float64_t& min, float64_t& max) const;
+
+	/** get the chunks which may contain values of a feature in a range
+	 *
+	 * @param feature index of the feature
+	 * @param min lower bound of the range
+	 * @param max upper bound of the range
+	 * @return indices of the chunks
+	 */
+	SGVector<index_t> get_chunks_in_range(
+		int32_t feature, float64_t min, float64_t max) const;
+
+	/** read dense features
+	 *
+	 * @param features indices of the features to read, all if empty
+	 * @return features with the given features in the given order
+	 */
+	template <class T>
+	CDenseFeatures<T>* read_dense(SGVector<index_t> features=SGVector<index_t>());
+
+	/** read sparse features
+	 *
+	 * @param features indices of the features to read, all if empty
+	 * @return features with the given features in the given order
+	 */
+	template <class T>
+	CSparseFeatures<T>* read_sparse(SGVector<index_t> features=SGVector<index_t>());
+
+	/** @return labels of all vectors */
+	SGVector<float64_t> read_labels();
+
+	/** read a chunk of dense features
+	 *
+	 * @param chunk index of the chunk
+	 * @param features indices of the features to read, all if empty
+	 * @return matrix with a column for each vector of the chunk
+	 */
+	template <class T>
+	SGMatrix<T> read_dense_chunk(
+		int32_t chunk, SGVector<index_t> features=SGVector<index_t>());
+
+	/** read a chunk of sparse features
+	 *
+	 * @param chunk index of the chunk
+	 * @param features indices of the features to read, all if empty
+	 * @return sparse matrix with a vector for each vector of the chunk
+	 */
+	template <class T>
+	SGSparseMatrix<T> read_sparse_chunk(
+		int32_t chunk, SGVector<index_t> features=SGVector<index_t>());
+
+	/** read the labels of a chunk
+	 *
+	 * @param chunk index of the chunk
+	 * @return labels of the vectors of the chunk
+	 */
+	SGVector<float64_t> read_labels_chunk(int32_t chunk);
+
+	/** @return object name */
+	virtual const char* get_name() const { return "ColumnarFile"; }
+
+private:
+	/** position, size and statistics of a column within a chunk */
+	struct ColumnChunk
+	{
+		uint64_t offset;
+		uint64_t compressed_size;
+		uint64_t uncompressed_size;
+		int64_t num_entries;
+		float64_t min;
+		float64_t max;
+	};
+
+	void init();
+
+	/** read the index at the end of the file */
+	void read_index();
+
+	/** write the index and close the file */
+	void write_index();
+
+	/** write the header and check the file was not written yet */
+	void begin_write(bool sparse, EPrimitiveType ptype,
+		int32_t num_features, int32_t num_vectors, bool has_labels);
+
+	/** compress a column in place and describe it */
+	void compress_column(CCompressor* compressor, std::vector<uint8_t>& data,
+		ColumnChunk& column) const;
+
+	/** append the compressed columns of a chunk */
+	void append_columns(const std::vector<std::vector<uint8_t>>& data,
+		std::vector<ColumnChunk>& columns);
+
+	/** read a column and decompress it */
+	void read_column(CCompressor* compressor, const ColumnChunk& column,
+		std::vector<uint8_t>& data) const;
+
+	/** hint that columns of consecutive chunks are read soon */
+	void advise_columns(int32_t first_chunk, int32_t num_chunks,
+		SGVector<index_t> features) const;
+
+	/** read bytes at a given position of the file */
+	void read_bytes(uint64_t offset, size_t n, char* data) const;
+
+	/** read dense features of consecutive chunks into a matrix */
+	template <class T>
+	void read_dense_chunks(int32_t first_chunk, int32_t num_chunks,
+		SGVector<index_t> features, SGMatrix<T> result) const;
+
+	/** read sparse features of a chunk into vectors */
+	template <class T>
+	void read_sparse_vectors(int32_t chunk, SGVector<index_t> features,
+		SGSparseVector<T>* vectors) const;
+
+	/** check indices of features, defaulting to all features */
+	SGVector<index_t> check_features(SGVector<index_t> features) const;
+
+	/** column of a feature, or of the labels, within a chunk */
+	const ColumnChunk& get_column(int32_t column, int32_t chunk) const;
+
+private:
+	/** file name */
+	std::string m_filename;
+
+	/** file to read from */
+	std::unique_ptr<io::RandomAccessFile> m_input;
+
+	/** file to write to */
+	std::unique_ptr<io::WritableFile> m_output;
+
+	/** number of bytes written */
+	uint64_t m_output_size;
+
+	/** compression of the columns */
+	E_COMPRESSION_TYPE m_compression;
+
+	/** compression level */
+	int32_t m_compression_level;
+
+	/** number of vectors per chunk */
+	int32_t m_chunk_size;
+
+	/** whether the features are sparse */
+	bool m_sparse;
+
+	/** type of the values */
+	EPrimitiveType m_ptype;
+
+	/** whether the file holds labels */
+	bool m_has_labels;
+
+	/** number of features */
+	int32_t m_num_features;
+
+	/** number of vectors */
+	int32_t m_num_vectors;
+
+	/** number of chunks */
+	int32_t m_num_chunks;
+
+	/** columns of all chunks, labels last within each chunk */
+	std::vector<ColumnChunk> m_columns;
+};
+}
+#endif /* __COLUMNAR_FILE_H__ */
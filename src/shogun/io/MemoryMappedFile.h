@@ -52,7 +52,10 @@ template <class T> class CMemoryMappedFile : public CSGObject
 		 * open a memory mapped file for read or read/write mode
 		 *
 		 * @param fname name of file, zero terminated string
-		 * @param flag determines read or read write mode (can be 'r' or 'w')
+		 * @param flag determines read or read write mode (can be 'r' or 'w'),
+		 *   or 'c' for a private copy-on-write mapping of an existing file:
+		 *   pages are shared with the page cache until they are written to
+		 *   and writes never reach the file
 		 * @param fsize overestimate of expected file size (in bytes)
 		 *   when opened in write  mode; Underestimating the file size will
 		 *   result in an error to occur upon writing. In case the exact file
@@ -63,7 +66,8 @@ template <class T> class CMemoryMappedFile : public CSGObject
 		CMemoryMappedFile(const char* fname, char flag='r', int64_t fsize=0)
 		: CSGObject()
 		{
-			REQUIRE(flag=='w' || flag=='r', "Only 'r' and 'w' flags are allowed")
+			REQUIRE(flag=='w' || flag=='r' || flag=='c',
+				"Only 'r', 'w' and 'c' flags are allowed")
 
 			last_written_byte=0;
 			rw=flag;
@@ -82,6 +86,11 @@ template <class T> class CMemoryMappedFile : public CSGObject
 				mmap_prot = PAGE_READWRITE;
 				mmap_flags = FILE_MAP_ALL_ACCESS;
 			}
+			else if (rw=='c')
+			{
+				mmap_prot = PAGE_WRITECOPY;
+				mmap_flags = FILE_MAP_COPY;
+			}
 
 			fd = CreateFile(fname, open_flags, share_mode, 0, create_disp, FILE_ATTRIBUTE_NORMAL, NULL);
 			if (rw=='w' && fsize)
@@ -114,6 +123,8 @@ template <class T> class CMemoryMappedFile : public CSGObject
 				mmap_prot=PROT_READ|PROT_WRITE;
 				mmap_flags=MAP_SHARED;
 			}
+			else if (rw=='c')
+				mmap_prot=PROT_READ|PROT_WRITE;
 
 			fd = open(fname, open_flags, S_IRWXU | S_IRWXG | S_IRWXO);
 			if (fd == -1)
@@ -173,6 +184,8 @@ template <class T> class CMemoryMappedFile : public CSGObject
 		 * x[index]= foo; (for write mode)
 		 * foo = x[index]; (for read and write mode)
 		 *
+		 * In copy-on-write mode writes are allowed but stay private.
+		 *
 		 * @return length of file
 		 */
 		inline T* get_map()
@@ -0,0 +1,174 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/NumberParser.h>
+
+#include <cstdlib>
+
+namespace shogun
+{
+namespace number_parser
+{
+	/* powers of ten which are exactly representable */
+	static const float64_t powers_of_ten[] = {
+	    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+	    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+	    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	static const float32_t powers_of_ten_float[] = {
+	    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+	    1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+	/* decimal number given by its significant digits and a power of ten */
+	struct Decimal
+	{
+		uint64_t mantissa;
+		int32_t exponent;
+		bool negative;
+		/* whether no non-zero digits were dropped from the mantissa */
+		bool exact;
+	};
+
+	static inline bool is_digit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	/* reads a decimal number, returns its end or begin if it is none */
+	static const char*
+	read_decimal(const char* begin, const char* end, Decimal& decimal)
+	{
+		const char* p = begin;
+		decimal.mantissa = 0;
+		decimal.exponent = 0;
+		decimal.negative = false;
+		decimal.exact = true;
+
+		if (p < end && (*p == '-' || *p == '+'))
+		{
+			decimal.negative = *p == '-';
+			p++;
+		}
+
+		/* up to 19 significant digits fit into the mantissa */
+		int32_t num_digits = 0;
+		bool has_digits = false;
+		for (; p < end && is_digit(*p); p++)
+		{
+			has_digits = true;
+			if (num_digits < 19)
+			{
+				decimal.mantissa = decimal.mantissa * 10 + (*p - '0');
+				if (decimal.mantissa)
+					num_digits++;
+			}
+			else
+			{
+				decimal.exponent++;
+				if (*p != '0')
+					decimal.exact = false;
+			}
+		}
+
+		if (p < end && *p == '.')
+		{
+			p++;
+			for (; p < end && is_digit(*p); p++)
+			{
+				has_digits = true;
+				if (num_digits < 19)
+				{
+					decimal.mantissa = decimal.mantissa * 10 + (*p - '0');
+					decimal.exponent--;
+					if (decimal.mantissa)
+						num_digits++;
+				}
+				else if (*p != '0')
+					decimal.exact = false;
+			}
+		}
+
+		if (!has_digits)
+			return begin;
+
+		if (p < end && (*p == 'e' || *p == 'E'))
+		{
+			const char* q = p + 1;
+			bool negative_exponent = false;
+			if (q < end && (*q == '-' || *q == '+'))
+			{
+				negative_exponent = *q == '-';
+				q++;
+			}
+
+			if (q < end && is_digit(*q))
+			{
+				int32_t exponent = 0;
+				for (; q < end && is_digit(*q); q++)
+				{
+					if (exponent < 100000)
+						exponent = exponent * 10 + (*q - '0');
+				}
+				decimal.exponent += negative_exponent ? -exponent : exponent;
+				p = q;
+			}
+		}
+
+		/* hexadecimal numbers are left to strtod */
+		if (p < end && (*p == 'x' || *p == 'X'))
+			decimal.exact = false;
+
+		return p;
+	}
+
+	const char* parse_real(const char* begin, const char* end, float64_t& value)
+	{
+		Decimal decimal;
+		const char* number_end = read_decimal(begin, end, decimal);
+
+		if (number_end != begin && decimal.exact &&
+		    decimal.mantissa <= (uint64_t(1) << 53) &&
+		    decimal.exponent >= -22 && decimal.exponent <= 22)
+		{
+			/* both operands are exact, so the result is correctly rounded */
+			value = float64_t(decimal.mantissa);
+			if (decimal.exponent < 0)
+				value /= powers_of_ten[-decimal.exponent];
+			else
+				value *= powers_of_ten[decimal.exponent];
+			if (decimal.negative)
+				value = -value;
+			return number_end;
+		}
+
+		char* strtod_end = NULL;
+		value = strtod(begin, &strtod_end);
+		return strtod_end;
+	}
+
+	const char* parse_real(const char* begin, const char* end, float32_t& value)
+	{
+		Decimal decimal;
+		const char* number_end = read_decimal(begin, end, decimal);
+
+		if (number_end != begin && decimal.exact &&
+		    decimal.mantissa <= (uint64_t(1) << 24) &&
+		    decimal.exponent >= -10 && decimal.exponent <= 10)
+		{
+			value = float32_t(decimal.mantissa);
+			if (decimal.exponent < 0)
+				value /= powers_of_ten_float[-decimal.exponent];
+			else
+				value *= powers_of_ten_float[decimal.exponent];
+			if (decimal.negative)
+				value = -value;
+			return number_end;
+		}
+
+		char* strtof_end = NULL;
+		value = strtof(begin, &strtof_end);
+		return strtof_end;
+	}
+}
+}
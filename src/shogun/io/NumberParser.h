@@ -0,0 +1,43 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __NUMBER_PARSER_H__
+#define __NUMBER_PARSER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+/** Conversion of decimal numbers in text buffers to floating point values,
+ * without copying them into separate strings first. Numbers with at most
+ * 19 significant digits and small exponents, as usually written to text
+ * files, are converted exactly with a single floating point operation, see
+ *
+ * Clinger, W. D. (1990). How to read floating point numbers accurately.
+ * ACM SIGPLAN Notices, 25(6), 92-101.
+ *
+ * Other numbers, such as nan, inf or hexadecimal ones, are converted with
+ * strtod. As strtod does not know the end of the buffer, the number has to
+ * be followed by a character which can not continue it, e.g. a delimiter or
+ * a terminating zero.
+ */
+namespace number_parser
+{
+	/** parses a floating point number at the beginning of a buffer
+	 *
+	 * @param begin begin of the buffer
+	 * @param end end of the buffer
+	 * @param value parsed value
+	 * @return end of the number, or begin if there is no number
+	 */
+	const char* parse_real(const char* begin, const char* end, float64_t& value);
+
+	/** @copydoc parse_real */
+	const char* parse_real(const char* begin, const char* end, float32_t& value);
+}
+}
+
+#endif /* __NUMBER_PARSER_H__ */
@@ -7,6 +7,7 @@
  */
 
 #include <shogun/io/SGIO.h>
+#include <shogun/io/NumberParser.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/memory.h>
 #include <shogun/lib/Time.h>
@@ -237,9 +238,8 @@ void SGIO::print_substring(substring s)
 
 float32_t SGIO::float_of_substring(substring s)
 {
-	char* endptr = s.end;
-	float32_t f = strtof(s.start,&endptr);
-	if (endptr == s.start && s.start != s.end)
+	float32_t f = 0;
+	if (number_parser::parse_real(s.start, s.end, f) == s.start && s.start != s.end)
 		SG_SERROR("error: %s is not a float!\n", c_string_of_substring(s))
 
 	return f;
@@ -247,9 +247,8 @@ float32_t SGIO::float_of_substring(substring s)
 
 float64_t SGIO::double_of_substring(substring s)
 {
-	char* endptr = s.end;
-	float64_t f = strtod(s.start,&endptr);
-	if (endptr == s.start && s.start != s.end)
+	float64_t f = 0;
+	if (number_parser::parse_real(s.start, s.end, f) == s.start && s.start != s.end)
 		SG_SERROR("Error!:%s is not a double!\n", c_string_of_substring(s))
 
 	return f;
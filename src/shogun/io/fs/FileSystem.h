@@ -124,6 +124,15 @@ namespace shogun
 			virtual int64_t get_file_size(const std::string& fname) const = 0;
 		};
 
+		/** Expected access to a range of a file */
+		enum class AccessAdvice
+		{
+			/** the range is read sequentially */
+			Sequential,
+			/** the range is read soon */
+			WillNeed
+		};
+
 		/**
 		 * A file abstraction for randomly reading the contents of a file.
 		 */
@@ -137,6 +146,19 @@ namespace shogun
 				uint64_t offset, size_t n,
 				std::string_view* result,
 				char* scratch) const = 0;
+
+			/**
+			 * Hint the expected access to a range of the file, so that
+			 * the file system can read it ahead. Ignored by default.
+			 *
+			 * @param offset start of the range
+			 * @param n length of the range, 0 until the end of the file
+			 * @param advice expected access
+			 */
+			virtual void advise(
+				uint64_t offset, size_t n, AccessAdvice advice) const
+			{
+			}
 		private:
 			SG_DELETE_COPY_AND_ASSIGN(RandomAccessFile);
 		};
@@ -14,6 +14,7 @@
 #include <unistd.h>
 #include <system_error>
 
+#include <shogun/lib/config.h>
 #include <shogun/io/fs/PosixFileSystem.h>
 #include <shogun/io/ShogunErrc.h>
 
@@ -66,6 +67,16 @@ public:
 		return ec;
 	}
 
+	void advise(uint64_t offset, size_t n, AccessAdvice advice) const override
+	{
+#ifdef HAVE_POSIX_FADVISE
+		posix_fadvise(
+			m_fd, static_cast<off_t>(offset), static_cast<off_t>(n),
+			advice == AccessAdvice::Sequential ? POSIX_FADV_SEQUENTIAL
+			                                   : POSIX_FADV_WILLNEED);
+#endif
+	}
+
 private:
   string m_filename;
   int m_fd;
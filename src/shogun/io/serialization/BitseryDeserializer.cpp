@@ -5,6 +5,7 @@
 
 #include <shogun/io/serialization/BitseryDeserializer.h>
 #include <shogun/io/serialization/BitseryVisitor.h>
+#include <shogun/io/MemoryMappedFile.h>
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/util/converters.h>
 #include <shogun/base/class_list.h>
@@ -18,12 +19,62 @@ using namespace shogun;
 using namespace shogun::io;
 using namespace std;
 
+/** Position of the reader in the stream, shared by the adapters and the
+ * visitor. If the stream is a memory mapped file, its contents are
+ * available through mapped, and owner keeps the mapping alive. */
+struct ReadPosition
+{
+	size_t offset = 0;
+	const char* mapped = nullptr;
+	size_t size = 0;
+	shared_ptr<void> owner;
+};
+
 template<class S>
 class BitseryReaderVisitor: public detail::BitseryVisitor<S, BitseryReaderVisitor<S>>
 {
 public:
-	BitseryReaderVisitor(S& s):
-		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s) {}
+	BitseryReaderVisitor(S& s, ReadPosition* position):
+		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s),
+		m_position(position), m_aligned(false) {}
+
+	void set_aligned(bool aligned)
+	{
+		m_aligned = aligned;
+	}
+
+	void* on_enter_array(S& s, size_t element_size, size_t length)
+	{
+		if (!m_aligned)
+			return nullptr;
+
+		uint8_t padding;
+		for (auto i = detail::array_padding(m_position->offset); i > 0; --i)
+			s.value1b(padding);
+
+		// values are stored in little endian, so they can only be used
+		// in place on little endian platforms
+		auto bytes = element_size * length;
+		if (m_position->mapped == nullptr || utils::is_big_endian() ||
+		    m_position->offset + bytes > m_position->size)
+			return nullptr;
+
+		auto view = m_position->mapped + m_position->offset;
+		m_position->offset += bytes;
+		return const_cast<char*>(view);
+	}
+
+	shared_ptr<void> array_owner() override
+	{
+		return m_position->owner;
+	}
+
+	template <size_t VSIZE, typename T>
+	void on_buffer(S& s, T* v, size_t length)
+	{
+		// read straight into the (already allocated) storage
+		AdapterAccess::getReader(s).template readBuffer<VSIZE>(v, length);
+	}
 
 	void on_complex(S& s, complex128_t* v)
 	{
@@ -54,12 +105,17 @@ public:
 		SG_SDEBUG("reading SGObject: ");
 		if (*v != nullptr)
 			SG_UNREF(*v);
-		*v = object_reader(s, this);
+		size_t obj_magic;
+		s.value8b(obj_magic);
+		*v = object_reader(s, this, obj_magic);
 		if (*v != nullptr)
 			SG_REF(*v);
 	}
 
 private:
+	ReadPosition* m_position;
+	bool m_aligned;
+
 	SG_DELETE_COPY_AND_ASSIGN(BitseryReaderVisitor);
 };
 
@@ -72,7 +128,8 @@ struct InputStreamAdapter
 	{
 		m_status = m_stream->read(&m_buffer, bytes);
 		// FIXME: copying!
-		copy_n(m_buffer.begin(), bytes, buffer);
+		copy_n(m_buffer.begin(), min(bytes, m_buffer.size()), buffer);
+		m_position->offset += bytes;
 	}
 
 	ReaderError error() const
@@ -95,15 +152,53 @@ struct InputStreamAdapter
 	}
 
 	Some<CInputStream> m_stream;
+	ReadPosition* m_position;
 	string m_buffer;
 	error_condition m_status;
 };
 
+/** Reads from a memory mapped file */
+struct MappedInputAdapter
+{
+	typedef char TValue;
+	typedef void TIterator;
+
+	void read(TValue* buffer, size_t bytes)
+	{
+		auto available = m_position->size - m_position->offset;
+		if (bytes > available)
+		{
+			m_error = ReaderError::DataOverflow;
+			fill_n(buffer, bytes, 0);
+			bytes = available;
+		}
+		copy_n(m_position->mapped + m_position->offset, bytes, buffer);
+		m_position->offset += bytes;
+	}
+
+	ReaderError error() const
+	{
+		return m_error;
+	}
+
+	bool isCompletedSuccessfully() const
+	{
+		return m_error == ReaderError::NoError &&
+		       m_position->offset == m_position->size;
+	}
+
+	void setError(ReaderError error)
+	{
+		m_error = error;
+	}
+
+	ReadPosition* m_position;
+	ReaderError m_error = ReaderError::NoError;
+};
+
 template<typename Reader>
-CSGObject* object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, CSGObject* _this = nullptr)
+CSGObject* object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, size_t obj_magic, CSGObject* _this = nullptr)
 {
-	size_t obj_magic;
-	reader.value8b(obj_magic);
 	if (obj_magic == detail::kNullObjectMagic)
 		return nullptr;
 
@@ -151,8 +246,23 @@ CSGObject* object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor,
 	return obj;
 }
 
+template<typename Reader>
+CSGObject* root_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, CSGObject* _this = nullptr)
+{
+	size_t obj_magic;
+	reader.value8b(obj_magic);
+	if (obj_magic == detail::kAlignedArraysMagic)
+	{
+		visitor->set_aligned(true);
+		reader.value8b(obj_magic);
+	}
+	return object_reader(reader, visitor, obj_magic, _this);
+}
+
 using InputAdapter = AdapterReader<InputStreamAdapter, bitsery::DefaultConfig>;
 using BitseryDeserializer = BasicDeserializer<InputAdapter>;
+using MappedAdapter = AdapterReader<MappedInputAdapter, bitsery::DefaultConfig>;
+using BitseryMappedDeserializer = BasicDeserializer<MappedAdapter>;
 
 CBitseryDeserializer::CBitseryDeserializer() : CDeserializer()
 {
@@ -164,16 +274,39 @@ CBitseryDeserializer::~CBitseryDeserializer()
 
 Some<CSGObject> CBitseryDeserializer::read_object()
 {
-	InputStreamAdapter adapter { stream() };
+	ReadPosition position;
+	InputStreamAdapter adapter { stream(), addressof(position) };
 	BitseryDeserializer deser {std::move(adapter)};
-	BitseryReaderVisitor<BitseryDeserializer> reader_visitor(deser);
-	return wrap<CSGObject>(object_reader(deser, addressof(reader_visitor)));
+	BitseryReaderVisitor<BitseryDeserializer> reader_visitor(
+		deser, addressof(position));
+	return wrap<CSGObject>(root_reader(deser, addressof(reader_visitor)));
 }
 
 void CBitseryDeserializer::read(CSGObject* _this)
 {
-	InputStreamAdapter adapter { stream() };
+	ReadPosition position;
+	InputStreamAdapter adapter { stream(), addressof(position) };
 	BitseryDeserializer deser {std::move(adapter)};
-	BitseryReaderVisitor<BitseryDeserializer> reader_visitor(deser);
-	object_reader(deser, addressof(reader_visitor), _this);
+	BitseryReaderVisitor<BitseryDeserializer> reader_visitor(
+		deser, addressof(position));
+	root_reader(deser, addressof(reader_visitor), _this);
+}
+
+Some<CSGObject> CBitseryDeserializer::read_object_mapped(const std::string& filename)
+{
+	auto file = new CMemoryMappedFile<char>(filename.c_str(), 'c');
+	SG_REF(file);
+
+	// the views of the mapping share its ownership, so it is unmapped
+	// once the last of them is gone
+	ReadPosition position;
+	position.mapped = file->get_map();
+	position.size = file->get_size();
+	position.owner = shared_ptr<void>(
+	    file, [](CMemoryMappedFile<char>* f) { SG_UNREF(f); });
+	MappedInputAdapter adapter { addressof(position) };
+	BitseryMappedDeserializer deser {std::move(adapter)};
+	BitseryReaderVisitor<BitseryMappedDeserializer> reader_visitor(
+		deser, addressof(position));
+	return wrap<CSGObject>(root_reader(deser, addressof(reader_visitor)));
 }
@@ -19,6 +19,22 @@ namespace shogun
 			Some<CSGObject> read_object() override;
 			void read(CSGObject* _this) override;
 
+			/** Reads an object from a memory mapped file instead of the
+			 * attached stream. If the file was written with aligned arrays
+			 * (see CBitserySerializer::set_align_arrays()), SGVector and
+			 * SGMatrix parameters are not copied but become views of the
+			 * mapped pages, which are only loaded when they are accessed.
+			 * The mapping is private copy-on-write, i.e. modifying the
+			 * values never changes the file.
+			 *
+			 * The views share the ownership of the mapping, which is
+			 * released when the last of them is destroyed.
+			 *
+			 * @param filename file to map
+			 * @return the deserialized object
+			 */
+			Some<CSGObject> read_object_mapped(const std::string& filename);
+
 			const char* get_name() const override
 			{
 				return "BitseryDeserializer";
@@ -21,8 +21,29 @@ template<class Writer>
 class BitseryWriterVisitor : public detail::BitseryVisitor<Writer, BitseryWriterVisitor<Writer>>
 {
 public:
-	BitseryWriterVisitor(Writer& w):
-		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w) {}
+	BitseryWriterVisitor(Writer& w, const size_t* written = nullptr):
+		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w),
+		m_written(written) {}
+
+	void* on_enter_array(Writer& writer, size_t element_size, size_t length)
+	{
+		// pad the stream so that the values start at an aligned offset
+		if (m_written)
+		{
+			for (auto i = detail::array_padding(*m_written); i > 0; --i)
+				writer.value1b(uint8_t(0));
+		}
+		return nullptr;
+	}
+
+	template <size_t VSIZE, typename T>
+	void on_buffer(Writer& writer, const T* v, size_t length)
+	{
+		// a single write of the whole buffer, values are only byte swapped
+		// one by one if the platform is not little endian
+		AdapterAccess::getWriter(writer).template writeBuffer<VSIZE>(
+		    v, length);
+	}
 
 	void on_complex(Writer& writer, complex128_t* v)
 	{
@@ -69,6 +90,10 @@ public:
 			writer.value8b(detail::kNullObjectMagic);
 		}
 	}
+
+private:
+	/** number of bytes written so far, nullptr if arrays are not aligned */
+	const size_t* m_written;
 };
 
 struct OutputStreamAdapter
@@ -80,7 +105,7 @@ struct OutputStreamAdapter
 		auto ec = m_stream->write(buffer, bytes);
 		if(ec)
 			throw io::to_system_error(ec);
-		written_bytes += bytes;
+		*m_written += bytes;
 	}
 
 	void flush()
@@ -90,11 +115,12 @@ struct OutputStreamAdapter
 
 	size_t writtenBytesCount() const
 	{
-		return written_bytes;
+		return *m_written;
 	}
 
 	Some<COutputStream> m_stream;
-	size_t written_bytes = 0;
+	// shared with the visitor to align arrays
+	size_t* m_written;
 };
 
 // cannot use context because of circular dependency :(
@@ -126,7 +152,7 @@ void write_object(Writer& writer, BitseryWriterVisitor<Writer>* visitor, Some<CS
 using OutputAdapter = AdapterWriter<OutputStreamAdapter, bitsery::DefaultConfig>;
 using BitserySerializer = BasicSerializer<OutputAdapter>;
 
-CBitserySerializer::CBitserySerializer() : CSerializer()
+CBitserySerializer::CBitserySerializer() : CSerializer(), m_align_arrays(false)
 {
 }
 
@@ -136,8 +162,22 @@ CBitserySerializer::~CBitserySerializer()
 
 void CBitserySerializer::write(Some<CSGObject> object) noexcept(false)
 {
-	OutputStreamAdapter adapter { stream() };
+	size_t written = 0;
+	OutputStreamAdapter adapter { stream(), addressof(written) };
  	BitserySerializer serializer {std::move(adapter)};
- 	BitseryWriterVisitor<BitserySerializer> writer_visitor(serializer);
+ 	BitseryWriterVisitor<BitserySerializer> writer_visitor(
+		serializer, m_align_arrays ? addressof(written) : nullptr);
+	if (m_align_arrays)
+		serializer.value8b(detail::kAlignedArraysMagic);
  	write_object(serializer, addressof(writer_visitor), object);
 }
+
+void CBitserySerializer::set_align_arrays(bool align_arrays)
+{
+	m_align_arrays = align_arrays;
+}
+
+bool CBitserySerializer::get_align_arrays() const
+{
+	return m_align_arrays;
+}
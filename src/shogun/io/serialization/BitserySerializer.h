@@ -18,10 +18,24 @@ namespace shogun
 			~CBitserySerializer() override;
 			virtual void write(Some<CSGObject> object) noexcept(false);
 
+			/** Aligns the values of SGVector and SGMatrix parameters in the
+			 * written stream, so that they can be used in place when the
+			 * file is read with CBitseryDeserializer::read_object_mapped().
+			 *
+			 * @param align_arrays whether to align arrays
+			 */
+			void set_align_arrays(bool align_arrays);
+
+			/** @return whether arrays are aligned in the written stream */
+			bool get_align_arrays() const;
+
 			virtual const char* get_name() const
 			{
 				return "BitserySerializer";
 			}
+
+		private:
+			bool m_align_arrays;
 		};
 	}
 }
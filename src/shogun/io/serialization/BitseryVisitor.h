@@ -7,6 +7,7 @@
 
 #include <shogun/lib/any.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/util/converters.h>
 
 namespace shogun
 {
@@ -15,6 +16,34 @@ namespace shogun
 		namespace detail
 		{
 			static const size_t kNullObjectMagic = std::numeric_limits<size_t>::max();
+			/** Written in front of the root object if the values of SGVector
+			 * and SGMatrix parameters are aligned in the stream */
+			static const size_t kAlignedArraysMagic = 0x31414E55474F4853;
+			/** Alignment of SGVector and SGMatrix values in aligned streams */
+			static const size_t kArrayAlignment = 64;
+
+			/** Number of padding bytes in front of an aligned array
+			 *
+			 * @param offset current offset in the stream
+			 */
+			inline size_t array_padding(size_t offset)
+			{
+				return (kArrayAlignment - offset % kArrayAlignment) %
+				       kArrayAlignment;
+			}
+
+			/** Unsigned integer type of a given size in bytes, as the buffer
+			 * functions of the bitsery adapters only accept integral values */
+			template <size_t VSIZE>
+			struct buffer_value;
+			template <>
+			struct buffer_value<1> { typedef uint8_t type; };
+			template <>
+			struct buffer_value<2> { typedef uint16_t type; };
+			template <>
+			struct buffer_value<4> { typedef uint32_t type; };
+			template <>
+			struct buffer_value<8> { typedef uint64_t type; };
 
 			template <class S, class T>
 			class BitseryVisitor : public AnyVisitor
@@ -100,6 +129,58 @@ namespace shogun
 				{
 				}
 
+				// contiguous arrays are passed to the adapter as one buffer
+				bool on_array(char* v, int64_t length) override
+				{
+					return visit_buffer<1>(v, length);
+				}
+				bool on_array(int8_t* v, int64_t length) override
+				{
+					return visit_buffer<1>(v, length);
+				}
+				bool on_array(uint8_t* v, int64_t length) override
+				{
+					return visit_buffer<1>(v, length);
+				}
+				bool on_array(int16_t* v, int64_t length) override
+				{
+					return visit_buffer<2>(v, length);
+				}
+				bool on_array(uint16_t* v, int64_t length) override
+				{
+					return visit_buffer<2>(v, length);
+				}
+				bool on_array(int32_t* v, int64_t length) override
+				{
+					return visit_buffer<4>(v, length);
+				}
+				bool on_array(uint32_t* v, int64_t length) override
+				{
+					return visit_buffer<4>(v, length);
+				}
+				bool on_array(int64_t* v, int64_t length) override
+				{
+					return visit_buffer<8>(v, length);
+				}
+				bool on_array(uint64_t* v, int64_t length) override
+				{
+					return visit_buffer<8>(v, length);
+				}
+				bool on_array(float32_t* v, int64_t length) override
+				{
+					return visit_buffer<4>(v, length);
+				}
+				bool on_array(float64_t* v, int64_t length) override
+				{
+					return visit_buffer<8>(v, length);
+				}
+
+				void* enter_array(size_t element_size, int64_t length) override
+				{
+					return static_cast<T*>(this)->on_enter_array(
+					    m_s, element_size, utils::safe_convert<size_t>(length));
+				}
+
 				void on(CSGObject** v) override
 				{
 					static_cast<T*>(this)->on_object(m_s, v);
@@ -113,6 +194,18 @@ namespace shogun
 				void exit_map(size_t* size) override {}
 
 			private:
+				template <size_t VSIZE, typename V>
+				bool visit_buffer(V* v, int64_t length)
+				{
+					static_assert(sizeof(V) == VSIZE, "Unexpected value size");
+					// floating point values are passed by their bit pattern
+					using U = typename buffer_value<VSIZE>::type;
+					static_cast<T*>(this)->template on_buffer<VSIZE>(
+					    m_s, reinterpret_cast<U*>(v),
+					    utils::safe_convert<size_t>(length));
+					return true;
+				}
+
 				S& m_s;
 				SG_DELETE_COPY_AND_ASSIGN(BitseryVisitor);
 			};
@@ -7,6 +7,7 @@
 #include <shogun/io/serialization/Deserializer.h>
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/io/fs/FileSystem.h>
+#include <shogun/io/stream/AsyncInputStream.h>
 #include <shogun/io/stream/FileInputStream.h>
 
 using namespace shogun;
@@ -66,7 +67,10 @@ CSGObject* shogun::io::deserialize(const std::string& _path, CDeserializer* _des
 	if ((ec = fs->new_random_access_file(_path, &raf)))
 		throw to_system_error(ec);
 
-	auto fis = some<io::CFileInputStream>(raf.get());
-	_deser->attach(fis);
+	// the file is read ahead in the background while being deserialized,
+	// the streams own it as the deserializer may outlive this call
+	auto fis = some<io::CFileInputStream>(raf.release(), true);
+	auto ais = some<io::CAsyncInputStream>(fis.get());
+	_deser->attach(ais);
 	return _deser->read_object().get();
 }
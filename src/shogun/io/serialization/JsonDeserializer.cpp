@@ -100,6 +100,61 @@ public:
 		*v = next_element<float64_t>(&ValueType::GetDouble);
 		SG_SDEBUG("read double with value %f\n", *v);
 	}
+	bool on_array(char* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return utils::safe_convert<char>(x.GetInt()); });
+	}
+	bool on_array(int8_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return utils::safe_convert<int8_t>(x.GetInt()); });
+	}
+	bool on_array(uint8_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return utils::safe_convert<uint8_t>(x.GetUint()); });
+	}
+	bool on_array(int16_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return utils::safe_convert<int16_t>(x.GetInt()); });
+	}
+	bool on_array(uint16_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return utils::safe_convert<uint16_t>(x.GetUint()); });
+	}
+	bool on_array(int32_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return x.GetInt(); });
+	}
+	bool on_array(uint32_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return x.GetUint(); });
+	}
+	bool on_array(int64_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return x.GetInt64(); });
+	}
+	bool on_array(uint64_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return x.GetUint64(); });
+	}
+	bool on_array(float32_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return utils::safe_convert<float32_t>(x.GetDouble()); });
+	}
+	bool on_array(float64_t* v, int64_t length) override
+	{
+		return read_values(v, length, [](const ValueType& x) {
+			return x.GetDouble(); });
+	}
 	void on(floatmax_t* v) override
 	{
 		assert(!m_value_stack.empty());
@@ -215,6 +270,21 @@ private:
 		return r;
 	}
 
+	template<typename T, typename Fn>
+	bool read_values(T* v, int64_t length, Fn read)
+	{
+		if (m_value_stack.size() < utils::safe_convert<size_t>(length))
+			return false;
+
+		SG_SDEBUG("read %" PRId64 " values\n", length);
+		for (int64_t i = 0; i < length; ++i)
+		{
+			v[i] = read(*m_value_stack.top());
+			m_value_stack.pop();
+		}
+		return true;
+	}
+
 	template<class T>
 	void read_array(T* size, const std::string& type)
 	{
@@ -30,16 +30,30 @@ struct COutputStreamAdapter
 	typedef char Ch;
 	void Put(Ch c)
 	{
-		if(auto ec = m_stream->write(&c, 1))
-			throw io::to_system_error(ec);
+		// characters are collected and written in blocks
+		m_buffer.push_back(c);
+		if (m_buffer.size() >= kBufferSize)
+			write_buffer();
 	}
 
 	void Flush()
 	{
+		write_buffer();
 		m_stream->flush();
 	}
 
+	void write_buffer()
+	{
+		if (m_buffer.empty())
+			return;
+		if(auto ec = m_stream->write(m_buffer.data(), m_buffer.size()))
+			throw io::to_system_error(ec);
+		m_buffer.clear();
+	}
+
+	static constexpr size_t kBufferSize = 65536;
 	Some<COutputStream> m_stream;
+	string m_buffer;
 };
 
 template<typename Writer> void write_object(Writer& writer, Some<CSGObject> object);
@@ -126,6 +140,50 @@ public:
 		m_json_writer.Double(*v);
 		close_container();
 	}
+	bool on_array(char* v, int64_t length) override
+	{
+		return write_array(v, length, [this](char x) { m_json_writer.Int(x); });
+	}
+	bool on_array(int8_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](int8_t x) { m_json_writer.Int(x); });
+	}
+	bool on_array(uint8_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](uint8_t x) { m_json_writer.Uint(x); });
+	}
+	bool on_array(int16_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](int16_t x) { m_json_writer.Int(x); });
+	}
+	bool on_array(uint16_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](uint16_t x) { m_json_writer.Uint(x); });
+	}
+	bool on_array(int32_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](int32_t x) { m_json_writer.Int(x); });
+	}
+	bool on_array(uint32_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](uint32_t x) { m_json_writer.Uint(x); });
+	}
+	bool on_array(int64_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](int64_t x) { m_json_writer.Int64(x); });
+	}
+	bool on_array(uint64_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](uint64_t x) { m_json_writer.Uint64(x); });
+	}
+	bool on_array(float32_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](float32_t x) { m_json_writer.Double(x); });
+	}
+	bool on_array(float64_t* v, int64_t length) override
+	{
+		return write_array(v, length, [this](float64_t x) { m_json_writer.Double(x); });
+	}
 	void on(floatmax_t* v) override
 	{
 		SG_SDEBUG("writing floatmax_t with value %Lf\n", *v);
@@ -246,6 +304,22 @@ public:
 	void exit_std_vector(size_t* size) override {}
 	void exit_map(size_t* size) override {}
 private:
+	template <typename T, typename Fn>
+	bool write_array(const T* v, int64_t length, Fn write)
+	{
+		// the values have to be part of the current (innermost) array
+		if (m_remaining.empty() || get<0>(m_remaining.top()) < length)
+			return false;
+
+		SG_SDEBUG("writing %" PRId64 " values\n", length);
+		for (int64_t i = 0; i < length; ++i)
+			write(v[i]);
+
+		get<0>(m_remaining.top()) -= length - 1;
+		close_container();
+		return true;
+	}
+
 	inline void close_container()
 	{
 		if (m_remaining.empty() || get<0>(m_remaining.top()) == in_object)
@@ -330,4 +404,5 @@ void CJsonSerializer::write(Some<CSGObject> object) noexcept(false)
 	auto writer_visitor =
 		make_unique<JSONWriterVisitor<JsonWriter>>(writer);
 	write_object(writer, writer_visitor.get(), object);
+	adapter.Flush();
 }
@@ -0,0 +1,168 @@
+#include <shogun/io/stream/AsyncInputStream.h>
+#include <shogun/io/ShogunErrc.h>
+
+using namespace std;
+using namespace shogun::io;
+
+CAsyncInputStream::CAsyncInputStream(
+	CInputStream* is, size_t block_bytes, int32_t readahead):
+	CInputStream(),
+	m_is(is),
+	m_block_bytes(block_bytes),
+	m_readahead(readahead)
+{
+	REQUIRE(m_block_bytes > 0, "Block size should be positive\n");
+	REQUIRE(m_readahead > 0, "Number of blocks read ahead should be positive\n");
+	SG_REF(m_is);
+}
+
+CAsyncInputStream::~CAsyncInputStream()
+{
+	stop();
+	SG_UNREF(m_is);
+}
+
+void CAsyncInputStream::read_ahead()
+{
+	while (true)
+	{
+		string block;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_block_taken.wait(lock, [this]() {
+				return m_stop ||
+					m_blocks.size() < static_cast<size_t>(m_readahead);
+			});
+			if (m_stop)
+				return;
+			if (!m_spare_blocks.empty())
+			{
+				block.swap(m_spare_blocks.back());
+				m_spare_blocks.pop_back();
+			}
+		}
+
+		m_is->will_read(m_block_bytes * m_readahead);
+		auto r = m_is->read(&block, m_block_bytes);
+
+		lock_guard<mutex> lock(m_mutex);
+		if (!block.empty())
+			m_blocks.push_back(std::move(block));
+		if (r)
+		{
+			m_reader_status = r;
+			m_reader_done = true;
+		}
+		m_block_read.notify_one();
+		if (m_reader_done)
+			return;
+	}
+}
+
+void CAsyncInputStream::stop()
+{
+	if (m_reader.joinable())
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_block_taken.notify_one();
+		m_reader.join();
+	}
+
+	m_blocks.clear();
+	m_current.clear();
+	m_pos = 0;
+	m_reader_status = {};
+	m_reader_done = false;
+	m_stop = false;
+}
+
+error_condition CAsyncInputStream::next_block()
+{
+	if (!m_reader.joinable())
+		m_reader = thread(&CAsyncInputStream::read_ahead, this);
+
+	unique_lock<mutex> lock(m_mutex);
+	m_block_read.wait(
+		lock, [this]() { return !m_blocks.empty() || m_reader_done; });
+
+	if (m_blocks.empty())
+		return m_reader_status;
+
+	m_spare_blocks.push_back(std::move(m_current));
+	m_current = std::move(m_blocks.front());
+	m_blocks.pop_front();
+	m_pos = 0;
+	m_block_taken.notify_one();
+	return {};
+}
+
+error_condition CAsyncInputStream::read(string* buffer, int64_t size)
+{
+	if (size < 0)
+		return make_error_condition(errc::invalid_argument);
+
+	buffer->clear();
+	buffer->reserve(size);
+
+	error_condition r;
+	while (buffer->size() < static_cast<size_t>(size))
+	{
+		if (m_pos == m_current.size())
+		{
+			r = next_block();
+			if (r)
+				break;
+		}
+
+		const int64_t bytes_to_copy =
+			std::min<int64_t>(m_current.size() - m_pos, size - buffer->size());
+		buffer->append(m_current, m_pos, bytes_to_copy);
+		m_pos += bytes_to_copy;
+		m_offset += bytes_to_copy;
+	}
+	return r;
+}
+
+error_condition CAsyncInputStream::skip(int64_t bytes)
+{
+	if (bytes < 0)
+		return make_error_condition(errc::invalid_argument);
+
+	if (m_pos + bytes <= m_current.size())
+	{
+		m_pos += bytes;
+		m_offset += bytes;
+		return {};
+	}
+
+	// the underlying stream is ahead of the consumer by the blocks
+	// read ahead, and can only skip forward
+	stop();
+	int64_t target = m_offset + bytes;
+	int64_t position = m_is->tell();
+	error_condition r;
+	if (target >= position)
+		r = m_is->skip(target - position);
+	else
+	{
+		m_is->reset();
+		r = m_is->skip(target);
+	}
+	m_offset = m_is->tell();
+	return r;
+}
+
+int64_t CAsyncInputStream::tell() const
+{
+	return m_offset;
+}
+
+void CAsyncInputStream::reset()
+{
+	stop();
+	m_is->reset();
+	m_offset = 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __ASYNC_INPUT_STREAM_H__
+#define __ASYNC_INPUT_STREAM_H__
+
+#include <shogun/base/macros.h>
+#include <shogun/io/stream/InputStream.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace shogun
+{
+	namespace io
+	{
+#define IGNORE_IN_CLASSLIST
+		/**
+		 * Input stream which reads blocks of another stream in a
+		 * background thread, so that reading overlaps with processing
+		 * of the data already read. Up to a given number of blocks are
+		 * read ahead of the consumer, two of them give double buffering.
+		 * Before each block, the underlying stream is hinted that the
+		 * following blocks will be read, see CInputStream::will_read.
+		 *
+		 * Skipping within the current block is cheap, other skips and
+		 * resets restart reading ahead at the new position.
+		 */
+		IGNORE_IN_CLASSLIST class CAsyncInputStream : public CInputStream
+		{
+		public:
+			/**
+			 * Construct an asynchronous input stream
+			 *
+			 * @param is stream to read from
+			 * @param block_bytes size of blocks read at once
+			 * @param readahead number of blocks read ahead
+			 */
+			CAsyncInputStream(
+				CInputStream* is, size_t block_bytes = 1 << 20,
+				int32_t readahead = 2);
+
+			~CAsyncInputStream() override;
+
+			std::error_condition read(std::string* buffer, int64_t size) override;
+			std::error_condition skip(int64_t bytes) override;
+			int64_t tell() const override;
+			void reset() override;
+
+			const char* get_name() const override
+			{
+				return "AsyncInputStream";
+			}
+
+		private:
+			/** background loop reading blocks */
+			void read_ahead();
+
+			/** stop the background thread and drop blocks read ahead */
+			void stop();
+
+			/** make the next block read ahead current, waiting for it */
+			std::error_condition next_block();
+
+		private:
+			CInputStream* m_is;
+			size_t m_block_bytes;
+			int32_t m_readahead;
+
+			std::thread m_reader;
+			std::mutex m_mutex;
+			std::condition_variable m_block_read;
+			std::condition_variable m_block_taken;
+			/** blocks read ahead */
+			std::deque<std::string> m_blocks;
+			/** consumed blocks whose memory is reused */
+			std::vector<std::string> m_spare_blocks;
+			/** status of the underlying stream after the last block */
+			std::error_condition m_reader_status;
+			bool m_reader_done = false;
+			bool m_stop = false;
+
+			std::string m_current;
+			size_t m_pos = 0;
+			int64_t m_offset = 0;
+
+			SG_DELETE_COPY_AND_ASSIGN(CAsyncInputStream);
+		};
+	}
+}
+
+#endif /* __ASYNC_INPUT_STREAM_H__ */
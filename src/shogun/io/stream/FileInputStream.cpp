@@ -4,7 +4,10 @@ using namespace std;
 using namespace shogun::io;
 
 CFileInputStream::CFileInputStream(RandomAccessFile* src, bool free):
-	CInputStream(), m_src(src), m_free(free), m_pos(0) {}
+	CInputStream(), m_src(src), m_free(free), m_pos(0)
+{
+	m_src->advise(0, 0, AccessAdvice::Sequential);
+}
 CFileInputStream::~CFileInputStream()
 {
 	if (m_free)
@@ -78,3 +81,9 @@ void CFileInputStream::reset()
 {
 	m_pos = 0;
 }
+
+void CFileInputStream::will_read(int64_t bytes)
+{
+	if (bytes > 0)
+		m_src->advise(m_pos, bytes, AccessAdvice::WillNeed);
+}
@@ -27,6 +27,7 @@ namespace shogun
 			std::error_condition skip(int64_t bytes) override;
 			int64_t tell() const override;
 			void reset() override;
+			void will_read(int64_t bytes) override;
 
 			const char* get_name() const override { return "FileInputStream"; }
 
@@ -23,6 +23,14 @@ namespace shogun
 			virtual std::error_condition skip(int64_t bytes) = 0;
 			virtual int64_t tell() const = 0;
 			virtual void reset() = 0;
+
+			/**
+			 * Hint that the next bytes of the stream will be read soon,
+			 * so that they can be fetched ahead. Ignored by default.
+			 *
+			 * @param bytes number of bytes
+			 */
+			virtual void will_read(int64_t bytes) {}
 		};
 	}
 }
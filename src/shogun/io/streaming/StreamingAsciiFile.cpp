@@ -117,6 +117,22 @@ GET_VECTOR(get_ulong_vector, atoi, uint64_t)
 GET_VECTOR(get_longreal_vector, atoi, floatmax_t)
 #undef GET_VECTOR
 
+/* values are parsed in the precision of the vector */
+template <class T>
+static inline T parse_float(substring s);
+
+template <>
+inline float32_t parse_float<float32_t>(substring s)
+{
+	return SGIO::float_of_substring(s);
+}
+
+template <>
+inline float64_t parse_float<float64_t>(substring s)
+{
+	return SGIO::double_of_substring(s);
+}
+
 #define GET_FLOAT_VECTOR(sg_type)											\
 		void CStreamingAsciiFile::get_vector(sg_type*& vector, int32_t& len)\
 		{																	\
@@ -145,7 +161,7 @@ GET_VECTOR(get_longreal_vector, atoi, floatmax_t)
 				int32_t j=0;												\
 				for (substring* i = feature_start; i != words.end; i++)		\
 				{															\
-						vector[j++] = SGIO::float_of_substring(*i);			\
+						vector[j++] = parse_float<sg_type>(*i);				\
 				}															\
 				SG_RESET_LOCALE;											\
 		}
@@ -261,7 +277,7 @@ GET_VECTOR_AND_LABEL(get_longreal_vector_and_label, atoi, floatmax_t)
 																		\
 				tokenize(m_delimiter, example_string, words);			\
 																		\
-				label = SGIO::float_of_substring(words[0]);				\
+				label = SGIO::double_of_substring(words[0]);			\
 																		\
 				len = words.index() - 1;								\
 				substring* feature_start = &words[1];					\
@@ -272,7 +288,7 @@ GET_VECTOR_AND_LABEL(get_longreal_vector_and_label, atoi, floatmax_t)
 				int32_t j=0;											\
 				for (substring* i = feature_start; i != words.end; i++)	\
 				{														\
-						vector[j++] = SGIO::float_of_substring(*i);		\
+						vector[j++] = parse_float<sg_type>(*i);			\
 				}														\
 				SG_RESET_LOCALE;										\
 		}
@@ -0,0 +1,176 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/streaming/StreamingColumnarFile.h>
+#include <shogun/io/ColumnarFile.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/SGSparseVector.h>
+
+using namespace shogun;
+
+CStreamingColumnarFile::CStreamingColumnarFile() : CStreamingFile()
+{
+	init();
+}
+
+CStreamingColumnarFile::CStreamingColumnarFile(const char* fname,
+	SGVector<index_t> features) : CStreamingFile()
+{
+	init();
+	m_file=new CColumnarFile(fname, 'r');
+	SG_REF(m_file);
+	m_features=features;
+	filename=get_strdup(fname);
+	task='r';
+}
+
+CStreamingColumnarFile::~CStreamingColumnarFile()
+{
+	SG_UNREF(m_file);
+}
+
+void CStreamingColumnarFile::init()
+{
+	m_file=NULL;
+	m_chunk=-1;
+	m_index=0;
+}
+
+void CStreamingColumnarFile::reset_stream()
+{
+	m_chunk=-1;
+	m_index=0;
+	m_dense=SGMatrix<float64_t>();
+	m_sparse=SGSparseMatrix<float64_t>();
+	m_labels=SGVector<float64_t>();
+}
+
+bool CStreamingColumnarFile::next_vector()
+{
+	REQUIRE(m_file, "No file to read from\n");
+
+	if (m_chunk>=0 && m_index+1<m_file->get_chunk_num_vectors(m_chunk))
+	{
+		m_index++;
+		return true;
+	}
+
+	if (m_chunk+1>=m_file->get_num_chunks())
+		return false;
+
+	m_chunk++;
+	m_index=0;
+	if (m_file->is_sparse())
+		m_sparse=m_file->read_sparse_chunk<float64_t>(m_chunk, m_features);
+	else
+		m_dense=m_file->read_dense_chunk<float64_t>(m_chunk, m_features);
+	if (m_file->has_labels())
+		m_labels=m_file->read_labels_chunk(m_chunk);
+	return true;
+}
+
+template <class T>
+void CStreamingColumnarFile::read_vector(T*& vector, int32_t& len,
+	float64_t* label)
+{
+	REQUIRE(m_file && !m_file->is_sparse(),
+		"File '%s' holds no dense features\n", filename);
+	REQUIRE(!label || m_file->has_labels(),
+		"File '%s' holds no labels\n", filename);
+
+	int32_t old_len=len;
+	if (!next_vector())
+	{
+		vector=NULL;
+		len=-1;
+		return;
+	}
+
+	len=m_dense.num_rows;
+	if (!vector || old_len<len)
+		vector=SG_REALLOC(T, vector, old_len, len);
+
+	const float64_t* src=m_dense.get_column_vector(m_index);
+	for (int32_t i=0; i<len; i++)
+		vector[i]=src[i];
+	if (label)
+		*label=m_labels[m_index];
+}
+
+template <class T>
+void CStreamingColumnarFile::read_sparse_vector(
+	SGSparseVectorEntry<T>*& vector, int32_t& len, float64_t* label)
+{
+	REQUIRE(m_file && m_file->is_sparse(),
+		"File '%s' holds no sparse features\n", filename);
+	REQUIRE(!label || m_file->has_labels(),
+		"File '%s' holds no labels\n", filename);
+
+	int32_t old_len=len;
+	if (!next_vector())
+	{
+		vector=NULL;
+		len=-1;
+		return;
+	}
+
+	const SGSparseVector<float64_t>& src=m_sparse[m_index];
+	len=src.num_feat_entries;
+	if (!vector || old_len<len)
+		vector=SG_REALLOC(SGSparseVectorEntry<T>, vector, old_len, len);
+
+	for (int32_t i=0; i<len; i++)
+	{
+		vector[i].feat_index=src.features[i].feat_index;
+		vector[i].entry=src.features[i].entry;
+	}
+	if (label)
+		*label=m_labels[m_index];
+}
+
+void CStreamingColumnarFile::get_vector(float32_t*& vector, int32_t& len)
+{
+	read_vector(vector, len, NULL);
+}
+
+void CStreamingColumnarFile::get_vector(float64_t*& vector, int32_t& len)
+{
+	read_vector(vector, len, NULL);
+}
+
+void CStreamingColumnarFile::get_vector_and_label(
+	float32_t*& vector, int32_t& len, float64_t& label)
+{
+	read_vector(vector, len, &label);
+}
+
+void CStreamingColumnarFile::get_vector_and_label(
+	float64_t*& vector, int32_t& len, float64_t& label)
+{
+	read_vector(vector, len, &label);
+}
+
+void CStreamingColumnarFile::get_sparse_vector(
+	SGSparseVectorEntry<float32_t>*& vector, int32_t& len)
+{
+	read_sparse_vector(vector, len, NULL);
+}
+
+void CStreamingColumnarFile::get_sparse_vector(
+	SGSparseVectorEntry<float64_t>*& vector, int32_t& len)
+{
+	read_sparse_vector(vector, len, NULL);
+}
+
+void CStreamingColumnarFile::get_sparse_vector_and_label(
+	SGSparseVectorEntry<float32_t>*& vector, int32_t& len, float64_t& label)
+{
+	read_sparse_vector(vector, len, &label);
+}
+
+void CStreamingColumnarFile::get_sparse_vector_and_label(
+	SGSparseVectorEntry<float64_t>*& vector, int32_t& len, float64_t& label)
+{
+	read_sparse_vector(vector, len, &label);
+}
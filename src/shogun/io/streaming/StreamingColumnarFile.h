@@ -0,0 +1,117 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __STREAMING_COLUMNARFILE_H__
+#define __STREAMING_COLUMNARFILE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/streaming/StreamingFile.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+class CColumnarFile;
+
+/** @brief Class StreamingColumnarFile to read vector-by-vector from a
+ * CColumnarFile.
+ *
+ * The file is decompressed a chunk at a time, in parallel over its
+ * columns, and optionally restricted to a subset of the features.
+ * Dense files are read with get_vector*, sparse ones with
+ * get_sparse_vector*, as 32 or 64 bit floats.
+ */
+class CStreamingColumnarFile: public CStreamingFile
+{
+public:
+	/** default constructor */
+	CStreamingColumnarFile();
+
+	/** constructor
+	 *
+	 * @param fname file name
+	 * @param features indices of the features to read, all if empty
+	 */
+	CStreamingColumnarFile(const char* fname,
+		SGVector<index_t> features=SGVector<index_t>());
+
+	/** destructor */
+	virtual ~CStreamingColumnarFile();
+
+	/** @return true, as the file can be read again */
+	virtual bool is_seekable() { return true; }
+
+	/** restart reading from the first vector */
+	virtual void reset_stream();
+
+#ifndef SWIG // SWIG should skip this
+	/** @name Dense Vector Access Functions */
+	//@{
+	virtual void get_vector(float32_t*& vector, int32_t& len);
+	virtual void get_vector(float64_t*& vector, int32_t& len);
+	virtual void get_vector_and_label
+		(float32_t*& vector, int32_t& len, float64_t& label);
+	virtual void get_vector_and_label
+		(float64_t*& vector, int32_t& len, float64_t& label);
+	//@}
+
+	/** @name Sparse Vector Access Functions */
+	//@{
+	virtual void get_sparse_vector
+		(SGSparseVectorEntry<float32_t>*& vector, int32_t& len);
+	virtual void get_sparse_vector
+		(SGSparseVectorEntry<float64_t>*& vector, int32_t& len);
+	virtual void get_sparse_vector_and_label
+		(SGSparseVectorEntry<float32_t>*& vector, int32_t& len, float64_t& label);
+	virtual void get_sparse_vector_and_label
+		(SGSparseVectorEntry<float64_t>*& vector, int32_t& len, float64_t& label);
+	//@}
+#endif // SWIG
+
+	/** @return object name */
+	virtual const char* get_name() const { return "StreamingColumnarFile"; }
+
+private:
+	void init();
+
+	/** advance to the next vector, reading the next chunk if needed
+	 *
+	 * @return whether there is a next vector
+	 */
+	bool next_vector();
+
+	/** copy the current dense vector and optionally its label */
+	template <class T>
+	void read_vector(T*& vector, int32_t& len, float64_t* label);
+
+	/** copy the current sparse vector and optionally its label */
+	template <class T>
+	void read_sparse_vector(SGSparseVectorEntry<T>*& vector, int32_t& len,
+		float64_t* label);
+
+private:
+	/** file to read from */
+	CColumnarFile* m_file;
+
+	/** features to read */
+	SGVector<index_t> m_features;
+
+	/** index of the current chunk */
+	int32_t m_chunk;
+
+	/** index of the current vector within the chunk */
+	int32_t m_index;
+
+	/** dense vectors of the current chunk */
+	SGMatrix<float64_t> m_dense;
+
+	/** sparse vectors of the current chunk */
+	SGSparseMatrix<float64_t> m_sparse;
+
+	/** labels of the current chunk */
+	SGVector<float64_t> m_labels;
+};
+}
+#endif //__STREAMING_COLUMNARFILE_H__
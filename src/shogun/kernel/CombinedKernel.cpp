@@ -342,13 +342,18 @@ void CCombinedKernel::list_kernels()
 
 float64_t CCombinedKernel::compute(int32_t x, int32_t y)
 {
+	/* the kernel array holds references to all subkernels, so they can be
+	 * borrowed without touching their reference counts for every pair */
+	auto kernels = kernel_array->get_array();
+	int32_t num_kernels = get_num_kernels();
+
 	float64_t result=0;
-	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
 	{
-		CKernel* k = get_kernel(k_idx);
-		if (k->get_combined_kernel_weight()!=0)
-			result += k->get_combined_kernel_weight() * k->kernel(x,y);
-		SG_UNREF(k);
+		CKernel* k = (CKernel*)kernels[k_idx];
+		float64_t kernel_weight = k->get_combined_kernel_weight();
+		if (kernel_weight!=0)
+			result += kernel_weight * k->kernel(x,y);
 	}
 
 	return result;
@@ -440,6 +445,9 @@ void CCombinedKernel::compute_batch(
 	//make sure we start cleanly
 	delete_optimization();
 
+	//kernels without any batch evaluation are evaluated together below
+	std::vector<CKernel*> fused_kernels;
+
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
 		CKernel* k = get_kernel(k_idx);
@@ -448,16 +456,77 @@ void CCombinedKernel::compute_batch(
 			if (k->get_combined_kernel_weight()!=0)
 				k->compute_batch(num_vec, vec_idx, result, num_suppvec, IDX, weights, k->get_combined_kernel_weight());
 		}
+		else if (k && !k->has_property(KP_LINADD))
+		{
+			if (k->get_combined_kernel_weight()!=0)
+			{
+				fused_kernels.push_back(k);
+				continue;
+			}
+		}
 		else
 			emulate_compute_batch(k, num_vec, vec_idx, result, num_suppvec, IDX, weights);
 
 		SG_UNREF(k);
 	}
 
+	if (!fused_kernels.empty())
+	{
+		compute_batch_fused(fused_kernels, num_vec, vec_idx, result,
+				num_suppvec, IDX, weights);
+
+		for (auto k : fused_kernels)
+			SG_UNREF(k);
+	}
+
 	//clean up
 	delete_optimization();
 }
 
+void CCombinedKernel::compute_batch_fused(
+	const std::vector<CKernel*>& kernels, int32_t num_vec, int32_t* vec_idx,
+	float64_t* result, int32_t num_suppvec, int32_t* IDX, float64_t* weights)
+{
+	ASSERT(IDX!=NULL || num_suppvec==0)
+	ASSERT(weights!=NULL || num_suppvec==0)
+
+	//tiles of vectors and support vectors are swept by all kernels while
+	//their features are still in cache, accumulating the weighted sum of
+	//all kernels in place of one pass over the output per kernel
+	const int32_t vec_block=64;
+	const int32_t sv_block=256;
+	int32_t num_blocks=(num_vec+vec_block-1)/vec_block;
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		int32_t vec_start=b*vec_block;
+		int32_t vec_end=CMath::min(vec_start+vec_block, num_vec);
+		float64_t sums[vec_block]={0};
+
+		for (int32_t sv_start=0; sv_start<num_suppvec; sv_start+=sv_block)
+		{
+			int32_t sv_end=CMath::min(sv_start+sv_block, num_suppvec);
+
+			for (auto k : kernels)
+			{
+				float64_t kernel_weight=k->get_combined_kernel_weight();
+				for (int32_t i=vec_start; i<vec_end; i++)
+				{
+					float64_t sub_result=0;
+					for (int32_t j=sv_start; j<sv_end; j++)
+						sub_result += weights[j] * k->kernel(IDX[j], vec_idx[i]);
+
+					sums[i-vec_start] += kernel_weight*sub_result;
+				}
+			}
+		}
+
+		for (int32_t i=vec_start; i<vec_end; i++)
+			result[i] += sums[i-vec_start];
+	}
+}
+
 void CCombinedKernel::emulate_compute_batch(
 	CKernel* k, int32_t num_vec, int32_t* vec_idx, float64_t* result,
 	int32_t num_suppvec, int32_t* IDX, float64_t* weights)
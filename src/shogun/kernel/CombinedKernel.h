@@ -19,6 +19,8 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/CombinedFeatures.h>
 
+#include <vector>
+
 namespace shogun
 {
 class CFeatures;
@@ -340,6 +342,22 @@ class CCombinedKernel : public CKernel
 			CKernel* k, int32_t num_vec, int32_t* vec_idx, float64_t* target,
 			int32_t num_suppvec, int32_t* IDX, float64_t* weights);
 
+		/** computes sum_k beta_k sum_i alpha_i K_k(x_i,x) for several
+		 * kernels in one blocked sweep over vectors and support vectors
+		 *
+		 * @param kernels kernels to evaluate (with non-zero weight)
+		 * @param num_vec number of vectors
+		 * @param vec_idx vector index
+		 * @param target target
+		 * @param num_suppvec number of support vectors
+		 * @param IDX IDX
+		 * @param weights weights
+		 */
+		void compute_batch_fused(
+			const std::vector<CKernel*>& kernels, int32_t num_vec,
+			int32_t* vec_idx, float64_t* target, int32_t num_suppvec,
+			int32_t* IDX, float64_t* weights);
+
 		/** add to normal vector
 		 *
 		 * @param idx where to add
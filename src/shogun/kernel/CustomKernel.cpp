@@ -135,6 +135,14 @@ bool CCustomKernel::init(CFeatures* l, CFeatures* r)
 		add_row_subset(l_idx->get_feature_index());
 		add_col_subset(r_idx->get_feature_index());
 
+		/* keep the index features, such that kernel machines can
+		 * re-initialise with the same lhs and new rhs indices */
+		SG_REF(l);
+		SG_REF(r);
+		CKernel::init(l, r);
+		SG_UNREF(l);
+		SG_UNREF(r);
+
 		lhs_equals_rhs=m_is_symmetric;
 
 		return true;
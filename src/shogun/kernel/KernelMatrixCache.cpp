@@ -0,0 +1,139 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/features/Features.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/KernelMatrixCache.h>
+#include <shogun/util/hash.h>
+
+#include <functional>
+
+using namespace shogun;
+
+CKernelMatrixCache::CKernelMatrixCache() : CSGObject()
+{
+	init();
+}
+
+CKernelMatrixCache::CKernelMatrixCache(int32_t max_size) : CSGObject()
+{
+	init();
+	set_max_size(max_size);
+}
+
+CKernelMatrixCache::~CKernelMatrixCache()
+{
+	clear();
+}
+
+void CKernelMatrixCache::init()
+{
+	m_max_size=1024;
+
+	SG_ADD(&m_max_size, "max_size",
+			"Maximum size of all cached matrices in MB.",
+			ParameterProperties::SETTING);
+}
+
+CCustomKernel* CKernelMatrixCache::get_kernel_matrix(CKernel* kernel,
+		CFeatures* features)
+{
+	REQUIRE(kernel, "No kernel provided.\n");
+	REQUIRE(features, "No features provided.\n");
+
+	size_t hash=hyperparameter_hash(kernel);
+
+	/* kernel matrices are computed in parallel already, so computing them
+	 * while holding the lock only avoids computing the same one twice */
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	for (auto it=m_matrices.begin(); it!=m_matrices.end(); ++it)
+	{
+		if (it->hash==hash && it->features==features &&
+				hyperparameter_equals(it->kernel, kernel))
+		{
+			m_matrices.splice(m_matrices.begin(), m_matrices, it);
+			SG_REF(it->matrix);
+			return it->matrix;
+		}
+	}
+
+	SG_DEBUG("Computing %dx%d kernel matrix of %s\n",
+			features->get_num_vectors(), features->get_num_vectors(),
+			kernel->get_name());
+
+	/* compute on a copy in order to leave the features of kernel untouched,
+	 * the copy then records the hyperparameters of the entry */
+	auto copy=make_clone(kernel,
+			ParameterProperties::HYPER | ParameterProperties::SETTING);
+	copy->init(features, features);
+	auto matrix=new CCustomKernel(copy);
+	copy->remove_lhs_and_rhs();
+
+	SG_REF(features);
+	SG_REF(matrix);
+	m_matrices.push_front({hash, copy, features, matrix});
+	shrink();
+
+	SG_REF(matrix);
+	return matrix;
+}
+
+void CKernelMatrixCache::release(Entry& entry)
+{
+	SG_UNREF(entry.matrix);
+	SG_UNREF(entry.features);
+	SG_UNREF(entry.kernel);
+}
+
+void CKernelMatrixCache::clear()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	for (auto& entry : m_matrices)
+		release(entry);
+
+	m_matrices.clear();
+}
+
+int32_t CKernelMatrixCache::get_num_matrices() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_matrices.size();
+}
+
+void CKernelMatrixCache::set_max_size(int32_t max_size)
+{
+	REQUIRE(max_size>=0, "Maximum size (%d MB) must not be negative.\n",
+			max_size);
+	m_max_size=max_size;
+}
+
+int32_t CKernelMatrixCache::get_max_size() const
+{
+	return m_max_size;
+}
+
+void CKernelMatrixCache::shrink()
+{
+	int64_t max_bytes=int64_t(m_max_size)*1024*1024;
+	int64_t num_bytes=0;
+
+	/* the most recently used matrix is always kept */
+	auto it=m_matrices.begin();
+	while (it!=m_matrices.end())
+	{
+		num_bytes+=int64_t(it->matrix->get_num_vec_lhs())*
+				it->matrix->get_num_vec_rhs()*sizeof(float32_t);
+
+		if (it!=m_matrices.begin() && num_bytes>max_bytes)
+		{
+			release(*it);
+			it=m_matrices.erase(it);
+		}
+		else
+			++it;
+	}
+}
@@ -0,0 +1,118 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _KERNELMATRIXCACHE_H___
+#define _KERNELMATRIXCACHE_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/common.h>
+
+#include <list>
+#include <mutex>
+
+namespace shogun
+{
+class CKernel;
+class CCustomKernel;
+class CFeatures;
+
+/** @brief Cache of precomputed kernel matrices, keyed on the kernel
+ * hyperparameters.
+ *
+ * Model selection evaluates the same kernel many times: once per
+ * cross-validation fold, and once per combination of hyperparameters that
+ * only differ in parameters of the machine (e.g. the C of an SVM). This cache
+ * computes the full kernel matrix of a kernel on a set of features once and
+ * hands it out as a CCustomKernel. Folds then index into the shared matrix via
+ * CIndexFeatures instead of evaluating the kernel again.
+ *
+ * Two kernels share a matrix if they are of the same type and all their
+ * hyperparameters (ParameterProperties::HYPER, including the ones of nested
+ * objects like the normalizer) are equal, and the matrix was computed on the
+ * very same features object. Each entry holds a reference to its features
+ * and a copy of the kernel hyperparameters, which are compared exactly on
+ * lookup, so neither a hash collision nor a reused address of freed
+ * features can return a wrong matrix. Matrices are stored as 32bit floats
+ * (see CCustomKernel). If the total size exceeds the limit set with
+ * set_max_size(), the least recently used matrices are discarded.
+ *
+ * All methods are thread-safe, so a single cache can be shared by concurrent
+ * evaluations.
+ */
+class CKernelMatrixCache : public CSGObject
+{
+public:
+	/** default constructor */
+	CKernelMatrixCache();
+
+	/** constructor
+	 *
+	 * @param max_size maximum size of all cached matrices in MB
+	 */
+	CKernelMatrixCache(int32_t max_size);
+
+	/** destructor */
+	virtual ~CKernelMatrixCache();
+
+	/** Returns the kernel matrix of the given kernel on the given features.
+	 * The matrix is computed (on a copy of the kernel) if it is not cached.
+	 *
+	 * @param kernel kernel whose matrix is requested
+	 * @param features features to compute the kernel matrix on
+	 * @return custom kernel that holds the full matrix (already SG_REF'ed)
+	 */
+	CCustomKernel* get_kernel_matrix(CKernel* kernel, CFeatures* features);
+
+	/** removes all cached matrices */
+	void clear();
+
+	/** @return number of cached matrices */
+	int32_t get_num_matrices() const;
+
+	/** @param max_size maximum size of all cached matrices in MB */
+	void set_max_size(int32_t max_size);
+
+	/** @return maximum size of all cached matrices in MB */
+	int32_t get_max_size() const;
+
+	/** @return name of the SGSerializable */
+	virtual const char* get_name() const { return "KernelMatrixCache"; }
+
+protected:
+	/** discards least recently used matrices until the size limit holds */
+	void shrink();
+
+private:
+	void init();
+
+protected:
+	/** a cached matrix and what it was computed from */
+	struct Entry
+	{
+		/** hash of the kernel hyperparameters */
+		size_t hash;
+		/** copy of the kernel the matrix was computed with */
+		CKernel* kernel;
+		/** features the matrix was computed on */
+		CFeatures* features;
+		/** the kernel matrix */
+		CCustomKernel* matrix;
+	};
+
+	/** releases the references held by an entry */
+	void release(Entry& entry);
+
+	/** maximum size of all cached matrices in MB */
+	int32_t m_max_size;
+
+	/** cached matrices, most recently used first */
+	std::list<Entry> m_matrices;
+
+	/** protects m_matrices */
+	mutable std::mutex m_mutex;
+};
+}
+#endif /* _KERNELMATRIXCACHE_H___ */
@@ -224,6 +224,13 @@ float64_t CCommWordStringKernel::compute_helper(
 }
 
 void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
+{
+	if (add_to_dictionary(vec_idx, weight, dictionary_weights.vector))
+		set_is_initialized(true);
+}
+
+bool CCommWordStringKernel::add_to_dictionary(
+	int32_t vec_idx, float64_t weight, float64_t* dictionary)
 {
 	int32_t len=-1;
 	bool free_vec;
@@ -240,11 +247,11 @@ void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				dictionary_weights[(int32_t) vec[j-1]]+=normalizer->
+				dictionary[(int32_t) vec[j-1]]+=normalizer->
 					normalize_lhs(weight, vec_idx);
 			}
 
-			dictionary_weights[(int32_t) vec[len-1]]+=normalizer->
+			dictionary[(int32_t) vec[len-1]]+=normalizer->
 				normalize_lhs(weight, vec_idx);
 		}
 		else
@@ -254,18 +261,18 @@ void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				dictionary_weights[(int32_t) vec[j-1]]+=normalizer->
+				dictionary[(int32_t) vec[j-1]]+=normalizer->
 					normalize_lhs(weight*(j-last_j), vec_idx);
 				last_j = j;
 			}
 
-			dictionary_weights[(int32_t) vec[len-1]]+=normalizer->
+			dictionary[(int32_t) vec[len-1]]+=normalizer->
 				normalize_lhs(weight*(len-last_j), vec_idx);
 		}
-		set_is_initialized(true);
 	}
 
 	((CStringFeatures<uint16_t>*) lhs)->free_feature_vector(vec, vec_idx, free_vec);
+	return len>0;
 }
 
 void CCommWordStringKernel::clear_normal()
@@ -288,10 +295,25 @@ bool CCommWordStringKernel::init_optimization(
 
 	SG_DEBUG("initializing CCommWordStringKernel optimization\n")
 
-	for (auto i : SG_PROGRESS(range(0, count)))
+	auto pb = SG_PROGRESS(range(0, count));
+
+	/* words are added to a dictionary per thread, which are summed up */
+#pragma omp parallel
 	{
-		add_to_normal(IDX[i], weights[i]);
+		SGVector<float64_t> dictionary(dictionary_weights.vlen);
+		dictionary.zero();
+
+#pragma omp for schedule(dynamic, 16)
+		for (int32_t i=0; i<count; i++)
+		{
+			add_to_dictionary(IDX[i], weights[i], dictionary.vector);
+			pb.print_progress();
+		}
+
+#pragma omp critical
+		dictionary_weights.add(dictionary);
 	}
+	pb.complete();
 
 	set_is_initialized(true);
 	return true;
@@ -137,6 +137,18 @@ class CCommWordStringKernel : public CStringKernel<uint16_t>
 		/** clear normal */
 		virtual void clear_normal();
 
+		/** add weighted words of a string to a dictionary, which
+		 * init_optimization() calls concurrently with a dictionary per
+		 * thread
+		 *
+		 * @param idx index of string
+		 * @param weight weight of string
+		 * @param dictionary dictionary of the size of dictionary_weights
+		 * @return whether the string was not empty
+		 */
+		virtual bool add_to_dictionary(int32_t idx, float64_t weight,
+				float64_t* dictionary);
+
 		/** return feature type the kernel can deal with
 		 *
 		 * @return feature type WORD
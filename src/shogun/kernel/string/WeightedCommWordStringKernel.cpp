@@ -174,8 +174,8 @@ float64_t CWeightedCommWordStringKernel::compute_helper(
 	return result;
 }
 
-void CWeightedCommWordStringKernel::add_to_normal(
-	int32_t vec_idx, float64_t weight)
+bool CWeightedCommWordStringKernel::add_to_dictionary(
+	int32_t vec_idx, float64_t weight, float64_t* dictionary)
 {
 	int32_t len=-1;
 	bool free_vec;
@@ -193,15 +193,14 @@ void CWeightedCommWordStringKernel::add_to_normal(
 				mask = mask | (1 << (degree-d-1));
 				int32_t idx=s->get_masked_symbols(vec[j], mask);
 				idx=s->shift_symbol(idx, degree-d-1);
-				dictionary_weights[offs + idx] += normalizer->normalize_lhs(weight*weights[d], vec_idx);
+				dictionary[offs + idx] += normalizer->normalize_lhs(weight*weights[d], vec_idx);
 				offs+=s->shift_offset(1,d+1);
 			}
 		}
-
-		set_is_initialized(true);
 	}
 
 	s->free_feature_vector(vec, vec_idx, free_vec);
+	return len>0;
 }
 
 void CWeightedCommWordStringKernel::merge_normal()
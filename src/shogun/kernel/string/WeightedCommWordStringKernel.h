@@ -88,12 +88,15 @@ class CWeightedCommWordStringKernel: public CCommWordStringKernel
 		*/
 		virtual float64_t compute_optimized(int32_t idx);
 
-		/** add to normal
+		/** add weighted words of a string to a dictionary
 		 *
-		 * @param idx where to add
-		 * @param weight what to add
+		 * @param idx index of string
+		 * @param weight weight of string
+		 * @param dictionary dictionary of the size of dictionary_weights
+		 * @return whether the string was not empty
 		 */
-		virtual void add_to_normal(int32_t idx, float64_t weight);
+		virtual bool add_to_dictionary(int32_t idx, float64_t weight,
+				float64_t* dictionary);
 
 		/** merge normal */
 		void merge_normal();
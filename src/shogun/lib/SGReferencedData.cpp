@@ -51,10 +51,16 @@ int32_t SGReferencedData::ref_count()
 	return c;
 }
 
+void SGReferencedData::set_owner(std::shared_ptr<void> owner)
+{
+	m_owner = owner;
+}
+
 /** copy refcount */
 void SGReferencedData::copy_refcount(const SGReferencedData &orig)
 {
 	m_refcount =  orig.m_refcount;
+	m_owner = orig.m_owner;
 }
 
 /** increase reference counter
@@ -83,6 +89,8 @@ int32_t SGReferencedData::ref()
  */
 int32_t SGReferencedData::unref()
 {
+	m_owner.reset();
+
 	if (m_refcount == NULL)
 	{
 		init_data();
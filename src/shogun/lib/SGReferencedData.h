@@ -11,6 +11,8 @@
 
 #include <shogun/lib/common.h>
 
+#include <memory>
+
 namespace shogun
 {
 class RefCount;
@@ -41,6 +43,15 @@ class SGReferencedData
 		 */
 		int32_t ref_count();
 
+#ifndef SWIG // SWIG should skip this
+		/** set an object that is kept alive as long as this data or any
+		 * copy of it is, e.g. the owner of memory the data is a view of
+		 *
+		 * @param owner shared owner, released with the last copy
+		 */
+		void set_owner(std::shared_ptr<void> owner);
+#endif // SWIG
+
 	protected:
 		/** copy refcount */
 		void copy_refcount(const SGReferencedData &orig);
@@ -71,6 +82,9 @@ class SGReferencedData
 
 		/** reference counter */
 		RefCount* m_refcount;
+
+		/** owner of the data, shared by all copies */
+		std::shared_ptr<void> m_owner;
 };
 }
 #endif // __SGREFERENCED_DATA_H__
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <limits>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <stdexcept>
 #include <string.h>
@@ -162,6 +163,25 @@ namespace shogun {
 		}
 	};
 
+	/** Whether contiguous arrays of T can be visited at once, see
+	 * AnyVisitor::on_array() */
+	template <class T>
+	struct is_array_visitable
+	    : std::integral_constant<
+	          bool, std::is_same<T, char>::value ||
+	                    std::is_same<T, int8_t>::value ||
+	                    std::is_same<T, uint8_t>::value ||
+	                    std::is_same<T, int16_t>::value ||
+	                    std::is_same<T, uint16_t>::value ||
+	                    std::is_same<T, int32_t>::value ||
+	                    std::is_same<T, uint32_t>::value ||
+	                    std::is_same<T, int64_t>::value ||
+	                    std::is_same<T, uint64_t>::value ||
+	                    std::is_same<T, float32_t>::value ||
+	                    std::is_same<T, float64_t>::value>
+	{
+	};
+
 	class AnyVisitor
 	{
 	public:
@@ -194,14 +214,66 @@ namespace shogun {
 		virtual void exit_std_vector(size_t* size) = 0;
 		virtual void exit_map(size_t* size) = 0;
 
+		/** Visits a contiguous array of values at once, e.g. to write or
+		 * read the whole buffer with a single call. Visitors that do not
+		 * override this visit each value on its own.
+		 *
+		 * @param v first value
+		 * @param length number of values
+		 * @return whether the values were visited
+		 */
+		virtual bool on_array(char* v, int64_t length) { return false; }
+		virtual bool on_array(int8_t* v, int64_t length) { return false; }
+		virtual bool on_array(uint8_t* v, int64_t length) { return false; }
+		virtual bool on_array(int16_t* v, int64_t length) { return false; }
+		virtual bool on_array(uint16_t* v, int64_t length) { return false; }
+		virtual bool on_array(int32_t* v, int64_t length) { return false; }
+		virtual bool on_array(uint32_t* v, int64_t length) { return false; }
+		virtual bool on_array(int64_t* v, int64_t length) { return false; }
+		virtual bool on_array(uint64_t* v, int64_t length) { return false; }
+		virtual bool on_array(float32_t* v, int64_t length) { return false; }
+		virtual bool on_array(float64_t* v, int64_t length) { return false; }
+
+		/** Called before the values of a SGVector or SGMatrix are visited
+		 * as one contiguous block. Visitors may use it to align the block,
+		 * and readers may provide the values in place, e.g. from a memory
+		 * mapped file, in which case the values are not visited and the
+		 * container becomes a view of the returned memory, which keeps
+		 * array_owner() alive.
+		 *
+		 * @param element_size size of a single value in bytes
+		 * @param length number of values
+		 * @return pointer to the values or nullptr to visit them
+		 */
+		virtual void* enter_array(size_t element_size, int64_t length)
+		{
+			return nullptr;
+		}
+
+		/** @return owner of the memory returned by enter_array() */
+		virtual std::shared_ptr<void> array_owner()
+		{
+			return nullptr;
+		}
+
 		template <typename T>
-		void on_matrix_row(index_t* rows, index_t* cols, SGMatrix<T>* _v)
+		void on_elements(T* v, int64_t length)
 		{
-			enter_matrix_row(rows, cols);
-			for(index_t i=0; i<*rows; i++)
+			if constexpr (is_array_visitable<T>::value)
 			{
-				on(std::addressof((*_v)(i, *cols)));
+				if (length > 0 && on_array(v, length))
+					return;
 			}
+			for (int64_t i = 0; i < length; ++i)
+				on(std::addressof(v[i]));
+		}
+
+		template <typename T>
+		void on_matrix_row(index_t* rows, index_t* cols, SGMatrix<T>* _v)
+		{
+			enter_matrix_row(rows, cols);
+			// columns are contiguous
+			on_elements(_v->get_column_vector(*cols), *rows);
 			exit_matrix_row(rows, cols);
 		}
 
@@ -210,10 +282,20 @@ namespace shogun {
 		{
 			auto size = _v->vlen;
 			enter_vector(std::addressof(size));
+			if constexpr (is_array_visitable<T>::value)
+			{
+				auto view = size > 0 ? enter_array(sizeof(T), size) : nullptr;
+				if (view != nullptr)
+				{
+					*_v = SGVector<T>(static_cast<T*>(view), size, false);
+					_v->set_owner(array_owner());
+					exit_vector(std::addressof(size));
+					return;
+				}
+			}
 			if (size != _v->vlen)
 				_v->resize_vector(size);
-			for (auto& _value: *_v)
-				on(std::addressof(_value));
+			on_elements(_v->vector, size);
 			exit_vector(std::addressof(size));
 		}
 
@@ -257,9 +339,7 @@ namespace shogun {
 				if (size)
 					*_v->ptr() = SG_CALLOC(T, size);
 			}
-			auto ptr = *(_v->ptr());
-			for (S i = 0; i < size; ++i)
-				on(std::addressof(ptr[i]));
+			on_elements(*(_v->ptr()), size);
 			exit_vector(std::addressof(size));
 		}
 
@@ -278,9 +358,7 @@ namespace shogun {
 				if (length)
 					*_v->ptr() = SG_MALLOC(T, length);
 			}
-			auto ptr = *(_v->ptr());
-			for (int64_t i = 0; i < length; ++i)
-				on(std::addressof(ptr[i]));
+			on_elements(*(_v->ptr()), length);
 			exit_matrix(shape.first, shape.second);
 		}
 
@@ -290,6 +368,18 @@ namespace shogun {
 			auto rows = _matrix->num_rows;
 			auto cols = _matrix->num_cols;
 			enter_matrix(std::addressof(rows), std::addressof(cols));
+			if constexpr (is_array_visitable<T>::value)
+			{
+				int64_t length = int64_t(rows) * cols;
+				auto view = length > 0 ? enter_array(sizeof(T), length) : nullptr;
+				if (view != nullptr)
+				{
+					*_matrix = SGMatrix<T>(static_cast<T*>(view), rows, cols, false);
+					_matrix->set_owner(array_owner());
+					exit_matrix(std::addressof(rows), std::addressof(cols));
+					return;
+				}
+			}
 			if ((rows != _matrix->num_rows) || (cols != _matrix->num_cols))
 				*_matrix = SGMatrix<T>(rows, cols);
 			for (auto index=0; index < cols; index++) {
@@ -56,4 +56,46 @@ SG_FORCED_INLINE static void CpuRelax()
 #endif
 }
 
+namespace shogun
+{
+	/** Vector instruction set extensions used by SIMD kernels, in
+	 * increasing order of capability
+	 */
+	enum ECpuSimdLevel
+	{
+		/** portable scalar code */
+		CPU_SIMD_NONE = 0,
+		/** AVX2 with fused multiply-add */
+		CPU_SIMD_AVX2 = 1,
+		/** AVX-512 foundation and conflict detection */
+		CPU_SIMD_AVX512 = 2
+	};
+
+	/** Detects the best vector instruction set extension supported by
+	 * the running CPU, so that kernels compiled for several extensions
+	 * can be chosen at runtime. Detection runs once.
+	 *
+	 * @return supported instruction set extension
+	 */
+	static inline ECpuSimdLevel get_cpu_simd_level()
+	{
+#if defined(HAVE_SSE2) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+		static const ECpuSimdLevel level = []() {
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f") &&
+			    __builtin_cpu_supports("avx512cd"))
+				return CPU_SIMD_AVX512;
+			if (__builtin_cpu_supports("avx2") &&
+			    __builtin_cpu_supports("fma"))
+				return CPU_SIMD_AVX2;
+			return CPU_SIMD_NONE;
+		}();
+		return level;
+#else
+		return CPU_SIMD_NONE;
+#endif
+	}
+}
+
 #endif /* __CPU_INFO_H__ */
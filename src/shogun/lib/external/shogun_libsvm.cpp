@@ -1844,6 +1844,23 @@ static void solve_c_svc(
 		if(prob->y[i] > 0) y[i] = +1; else y[i]=-1;
 	}
 
+	if (prob->alpha)
+	{
+		// warm start: scaling all alphas by the same factor keeps them
+		// within the (possibly smaller) box without violating y'alpha=0
+		float64_t scale = 1;
+		for(i=0;i<l;i++)
+		{
+			alpha[i] = fabs(prob->alpha[i]);
+			float64_t C_i = y[i] > 0 ? Cp : Cn;
+			if (alpha[i] > C_i)
+				scale = CMath::min(scale, C_i/alpha[i]);
+		}
+
+		for(i=0;i<l;i++)
+			alpha[i] *= scale;
+	}
+
 	Solver s;
 	s.Solve(l, SVC_Q(*prob,*param,y), prob->pv, y,
 		alpha, Cp, Cn, param->eps, si, param->shrinking, param->use_bias);
@@ -2355,12 +2372,15 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 		svm_node **x = SG_MALLOC(svm_node *,l);
 		float64_t *C = SG_MALLOC(float64_t,l);
 		float64_t *pv = SG_MALLOC(float64_t,l);
+		float64_t *alpha = prob->alpha ? SG_MALLOC(float64_t,l) : NULL;
 
 
 		int32_t i;
 		for(i=0;i<l;i++) {
 			x[i] = prob->x[perm[i]];
             C[i] = prob->C[perm[i]];
+			if (alpha)
+				alpha[i] = prob->alpha[perm[i]];
 
             if (prob->pv)
             {
@@ -2410,6 +2430,8 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 				sub_prob.y = SG_MALLOC(float64_t,sub_prob.l+1); //dirty hack to surpress valgrind err
 				sub_prob.C = SG_MALLOC(float64_t,sub_prob.l+1);
 				sub_prob.pv = SG_MALLOC(float64_t,sub_prob.l+1);
+				if (alpha)
+					sub_prob.alpha = SG_MALLOC(float64_t,sub_prob.l);
 
 				int32_t k;
 				for(k=0;k<ci;k++)
@@ -2418,7 +2440,8 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 					sub_prob.y[k] = +1;
                     sub_prob.C[k] = C[si+k];
                     sub_prob.pv[k] = pv[si+k];
-
+					if (alpha)
+						sub_prob.alpha[k] = alpha[si+k];
 				}
 				for(k=0;k<cj;k++)
 				{
@@ -2426,6 +2449,8 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 					sub_prob.y[ci+k] = -1;
                     sub_prob.C[ci+k] = C[sj+k];
                     sub_prob.pv[ci+k] = pv[sj+k];
+					if (alpha)
+						sub_prob.alpha[ci+k] = alpha[sj+k];
 				}
 				sub_prob.y[sub_prob.l]=-1; //dirty hack to surpress valgrind err
 				sub_prob.C[sub_prob.l]=-1;
@@ -2442,6 +2467,7 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 				SG_FREE(sub_prob.y);
 				SG_FREE(sub_prob.C);
 				SG_FREE(sub_prob.pv);
+				SG_FREE(sub_prob.alpha);
 				++p;
 			}
 
@@ -2523,6 +2549,7 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 		SG_FREE(x);
 		SG_FREE(C);
 		SG_FREE(pv);
+		SG_FREE(alpha);
 		SG_FREE(weighted_C);
 		SG_FREE(nonzero);
 		for(i=0;i<nr_class*(nr_class-1)/2;i++)
@@ -64,6 +64,7 @@ public:
 		x = NULL;
 		C = NULL;
 		pv = NULL;
+		alpha = NULL;
 	}
 
 
@@ -77,6 +78,8 @@ public:
     float64_t *C;
     /** precomputed p */
 	float64_t *pv;
+	/** initial alphas for warm starting C_SVC, or NULL to start at zero */
+	float64_t *alpha;
 
 };
 
@@ -353,6 +353,20 @@ namespace tapkee
 		 */
 		const stichwort::ParameterKeyword<ScalarType> sne_theta("SNE theta", 0.5);
 
+		/** The keyword for the value that stores whether the t-SNE
+		 * gradient is computed with FFT-accelerated interpolation
+		 * instead of Barnes-Hut. Only two dimensional embeddings are
+		 * supported.
+		 *
+		 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+		 *
+		 * Default value is false.
+		 *
+		 * The corresponding value should have type bool.
+		 */
+		const stichwort::ParameterKeyword<bool>
+			sne_fft_interpolation("SNE FFT interpolation", false);
+
 		/** The keyword for the value that stores the squishingRate
 		 * parameter of the Manifold Sculpting algorithm.
 		 *
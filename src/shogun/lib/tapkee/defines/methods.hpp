@@ -137,6 +137,9 @@ namespace tapkee
 	static const NeighborsMethod Brute("Brute-force");
 	//! Vantage point tree -based method.
 	static const NeighborsMethod VpTree("Vantage point tree");
+	//! Approximate method refining a random neighbors graph by
+	//! NN-descent, with local joins computed in parallel.
+	static const NeighborsMethod NnDescent("NN-descent");
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 	//! Covertree-based method with approximate \f$ O(\log N) \f$ time complexity.
 	//! Recommended to be used as a default method.
@@ -168,6 +171,10 @@ namespace tapkee
 	//! Eigen library dense method (could be useful for debugging). Computes
 	//! all eigenvectors thus can be very slow doing large-scale.
 	static const EigenMethod Dense("Dense");
+	//! Lanczos method with thick restarts. Only multiplies by the
+	//! matrix or, for smallest eigenvalues, solves with its sparse
+	//! factorization thus scales to large sparse problems.
+	static const EigenMethod Lanczos("Lanczos");
 
 #ifdef TAPKEE_WITH_ARPACK
 	static EigenMethod default_eigen_method = Arpack;
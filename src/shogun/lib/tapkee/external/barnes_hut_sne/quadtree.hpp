@@ -71,9 +71,6 @@ class QuadTree
 	static const int QT_NO_DIMS = 2;
 	static const int QT_NODE_CAPACITY = 1;
 
-	// A buffer we use when doing force computations
-	ScalarType buff[QT_NO_DIMS];
-
 	// Properties of this node in the tree
 	QuadTree* parent;
 	bool is_leaf;
@@ -314,8 +311,11 @@ public:
 	}
 
 	// Compute non-edge forces using Barnes-Hut algorithm
-	void computeNonEdgeForces(int point_index, ScalarType theta, ScalarType neg_f[], ScalarType* sum_Q)
+	// Computes non-edge forces of a single point, the tree is not modified so
+	// that the forces of different points can be computed concurrently
+	void computeNonEdgeForces(int point_index, ScalarType theta, ScalarType neg_f[], ScalarType* sum_Q) const
 	{
+		ScalarType buff[QT_NO_DIMS];
 
 		// Make sure that we spend no time on empty nodes or self-interactions
 		if(cum_size == 0 || (is_leaf && size == 1 && index[0] == point_index)) return;
@@ -346,13 +346,15 @@ public:
 		}
 	}
 
-	// Computes edge forces
-	void computeEdgeForces(int* row_P, int* col_P, ScalarType* val_P, int N, ScalarType* pos_f)
+	// Computes edge forces of the points in data
+	static void computeEdgeForces(const ScalarType* data, int* row_P, int* col_P, ScalarType* val_P, int N, ScalarType* pos_f)
 	{
-		// Loop over all edges in the graph
-		int ind1, ind2;
-		ScalarType D;
+		// Loop over all edges in the graph, rows only write their own forces
+#pragma omp parallel for
 		for(int n = 0; n < N; n++) {
+			ScalarType buff[QT_NO_DIMS];
+			int ind1, ind2;
+			ScalarType D;
 			ind1 = n * QT_NO_DIMS;
 			for(int i = row_P[n]; i < row_P[n + 1]; i++) {
 
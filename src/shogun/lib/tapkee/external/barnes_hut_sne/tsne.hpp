@@ -39,12 +39,16 @@
 #include <shogun/lib/tapkee/external/barnes_hut_sne/vptree.hpp>
 /* End of Tapkee includes */
 
+#include <unsupported/Eigen/FFT>
+
 #include <math.h>
 #include <float.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <complex>
 #include <cstring>
 #include <time.h>
+#include <vector>
 
 //! Namespace containing implementation of t-SNE algorithm
 namespace tsne
@@ -57,12 +61,15 @@ static inline ScalarType sign(ScalarType x) { return (x == .0 ? .0 : (x < .0 ? -
 class TSNE
 {
 public:
-	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta)
+	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta,
+	         bool fft_interpolation = false)
 	{
 		// Determine whether we are using an exact algorithm
-		bool exact = (theta == .0) ? true : false;
+		bool exact = (theta == .0 && !fft_interpolation) ? true : false;
 		if (exact)
 			tapkee::LoggingSingleton::instance().message_info("Using exact t-SNE algorithm");
+		else if (fft_interpolation)
+			tapkee::LoggingSingleton::instance().message_info("Using FFT-accelerated interpolation t-SNE algorithm");
 		else
 			tapkee::LoggingSingleton::instance().message_info("Using Barnes-Hut-SNE algorithm");
 
@@ -133,6 +140,7 @@ public:
 
 				// Compute (approximate) gradient
 				if(exact) computeExactGradient(P.data(), Y, N, no_dims, dY.data());
+				else if(fft_interpolation) computeFFTGradient(row_P, col_P, val_P, Y, N, no_dims, dY.data());
 				else computeGradient(P.data(), row_P, col_P, val_P, Y, N, no_dims, dY.data(), theta);
 
 				// Update gains
@@ -161,6 +169,12 @@ public:
 				if((iter > 0) && ((iter % 50 == 0) || (iter == max_iter - 1))) {
 					ScalarType C = .0;
 					if(exact) C = evaluateError(P.data(), Y, N);
+					else if(fft_interpolation) {
+						ScalarType sum_Q = .0;
+						std::vector<ScalarType> neg_f(N * no_dims);
+						computeFFTRepulsion(Y, N, neg_f.data(), &sum_Q);
+						C = evaluateEdgeError(row_P, col_P, val_P, Y, N, sum_Q);
+					}
 					else      C = evaluateError(row_P, col_P, val_P, Y, N, theta);  // doing approximate computation here!
 					tapkee::LoggingSingleton::instance().message_info(
 							formatting::format("Iteration {}: error is {}\n", iter, C));
@@ -262,6 +276,131 @@ public:
 		free(row_counts); row_counts  = NULL;
 	}
 
+	// Computes the repulsive forces and the normalization of a two dimensional
+	// map by interpolating the kernels 1/(1+d^2) and 1/(1+d^2)^2 with
+	// polynomials on an equispaced grid, where the sums over all points turn
+	// into convolutions done by FFT (Linderman et al., 2019, Fast
+	// interpolation-based t-SNE for improved visualization of single-cell
+	// RNA-seq data)
+	void computeFFTRepulsion(ScalarType* Y, int N, ScalarType* neg_f, ScalarType* sum_Q)
+	{
+		const int D = 2;
+		const int n_interpolation_points = 3;
+		const int min_num_intervals = 50;
+		const ScalarType intervals_per_integer = 1.0;
+
+		ScalarType min_coord = DBL_MAX;
+		ScalarType max_coord = -DBL_MAX;
+		for(int i = 0; i < N * D; i++) {
+			min_coord = std::min(min_coord, Y[i]);
+			max_coord = std::max(max_coord, Y[i]);
+		}
+
+		// Boxes of the grid, each with equispaced interpolation nodes
+		int n_boxes = std::max(min_num_intervals, (int) ceil((max_coord - min_coord) / intervals_per_integer));
+
+		// FFTs of sizes with large prime factors are slow
+		while(!isSmooth(n_boxes)) n_boxes++;
+		int n_nodes = n_boxes * n_interpolation_points;
+		ScalarType box_width = (max_coord > min_coord) ? (max_coord - min_coord) / n_boxes : 1.0;
+		ScalarType spacing = box_width / n_interpolation_points;
+
+		ScalarType nodes[n_interpolation_points];
+		ScalarType denominators[n_interpolation_points];
+		for(int k = 0; k < n_interpolation_points; k++) nodes[k] = (k + 0.5) / n_interpolation_points;
+		for(int k = 0; k < n_interpolation_points; k++) {
+			denominators[k] = 1.0;
+			for(int l = 0; l < n_interpolation_points; l++)
+				if(l != k) denominators[k] *= nodes[k] - nodes[l];
+		}
+
+		// Lagrange weights of every point on the nodes of its box
+		std::vector<int> first_node(N * D);
+		std::vector<ScalarType> weights(N * D * n_interpolation_points);
+#pragma omp parallel for
+		for(int i = 0; i < N * D; i++) {
+			ScalarType relative = (Y[i] - min_coord) / box_width;
+			int box = std::min((int) relative, n_boxes - 1);
+			ScalarType t = relative - box;
+			first_node[i] = box * n_interpolation_points;
+			for(int k = 0; k < n_interpolation_points; k++) {
+				ScalarType w = 1.0;
+				for(int l = 0; l < n_interpolation_points; l++)
+					if(l != k) w *= t - nodes[l];
+				weights[i * n_interpolation_points + k] = w / denominators[k];
+			}
+		}
+
+		// Charges 1 and y_1 + i y_2 on the grid
+		const int n_grids = 2;
+		int n_padded = 2 * n_nodes;
+		std::vector<std::vector<std::complex<ScalarType> > > grids(n_grids,
+				std::vector<std::complex<ScalarType> >(n_padded * n_padded));
+#pragma omp parallel for
+		for(int g = 0; g < n_grids; g++) {
+			std::vector<std::complex<ScalarType> >& grid = grids[g];
+			for(int n = 0; n < N; n++) {
+				std::complex<ScalarType> charge = (g == 0) ? 1.0 : std::complex<ScalarType>(Y[n * D], Y[n * D + 1]);
+				const ScalarType* wx = &weights[(n * D) * n_interpolation_points];
+				const ScalarType* wy = &weights[(n * D + 1) * n_interpolation_points];
+				for(int kx = 0; kx < n_interpolation_points; kx++)
+					for(int ky = 0; ky < n_interpolation_points; ky++)
+						grid[(first_node[n * D] + kx) * n_padded + first_node[n * D + 1] + ky] +=
+							charge * (wx[kx] * wy[ky]);
+			}
+		}
+
+		// Circulant embedding of the kernels evaluated on node offsets, both
+		// are real and even so the transform of q + i q^2 has the transform
+		// of q as real and the transform of q^2 as imaginary part
+		std::vector<std::complex<ScalarType> > kernels(n_padded * n_padded);
+#pragma omp parallel for
+		for(int a = 0; a < n_padded; a++) {
+			for(int b = 0; b < n_padded; b++) {
+				if(a == n_nodes || b == n_nodes) continue;
+				ScalarType dx = ((a < n_nodes) ? a : a - n_padded) * spacing;
+				ScalarType dy = ((b < n_nodes) ? b : b - n_padded) * spacing;
+				ScalarType q = 1.0 / (1.0 + dx * dx + dy * dy);
+				kernels[a * n_padded + b] = std::complex<ScalarType>(q, q * q);
+			}
+		}
+		fft2(kernels, n_padded, n_padded, false);
+
+		// The unit charges are convolved with q^2 + i q at once, y_1 and y_2
+		// with q^2
+#pragma omp parallel for
+		for(int g = 0; g < n_grids; g++) {
+			std::vector<std::complex<ScalarType> >& grid = grids[g];
+			fft2(grid, n_padded, n_nodes, false);
+			for(int i = 0; i < n_padded * n_padded; i++) {
+				if(g == 0) grid[i] *= std::complex<ScalarType>(kernels[i].imag(), kernels[i].real());
+				else grid[i] *= kernels[i].imag();
+			}
+			fft2(grid, n_padded, n_nodes, true);
+		}
+
+		// Interpolate potentials back to the points, the self-interaction of
+		// every point is 1 in both kernels
+		ScalarType sum = .0;
+#pragma omp parallel for reduction(+:sum)
+		for(int n = 0; n < N; n++) {
+			std::complex<ScalarType> potentials[n_grids];
+			const ScalarType* wx = &weights[(n * D) * n_interpolation_points];
+			const ScalarType* wy = &weights[(n * D + 1) * n_interpolation_points];
+			for(int kx = 0; kx < n_interpolation_points; kx++) {
+				for(int ky = 0; ky < n_interpolation_points; ky++) {
+					int index = (first_node[n * D] + kx) * n_padded + first_node[n * D + 1] + ky;
+					for(int g = 0; g < n_grids; g++)
+						potentials[g] += (wx[kx] * wy[ky]) * grids[g][index];
+				}
+			}
+			neg_f[n * D] = Y[n * D] * potentials[0].real() - potentials[1].real();
+			neg_f[n * D + 1] = Y[n * D + 1] * potentials[0].real() - potentials[1].imag();
+			sum += potentials[0].imag() - 1.0;
+		}
+		*sum_Q = sum;
+	}
+
 private:
 
 	void computeGradient(ScalarType* /*P*/, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC, ScalarType theta)
@@ -274,7 +413,8 @@ private:
 		ScalarType* pos_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
 		ScalarType* neg_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
 		if(pos_f == NULL || neg_f == NULL) { printf("Memory allocation failed!\n"); exit(1); }
-		tree->computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, N, pos_f);
+		QuadTree::computeEdgeForces(Y, inp_row_P, inp_col_P, inp_val_P, N, pos_f);
+#pragma omp parallel for reduction(+:sum_Q)
 		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, neg_f + n * D, &sum_Q);
 
 		// Compute final t-SNE gradient
@@ -286,6 +426,49 @@ private:
 		delete tree;
 	}
 
+	void computeFFTGradient(int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC)
+	{
+		std::vector<ScalarType> pos_f(N * D, .0);
+		std::vector<ScalarType> neg_f(N * D, .0);
+		ScalarType sum_Q = .0;
+		QuadTree::computeEdgeForces(Y, inp_row_P, inp_col_P, inp_val_P, N, pos_f.data());
+		computeFFTRepulsion(Y, N, neg_f.data(), &sum_Q);
+
+		// Compute final t-SNE gradient
+		for(int i = 0; i < N * D; i++) {
+			dC[i] = pos_f[i] - (neg_f[i] / sum_Q);
+		}
+	}
+
+	// Whether n has no prime factors other than 2, 3 and 5
+	static bool isSmooth(int n)
+	{
+		const int factors[] = {2, 3, 5};
+		for(int f = 0; f < 3; f++)
+			while(n % factors[f] == 0) n /= factors[f];
+		return n == 1;
+	}
+
+	// Two dimensional FFT of a square row-major array of which only the first
+	// rows are nonzero (forward) or needed (inverse)
+	static void fft2(std::vector<std::complex<ScalarType> >& data, int n, int n_rows, bool inverse)
+	{
+		Eigen::FFT<ScalarType> fft;
+		std::vector<std::complex<ScalarType> > in(n), out(n);
+		for(int pass = 0; pass < 2; pass++) {
+			bool rows = (pass == 0) != inverse;
+			int n_lines = rows ? n_rows : n;
+			int stride = rows ? 1 : n;
+			int step = rows ? n : 1;
+			for(int line = 0; line < n_lines; line++) {
+				for(int i = 0; i < n; i++) in[i] = data[line * step + i * stride];
+				if(inverse) fft.inv(out, in);
+				else fft.fwd(out, in);
+				for(int i = 0; i < n; i++) data[line * step + i * stride] = out[i];
+			}
+		}
+	}
+
 	void computeExactGradient(ScalarType* P, ScalarType* Y, int N, int D, ScalarType* dC)
 	{
 		// Make sure the current gradient contains zeros
@@ -366,14 +549,26 @@ private:
 		// Get estimate of normalization term
 		const int QT_NO_DIMS = 2;
 		QuadTree* tree = new QuadTree(Y, N);
-		ScalarType buff[QT_NO_DIMS] = {.0, .0};
 		ScalarType sum_Q = .0;
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, buff, &sum_Q);
+#pragma omp parallel for reduction(+:sum_Q)
+		for(int n = 0; n < N; n++) {
+			ScalarType buff[QT_NO_DIMS] = {.0, .0};
+			tree->computeNonEdgeForces(n, theta, buff, &sum_Q);
+		}
+		delete tree;
+		return evaluateEdgeError(row_P, col_P, val_P, Y, N, sum_Q);
+	}
 
+	ScalarType evaluateEdgeError(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType sum_Q)
+	{
 		// Loop over all edges to compute t-SNE error
-		int ind1, ind2;
-		ScalarType C = .0, Q;
+		const int QT_NO_DIMS = 2;
+		ScalarType C = .0;
+#pragma omp parallel for reduction(+:C)
 		for(int n = 0; n < N; n++) {
+			ScalarType buff[QT_NO_DIMS];
+			int ind1, ind2;
+			ScalarType Q;
 			ind1 = n * QT_NO_DIMS;
 			for(int i = row_P[n]; i < row_P[n + 1]; i++) {
 				Q = .0;
@@ -419,6 +614,7 @@ private:
 		computeSquaredEuclideanDistance(X, N, D, DD);
 
 		// Compute the Gaussian kernel row by row
+#pragma omp parallel for
 		for(int n = 0; n < N; n++) {
 
 			// Initialize some variables
@@ -490,8 +686,6 @@ private:
 		int* row_P = *_row_P;
 		int* col_P = *_col_P;
 		ScalarType* val_P = *_val_P;
-		ScalarType* cur_P = (ScalarType*) malloc((N - 1) * sizeof(ScalarType));
-		if(cur_P == NULL) { printf("Memory allocation failed!\n"); exit(1); }
 		row_P[0] = 0;
 		for(int n = 0; n < N; n++) row_P[n + 1] = row_P[n] + K;
 
@@ -501,10 +695,14 @@ private:
 		for(int n = 0; n < N; n++) obj_X[n] = DataPoint(D, n, X + n * D);
 		tree->create(obj_X);
 
-		// Loop over all points to find nearest neighbors
-		//printf("Building tree...\n");
+		// Loop over all points to find nearest neighbors, rows of P are
+		// independent and the tree is only read
+#pragma omp parallel
+		{
 		std::vector<DataPoint> indices;
 		std::vector<ScalarType> distances;
+		std::vector<ScalarType> cur_P(K);
+#pragma omp for schedule(dynamic, 64)
 		for(int n = 0; n < N; n++) {
 
 			//if(n % 10000 == 0) printf(" - point %d of %d\n", n, N);
@@ -568,10 +766,10 @@ private:
 				val_P[row_P[n] + m] = cur_P[m];
 			}
 		}
+		}
 
 		// Clean up memory
 		obj_X.clear();
-		free(cur_P);
 		delete tree;
 	}
 
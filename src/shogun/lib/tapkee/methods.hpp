@@ -110,7 +110,7 @@ public:
 		p_eigen_method(), p_neighbors_method(), p_eigenshift(), p_traceshift(),
 		p_check_connectivity(), p_n_neighbors(), p_width(), p_timesteps(),
 		p_ratio(), p_max_iteration(), p_tolerance(), p_n_updates(), p_perplexity(),
-		p_theta(), p_squishing_rate(), p_global_strategy(), p_epsilon(), p_target_dimension(),
+		p_theta(), p_fft_interpolation(), p_squishing_rate(), p_global_strategy(), p_epsilon(), p_target_dimension(),
 		n_vectors(0), current_dimension(0)
 	{
 		n_vectors = (end-begin);
@@ -139,6 +139,7 @@ public:
 		p_tolerance = parameters[spe_tolerance].checked().satisfies(Positivity<ScalarType>());
 		p_n_updates = parameters[spe_num_updates].checked().satisfies(Positivity<IndexType>());
 		p_theta = parameters[sne_theta].checked().satisfies(NonNegativity<ScalarType>());
+		p_fft_interpolation = parameters[sne_fft_interpolation];
 		p_squishing_rate = parameters[squishing_rate];
 		p_global_strategy = parameters[spe_global_strategy];
 		p_epsilon = parameters[fa_epsilon].checked().satisfies(NonNegativity<ScalarType>());
@@ -227,6 +228,7 @@ private:
 	Parameter p_n_updates;
 	Parameter p_perplexity;
 	Parameter p_theta;
+	Parameter p_fft_interpolation;
 	Parameter p_squishing_rate;
 	Parameter p_global_strategy;
 	Parameter p_epsilon;
@@ -355,37 +357,19 @@ private:
 		Neighbors neighbors = findNeighborsWith(plain_distance);
 		Landmarks landmarks =
 			select_landmarks_random(begin,end,p_ratio);
-		DenseMatrix distance_matrix =
-			compute_shortest_distances_matrix(begin,end,landmarks,neighbors,distance);
-		distance_matrix = distance_matrix.array().square();
-
-		DenseVector col_means = distance_matrix.colwise().mean();
-		DenseVector row_means = distance_matrix.rowwise().mean();
-		ScalarType grand_mean = distance_matrix.mean();
-		distance_matrix.array() += grand_mean;
-		distance_matrix.colwise() -= row_means;
-		distance_matrix.rowwise() -= col_means.transpose();
+		NeighborsGraph graph = neighbors_graph(begin,end,neighbors,distance);
+		DenseSymmetricMatrix distance_matrix =
+			compute_landmark_shortest_distances_matrix(graph,landmarks);
+		DenseVector landmark_distances_squared = distance_matrix.colwise().mean();
+		centerMatrix(distance_matrix);
 		distance_matrix.array() *= -0.5;
-
-		EigendecompositionResult landmarks_embedding;
-
-		if (p_eigen_method.is(Dense))
-		{
-			DenseMatrix distance_matrix_sym = distance_matrix*distance_matrix.transpose();
-			landmarks_embedding = eigendecomposition(p_eigen_method,p_computation_strategy,
-					LargestEigenvalues,distance_matrix_sym,p_target_dimension);
-		}
-		else
-		{
-			landmarks_embedding = eigendecomposition(p_eigen_method,p_computation_strategy,
-					SquaredLargestEigenvalues,distance_matrix,p_target_dimension);
-		}
-
-		DenseMatrix embedding = distance_matrix.transpose()*landmarks_embedding.first;
-
+		EigendecompositionResult landmarks_embedding =
+			eigendecomposition(p_eigen_method,p_computation_strategy,LargestEigenvalues,
+					distance_matrix,p_target_dimension);
 		for (IndexType i=0; i<static_cast<IndexType>(p_target_dimension); i++)
-			embedding.col(i).array() /= sqrt(sqrt(landmarks_embedding.second(i)));
-		return TapkeeOutput(embedding,unimplementedProjectingFunction());
+			landmarks_embedding.first.col(i).array() *= sqrt(landmarks_embedding.second(i));
+		return TapkeeOutput(triangulate_shortest_distances(graph,landmarks,
+			landmark_distances_squared,landmarks_embedding,p_target_dimension), unimplementedProjectingFunction());
 	}
 
 	TapkeeOutput embedNeighborhoodPreservingEmbedding()
@@ -524,13 +508,16 @@ private:
 	TapkeeOutput embedtDistributedStochasticNeighborEmbedding()
 	{
 		p_perplexity.checked().satisfies(InClosedRange<ScalarType>(0.0,(n_vectors-1)/3.0));
+		if (p_fft_interpolation.is(true))
+			p_target_dimension.checked().satisfies(InClosedRange<IndexType>(2,2));
 
 		DenseMatrix data =
 			dense_matrix_from_features(features, current_dimension, begin, end);
 
 		DenseMatrix embedding(static_cast<IndexType>(p_target_dimension),n_vectors);
 		tsne::TSNE tsne;
-		tsne.run(data,data.cols(),data.rows(),embedding.data(),p_target_dimension,p_perplexity,p_theta);
+		tsne.run(data,data.cols(),data.rows(),embedding.data(),p_target_dimension,p_perplexity,p_theta,
+		         p_fft_interpolation);
 
 		return TapkeeOutput(embedding.transpose(), unimplementedProjectingFunction());
 	}
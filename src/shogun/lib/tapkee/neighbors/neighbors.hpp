@@ -13,6 +13,7 @@
 #endif
 #include <shogun/lib/tapkee/neighbors/connected.hpp>
 #include <shogun/lib/tapkee/neighbors/vptree.hpp>
+#include <shogun/lib/tapkee/neighbors/nn_descent.hpp>
 /* End of Tapkee includes */
 
 #include <vector>
@@ -124,11 +125,14 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 	typedef std::pair<RandomAccessIterator, ScalarType> DistanceRecord;
 	typedef std::vector<DistanceRecord> Distances;
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
-	for (RandomAccessIterator iter=begin; iter!=end; ++iter)
+	const IndexType N = end-begin;
+	Neighbors neighbors(N);
+#pragma omp parallel for schedule(dynamic, 16)
+	for (IndexType i=0; i<N; i++)
 	{
+		RandomAccessIterator iter = begin+i;
 		Distances distances;
+		distances.reserve(N);
 		for (RandomAccessIterator around_iter=begin; around_iter!=end; ++around_iter)
 			distances.push_back(std::make_pair(around_iter, callback.distance(iter,around_iter)));
 
@@ -143,7 +147,9 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 			if (neighbors_iter->first != iter)
 				local_neighbors.push_back(neighbors_iter->first - begin);
 		}
-		neighbors.push_back(local_neighbors);
+		// the query point may tie with other points at distance zero
+		local_neighbors.resize(std::min(local_neighbors.size(), static_cast<size_t>(k)));
+		neighbors[i] = local_neighbors;
 	}
 	return neighbors;
 }
@@ -154,16 +160,24 @@ Neighbors find_neighbors_vptree_impl(const RandomAccessIterator& begin, const Ra
 {
 	timed_context context("VP-Tree based neighbors search");
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
+	const IndexType N = end-begin;
+	Neighbors neighbors(N);
 
 	VantagePointTree<RandomAccessIterator,Callback> tree(begin,end,callback);
 
-	for (RandomAccessIterator i=begin; i!=end; ++i)
+	// searches keep their state on the stack so queries run concurrently
+#pragma omp parallel for schedule(dynamic, 16)
+	for (IndexType i=0; i<N; i++)
 	{
-		LocalNeighbors local_neighbors = tree.search(i,k+1);
-		std::remove(local_neighbors.begin(),local_neighbors.end(),i-begin);
-		neighbors.push_back(local_neighbors);
+		// the results come farthest first, so if the query point is not
+		// among them (it ties with duplicates) the first one is dropped
+		LocalNeighbors local_neighbors = tree.search(begin+i,k+1);
+		LocalNeighbors::iterator query = std::find(local_neighbors.begin(),local_neighbors.end(),i);
+		if (query != local_neighbors.end())
+			local_neighbors.erase(query);
+		else
+			local_neighbors.erase(local_neighbors.begin());
+		neighbors[i] = local_neighbors;
 	}
 
 	return neighbors;
@@ -187,6 +201,8 @@ Neighbors find_neighbors(NeighborsMethod method, const RandomAccessIterator& beg
 		neighbors = find_neighbors_bruteforce_impl(begin,end,callback,k);
 	if (method.is(VpTree))
 		neighbors = find_neighbors_vptree_impl(begin,end,callback,k);
+	if (method.is(NnDescent))
+		neighbors = find_neighbors_nn_descent_impl(begin,end,callback,k);
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 	if (method.is(CoverTree))
 		neighbors = find_neighbors_covertree_impl(begin,end,callback,k);
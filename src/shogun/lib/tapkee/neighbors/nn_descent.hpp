@@ -0,0 +1,246 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef TAPKEE_NN_DESCENT_H_
+#define TAPKEE_NN_DESCENT_H_
+
+/* Tapkee includes */
+#include <shogun/lib/tapkee/defines.hpp>
+#include <shogun/lib/tapkee/utils/time.hpp>
+/* End of Tapkee includes */
+
+#include <vector>
+#include <mutex>
+#include <limits>
+#include <algorithm>
+
+namespace tapkee
+{
+namespace tapkee_internal
+{
+
+//! Bounded max-heaps of the k nearest neighbors found so far for each vector,
+//! the neighbors are flagged new until they took part in a local join
+class NeighborHeaps
+{
+public:
+	NeighborHeaps(IndexType n, IndexType k) :
+		n_neighbors(k), indices(n*k, n), distances(n*k, std::numeric_limits<ScalarType>::max()),
+		is_new(n*k, 0)
+	{
+	}
+
+	//! Inserts j as a neighbor of i unless it is already present or farther
+	//! away than all current neighbors of i.
+	//! @return whether the neighbors of i changed
+	bool push(IndexType i, IndexType j, ScalarType distance)
+	{
+		IndexType* heap_indices = &indices[i*n_neighbors];
+		ScalarType* heap_distances = &distances[i*n_neighbors];
+		char* heap_is_new = &is_new[i*n_neighbors];
+
+		if (distance >= heap_distances[0])
+			return false;
+		for (IndexType s=0; s<n_neighbors; s++)
+		{
+			if (heap_indices[s] == j)
+				return false;
+		}
+
+		// replace the farthest neighbor and sift it down
+		IndexType s = 0;
+		while (true)
+		{
+			IndexType left = 2*s+1;
+			IndexType right = left+1;
+			IndexType largest = s;
+			ScalarType largest_distance = distance;
+			if (left < n_neighbors && heap_distances[left] > largest_distance)
+			{
+				largest = left;
+				largest_distance = heap_distances[left];
+			}
+			if (right < n_neighbors && heap_distances[right] > largest_distance)
+				largest = right;
+			if (largest == s)
+				break;
+			heap_indices[s] = heap_indices[largest];
+			heap_distances[s] = heap_distances[largest];
+			heap_is_new[s] = heap_is_new[largest];
+			s = largest;
+		}
+		heap_indices[s] = j;
+		heap_distances[s] = distance;
+		heap_is_new[s] = 1;
+		return true;
+	}
+
+	IndexType n_neighbors;
+	std::vector<IndexType> indices;
+	std::vector<ScalarType> distances;
+	std::vector<char> is_new;
+};
+
+//! Adds j to the candidates unless there are enough already, in which case
+//! it replaces a uniformly chosen one so that all are kept with the same
+//! probability.
+inline void sample_candidate(std::vector<IndexType>& candidates, IndexType& n_seen,
+                             IndexType j, IndexType max_candidates)
+{
+	n_seen++;
+	if (static_cast<IndexType>(candidates.size()) < max_candidates)
+		candidates.push_back(j);
+	else
+	{
+		IndexType r = uniform_random_index_bounded(n_seen);
+		if (r < max_candidates)
+			candidates[r] = j;
+	}
+}
+
+//! Approximate k nearest neighbors graph by NN-descent: neighbors of
+//! neighbors are likely to be neighbors, so the graph is refined by local
+//! joins of the neighbors of every vector until few neighbors change.
+//! Local joins run in parallel, with a lock per vector guarding its heap.
+//!
+//! Dong, W., Moses, C., & Li, K. (2011).
+//! Efficient k-nearest neighbor graph construction for generic similarity measures.
+//! Proceedings of the 20th International Conference on World Wide Web, 577-586.
+//!
+template <class RandomAccessIterator, class Callback>
+Neighbors find_neighbors_nn_descent_impl(const RandomAccessIterator& begin, const RandomAccessIterator& end,
+                                         Callback callback, IndexType k)
+{
+	timed_context context("NN-descent based neighbors search");
+
+	const IndexType N = end-begin;
+	const int max_iterations = 20;
+	// stop when less than this fraction of neighbors changed in an iteration
+	const ScalarType termination_fraction = 0.001;
+
+	NeighborHeaps heaps(N,k);
+	std::vector<std::mutex> locks(N);
+
+	// random initial neighbors, drawn sequentially as the random
+	// number generator is shared
+	std::vector<IndexType> initial(N*k);
+	for (IndexType i=0; i<N; i++)
+	{
+		for (IndexType s=0; s<k; s++)
+		{
+			IndexType j;
+			do
+			{
+				j = uniform_random_index_bounded(N);
+			}
+			while (j == i || std::find(&initial[i*k], &initial[i*k]+s, j) != &initial[i*k]+s);
+			initial[i*k+s] = j;
+		}
+	}
+
+#pragma omp parallel for schedule(dynamic, 256)
+	for (IndexType i=0; i<N; i++)
+	{
+		for (IndexType s=0; s<k; s++)
+		{
+			IndexType j = initial[i*k+s];
+			heaps.push(i, j, callback.distance(begin+i, begin+j));
+		}
+	}
+
+	std::vector<std::vector<IndexType> > new_candidates(N);
+	std::vector<std::vector<IndexType> > old_candidates(N);
+	std::vector<IndexType> n_new_seen(N);
+	std::vector<IndexType> n_old_seen(N);
+
+	for (int iteration=0; iteration<max_iterations; iteration++)
+	{
+		// neighbors and reverse neighbors, at most k of each kind
+		for (IndexType i=0; i<N; i++)
+		{
+			new_candidates[i].clear();
+			old_candidates[i].clear();
+			n_new_seen[i] = 0;
+			n_old_seen[i] = 0;
+		}
+		for (IndexType i=0; i<N; i++)
+		{
+			for (IndexType s=0; s<k; s++)
+			{
+				IndexType j = heaps.indices[i*k+s];
+				if (j >= N)
+					continue;
+				if (heaps.is_new[i*k+s])
+				{
+					sample_candidate(new_candidates[i],n_new_seen[i],j,k);
+					sample_candidate(new_candidates[j],n_new_seen[j],i,k);
+					heaps.is_new[i*k+s] = 0;
+				}
+				else
+				{
+					sample_candidate(old_candidates[i],n_old_seen[i],j,k);
+					sample_candidate(old_candidates[j],n_old_seen[j],i,k);
+				}
+			}
+		}
+
+		// local joins compare new candidates with each other and with
+		// the old ones, old pairs were compared before
+		IndexType n_updates = 0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:n_updates)
+		for (IndexType i=0; i<N; i++)
+		{
+			const std::vector<IndexType>& new_i = new_candidates[i];
+			const std::vector<IndexType>& old_i = old_candidates[i];
+			for (size_t a=0; a<new_i.size(); a++)
+			{
+				for (size_t b=a+1; b<new_i.size()+old_i.size(); b++)
+				{
+					IndexType u = new_i[a];
+					IndexType v = (b < new_i.size()) ? new_i[b] : old_i[b-new_i.size()];
+					if (u == v)
+						continue;
+					ScalarType distance = callback.distance(begin+u, begin+v);
+					{
+						std::lock_guard<std::mutex> guard(locks[u]);
+						n_updates += heaps.push(u, v, distance);
+					}
+					{
+						std::lock_guard<std::mutex> guard(locks[v]);
+						n_updates += heaps.push(v, u, distance);
+					}
+				}
+			}
+		}
+
+		LoggingSingleton::instance().message_debug(
+			formatting::format("NN-descent iteration {}: {} updates", iteration, n_updates));
+		if (n_updates <= termination_fraction*N*k)
+			break;
+	}
+
+	Neighbors neighbors(N);
+	for (IndexType i=0; i<N; i++)
+	{
+		std::vector<std::pair<ScalarType,IndexType> > sorted;
+		sorted.reserve(k);
+		for (IndexType s=0; s<k; s++)
+		{
+			if (heaps.indices[i*k+s] < N)
+				sorted.push_back(std::make_pair(heaps.distances[i*k+s], heaps.indices[i*k+s]));
+		}
+		std::sort(sorted.begin(), sorted.end());
+
+		LocalNeighbors local_neighbors;
+		local_neighbors.reserve(sorted.size());
+		for (size_t s=0; s<sorted.size(); s++)
+			local_neighbors.push_back(sorted[s].second);
+		neighbors[i] = local_neighbors;
+	}
+	return neighbors;
+}
+
+}
+}
+
+#endif
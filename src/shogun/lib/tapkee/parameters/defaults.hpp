@@ -33,7 +33,8 @@ const stichwort::ParametersSet defaults = (
 	tapkee::cancel_function = stichwort::by_default,
 	tapkee::sne_perplexity = stichwort::by_default,
 	tapkee::squishing_rate = stichwort::by_default,
-	tapkee::sne_theta = stichwort::by_default);
+	tapkee::sne_theta = stichwort::by_default,
+	tapkee::sne_fft_interpolation = stichwort::by_default);
 }
 
 }
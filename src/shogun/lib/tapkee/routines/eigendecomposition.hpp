@@ -140,6 +140,162 @@ EigendecompositionResult eigendecomposition_impl_randomized(const MatrixType& wm
 	return EigendecompositionResult();
 }
 
+//! Returns the matrix with its diagonal decreased by the shift
+inline DenseMatrix shifted_matrix(const DenseMatrix& m, ScalarType shift)
+{
+	DenseMatrix shifted = m;
+	shifted.diagonal().array() -= shift;
+	return shifted;
+}
+
+//! Returns the sparse matrix with its diagonal decreased by the shift
+inline SparseWeightMatrix shifted_matrix(const SparseWeightMatrix& m, ScalarType shift)
+{
+	SparseWeightMatrix identity(m.rows(),m.cols());
+	identity.setIdentity();
+	return m - shift*identity;
+}
+
+//! Computes largest eigenvalues and associated eigenvectors of the
+//! symmetric operator by the Lanczos method. The basis is kept fully
+//! orthogonal and restarted with the best Ritz vectors whenever it
+//! reaches its maximal size (thick restart).
+//!
+//! @param operation operator applied to a single column
+//! @param n dimension of the operator
+//! @param n_wanted number of eigenpairs to compute
+//! @return eigenvectors and eigenvalues in ascending order
+//!
+template <class MatrixOperationType>
+EigendecompositionResult lanczos_largest(MatrixOperationType& operation, IndexType n, IndexType n_wanted)
+{
+	const IndexType basis_size = std::min(n, std::max(2*n_wanted+1, static_cast<IndexType>(20)));
+	const int max_restarts = 300;
+	const ScalarType tolerance = 1e-10;
+
+	DenseMatrix basis(n,basis_size);
+	DenseMatrix projected = DenseMatrix::Zero(basis_size,basis_size);
+	DenseVector residual(n);
+	DenseSelfAdjointEigenSolver solver;
+
+	for (IndexType i=0; i<n; i++)
+		residual(i) = tapkee::gaussian_random();
+	basis.col(0) = residual/residual.norm();
+
+	IndexType start = 0;
+	ScalarType beta = 0.0;
+	for (int restart=0; restart<=max_restarts; restart++)
+	{
+		for (IndexType j=start; j<basis_size; j++)
+		{
+			residual = operation(basis.col(j));
+			// orthogonalization is repeated once to keep the basis
+			// orthogonal to working precision
+			DenseVector h = basis.leftCols(j+1).transpose()*residual;
+			residual -= basis.leftCols(j+1)*h;
+			DenseVector correction = basis.leftCols(j+1).transpose()*residual;
+			residual -= basis.leftCols(j+1)*correction;
+			h += correction;
+
+			projected.col(j).head(j+1) = h;
+			projected.row(j).head(j+1) = h.transpose();
+			beta = residual.norm();
+
+			if (j+1 == basis_size)
+				break;
+			if (beta > tolerance*h.cwiseAbs().maxCoeff())
+			{
+				basis.col(j+1) = residual/beta;
+			}
+			else
+			{
+				// the basis spans an invariant subspace, continue with
+				// a random vector orthogonal to it
+				DenseVector random_vector(n);
+				for (IndexType i=0; i<n; i++)
+					random_vector(i) = tapkee::gaussian_random();
+				random_vector -= basis.leftCols(j+1)*(basis.leftCols(j+1).transpose()*random_vector);
+				random_vector -= basis.leftCols(j+1)*(basis.leftCols(j+1).transpose()*random_vector);
+				basis.col(j+1) = random_vector/random_vector.norm();
+			}
+		}
+
+		solver.compute(projected);
+		if (solver.info() != Eigen::Success)
+			throw eigendecomposition_error("eigendecomposition failed");
+
+		const DenseVector& ritz_values = solver.eigenvalues();
+		const DenseMatrix& ritz_vectors = solver.eigenvectors();
+		bool converged = (basis_size == n);
+		if (!converged)
+		{
+			ScalarType scale = ritz_values.cwiseAbs().maxCoeff();
+			converged = true;
+			for (IndexType i=basis_size-n_wanted; i<basis_size; i++)
+			{
+				if (std::abs(beta*ritz_vectors(basis_size-1,i)) > tolerance*scale)
+					converged = false;
+			}
+		}
+		if (converged || restart == max_restarts)
+		{
+			if (!converged)
+				LoggingSingleton::instance().message_warning("Lanczos method did not converge.");
+			else
+				LoggingSingleton::instance().message_info(formatting::format("Took {} restarts.", restart));
+			DenseMatrix selected_eigenvectors = basis*ritz_vectors.rightCols(n_wanted);
+			return EigendecompositionResult(selected_eigenvectors,ritz_values.tail(n_wanted));
+		}
+
+		// keep the best Ritz vectors and continue from the residual which
+		// couples to them through the last row of the Ritz vectors
+		IndexType n_kept = n_wanted + (basis_size-n_wanted)/2;
+		DenseMatrix kept = basis*ritz_vectors.rightCols(n_kept);
+		basis.leftCols(n_kept) = kept;
+		basis.col(n_kept) = residual/beta;
+		projected.setZero();
+		projected.topLeftCorner(n_kept,n_kept).diagonal() = ritz_values.tail(n_kept);
+		start = n_kept;
+	}
+	return EigendecompositionResult();
+}
+
+//! Lanczos implementation of eigendecomposition-based embedding. The
+//! matrix is only accessed through the matrix operation, smallest
+//! eigenvalues are found by shift-invert so that sparse weight matrices
+//! are factorized but never made dense.
+template <class MatrixType, class MatrixOperationType>
+EigendecompositionResult eigendecomposition_impl_lanczos(const MatrixType& wm, IndexType target_dimension, unsigned int skip)
+{
+	timed_context context("Lanczos eigendecomposition");
+
+	if (MatrixOperationType::largest)
+	{
+		assert(skip==0);
+		MatrixOperationType operation(wm);
+		return lanczos_largest(operation,wm.rows(),target_dimension);
+	}
+
+	// a small negative shift keeps the shifted matrix invertible when
+	// the weight matrix is positive semidefinite and singular
+	ScalarType shift = -1e-8*(1.0+wm.diagonal().cwiseAbs().maxCoeff());
+	MatrixType shifted = shifted_matrix(wm,shift);
+	MatrixOperationType operation(shifted);
+	EigendecompositionResult inverse_result = lanczos_largest(operation,wm.rows(),target_dimension+skip);
+
+	// largest eigenvalues of the inverse are the smallest ones of the
+	// matrix, in reverse order
+	DenseMatrix selected_eigenvectors(wm.rows(),target_dimension);
+	DenseVector selected_eigenvalues(target_dimension);
+	for (IndexType i=0; i<target_dimension; i++)
+	{
+		IndexType j = target_dimension-1-i;
+		selected_eigenvectors.col(i) = inverse_result.first.col(j);
+		selected_eigenvalues(i) = shift + 1.0/inverse_result.second(j);
+	}
+	return EigendecompositionResult(selected_eigenvectors,selected_eigenvalues);
+}
+
 template <typename MatrixType>
 struct eigendecomposition_impl
 {
@@ -154,6 +310,9 @@ struct eigendecomposition_impl
 	EigendecompositionResult randomized(const MatrixType& m, const ComputationStrategy& strategy,
                                         const EigendecompositionStrategy& eigen_strategy,
                                         IndexType target_dimension);
+	EigendecompositionResult lanczos(const MatrixType& m, const ComputationStrategy& strategy,
+                                     const EigendecompositionStrategy& eigen_strategy,
+                                     IndexType target_dimension);
 };
 
 template <>
@@ -245,6 +404,26 @@ struct eigendecomposition_impl<DenseMatrix>
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult lanczos(const DenseMatrix& m, const ComputationStrategy& strategy,
+                                     const EigendecompositionStrategy& eigen_strategy,
+                                     IndexType target_dimension)
+	{
+		if (strategy.is(HomogeneousCPUStrategy))
+		{
+			if (eigen_strategy.is(LargestEigenvalues))
+				return eigendecomposition_impl_lanczos<DenseMatrix,DenseMatrixOperation>
+					(m,target_dimension,eigen_strategy.skip());
+			if (eigen_strategy.is(SquaredLargestEigenvalues))
+				return eigendecomposition_impl_lanczos<DenseMatrix,DenseImplicitSquareMatrixOperation>
+					(m,target_dimension,eigen_strategy.skip());
+			if (eigen_strategy.is(SmallestEigenvalues))
+				return eigendecomposition_impl_lanczos<DenseMatrix,DenseInverseMatrixOperation>
+					(m,target_dimension,eigen_strategy.skip());
+			unsupported();
+		}
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -298,6 +477,20 @@ struct eigendecomposition_impl<SparseWeightMatrix>
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult lanczos(const SparseWeightMatrix& m, const ComputationStrategy& strategy,
+                                     const EigendecompositionStrategy& eigen_strategy,
+                                     IndexType target_dimension)
+	{
+		if (strategy.is(HomogeneousCPUStrategy))
+		{
+			if (eigen_strategy.is(SmallestEigenvalues))
+				return eigendecomposition_impl_lanczos<SparseWeightMatrix,SparseInverseMatrixOperation>
+					(m,target_dimension,eigen_strategy.skip());
+			unsupported();
+		}
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -318,12 +511,13 @@ struct eigendecomposition_impl<SparseWeightMatrix>
 //! implementation of operator()(DenseMatrix) which solves linear system with
 //! given right-hand side part.
 //!
-//! Currently supports three methods:
+//! Currently supports four methods:
 //!
 //! <ul>
 //! <li> Arpack
 //! <li> Randomized
 //! <li> Dense
+//! <li> Lanczos
 //! </ul>
 //!
 //! @param method one of supported eigendecomposition methods
@@ -347,6 +541,8 @@ EigendecompositionResult eigendecomposition(const EigenMethod& method, const Com
 		return eigendecomposition_impl<MatrixType>().randomized(m,strategy,eigen_strategy,target_dimension);
 	if (method.is(Dense))
 		return eigendecomposition_impl<MatrixType>().dense(m,strategy,eigen_strategy,target_dimension);
+	if (method.is(Lanczos))
+		return eigendecomposition_impl<MatrixType>().lanczos(m,strategy,eigen_strategy,target_dimension);
 	return EigendecompositionResult();
 }
 
@@ -11,6 +11,7 @@
 	#include <shogun/lib/tapkee/utils/arpack_wrapper.hpp>
 #endif
 #include <shogun/lib/tapkee/routines/matrix_operations.hpp>
+#include <shogun/lib/tapkee/routines/eigendecomposition.hpp>
 /* End of Tapkee includes */
 
 namespace tapkee
@@ -89,6 +90,10 @@ struct generalized_eigendecomposition_impl
                                    const ComputationStrategy& strategy,
                                    const EigendecompositionStrategy& eigen_strategy,
                                    IndexType target_dimension);
+	EigendecompositionResult lanczos(const LMatrixType& lhs, const RMatrixType& rhs,
+                                     const ComputationStrategy& strategy,
+                                     const EigendecompositionStrategy& eigen_strategy,
+                                     IndexType target_dimension);
 };
 
 template <>
@@ -128,6 +133,30 @@ struct generalized_eigendecomposition_impl<SparseWeightMatrix, DenseDiagonalMatr
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult lanczos(const SparseWeightMatrix& lhs, const DenseDiagonalMatrix& rhs,
+                                     const ComputationStrategy& strategy,
+                                     const EigendecompositionStrategy& eigen_strategy,
+                                     IndexType target_dimension)
+	{
+		if (strategy.is(HomogeneousCPUStrategy))
+		{
+			if (eigen_strategy.is(SmallestEigenvalues))
+			{
+				// with D^{-1/2} L D^{-1/2} y = lambda y the generalized
+				// eigenvectors are x = D^{-1/2} y, normalized as x'Dx = 1
+				DenseVector scaling = rhs.diagonal().cwiseSqrt().cwiseInverse();
+				SparseWeightMatrix normalized_lhs = scaling.asDiagonal()*lhs*scaling.asDiagonal();
+				EigendecompositionResult result = eigendecomposition_impl_lanczos
+					<SparseWeightMatrix,SparseInverseMatrixOperation>
+					(normalized_lhs,target_dimension,eigen_strategy.skip());
+				result.first = scaling.asDiagonal()*result.first;
+				return result;
+			}
+			unsupported();
+		}
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -171,6 +200,15 @@ struct generalized_eigendecomposition_impl<DenseMatrix, DenseMatrix>
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult lanczos(const DenseMatrix& lhs, const DenseMatrix& rhs,
+                                     const ComputationStrategy& strategy,
+                                     const EigendecompositionStrategy& eigen_strategy,
+                                     IndexType target_dimension)
+	{
+		// these eigenproblems are of the features dimension, small enough
+		// to be solved densely
+		return dense(lhs,rhs,strategy,eigen_strategy,target_dimension);
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -192,6 +230,9 @@ EigendecompositionResult generalized_eigendecomposition(const EigenMethod& metho
 	if (method.is(Dense))
 		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
 			.dense(lhs, rhs, strategy, eigen_strategy, target_dimension);
+	if (method.is(Lanczos))
+		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
+			.lanczos(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	if (method.is(Randomized))
 		throw unsupported_method_error("Randomized method is not supported for generalized eigenproblems");
 	return EigendecompositionResult();
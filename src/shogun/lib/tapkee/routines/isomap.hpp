@@ -8,29 +8,106 @@
 
 /* Tapkee includes */
 #include <shogun/lib/tapkee/defines.hpp>
-#include <shogun/lib/tapkee/utils/fibonacci_heap.hpp>
-#include <shogun/lib/tapkee/utils/reservable_priority_queue.hpp>
+#include <shogun/lib/tapkee/utils/radix_heap.hpp>
 #include <shogun/lib/tapkee/utils/time.hpp>
 /* End of Tapkee includes */
 
 #include <limits>
+#include <vector>
 
 namespace tapkee
 {
 namespace tapkee_internal
 {
 
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-typedef std::pair<IndexType,ScalarType> HeapElement;
-
-struct HeapElementComparator
+//! Neighborhood graph in the compressed sparse row layout with
+//! precomputed edge weights
+struct NeighborsGraph
 {
-	inline bool operator()(const HeapElement& l, const HeapElement& r) const
+	//! edges of i-th vector are in [offsets[i],offsets[i+1])
+	std::vector<IndexType> offsets;
+	//! targets of edges
+	std::vector<IndexType> targets;
+	//! lengths of edges
+	std::vector<ScalarType> weights;
+
+	inline IndexType n_vertices() const
 	{
-		return l.second > r.second;
+		return offsets.size()-1;
 	}
 };
-#endif
+
+//! Builds the neighborhood graph with edges from each vector to
+//! its neighbors weighted by distances.
+//!
+//! @param begin begin data iterator
+//! @param end end data iterator
+//! @param neighbors neighbors of each vector
+//! @param callback distance callback
+//!
+template <class RandomAccessIterator, class DistanceCallback>
+NeighborsGraph neighbors_graph(RandomAccessIterator begin, RandomAccessIterator end,
+		const Neighbors& neighbors, DistanceCallback callback)
+{
+	const IndexType N = end-begin;
+
+	NeighborsGraph graph;
+	graph.offsets.resize(N+1);
+	graph.offsets[0] = 0;
+	for (IndexType i=0; i<N; i++)
+		graph.offsets[i+1] = graph.offsets[i] + neighbors[i].size();
+	graph.targets.resize(graph.offsets[N]);
+	graph.weights.resize(graph.offsets[N]);
+
+#pragma omp parallel for schedule(dynamic, 256)
+	for (IndexType i=0; i<N; i++)
+	{
+		for (IndexType j=0; j<static_cast<IndexType>(neighbors[i].size()); j++)
+		{
+			IndexType w = neighbors[i][j];
+			graph.targets[graph.offsets[i]+j] = w;
+			graph.weights[graph.offsets[i]+j] = callback.distance(begin[i],begin[w]);
+		}
+	}
+	return graph;
+}
+
+//! Computes shortest distances from the source to all vertices
+//! using Dijkstra algorithm. Unreachable vertices are kept at
+//! maximal distance.
+//!
+//! @param graph neighborhood graph
+//! @param source source vertex
+//! @param distances storage for distances to each vertex
+//! @param heap scratch heap, empty on return
+//!
+inline void relax_shortest_distances(const NeighborsGraph& graph, IndexType source,
+		std::vector<ScalarType>& distances, radix_heap& heap)
+{
+	std::fill(distances.begin(),distances.end(),std::numeric_limits<ScalarType>::max());
+	distances[source] = 0.0;
+	heap.push(0.0,source);
+
+	while (!heap.empty())
+	{
+		ScalarType min_item_d;
+		IndexType min_item = heap.extract_min(min_item_d);
+		// vertices are pushed once per relaxation, skip outdated ones
+		if (min_item_d > distances[min_item])
+			continue;
+
+		for (IndexType e=graph.offsets[min_item]; e<graph.offsets[min_item+1]; e++)
+		{
+			IndexType w = graph.targets[e];
+			ScalarType dist = min_item_d + graph.weights[e];
+			if (dist < distances[w])
+			{
+				distances[w] = dist;
+				heap.push(dist,w);
+			}
+		}
+	}
+}
 
 //! Computes shortest distances (so-called geodesic distances)
 //! using Dijkstra algorithm.
@@ -45,225 +122,114 @@ DenseSymmetricMatrix compute_shortest_distances_matrix(RandomAccessIterator begi
 		Neighbors& neighbors, DistanceCallback callback)
 {
 	timed_context context("Distances shortest path relaxing");
-	const IndexType n_neighbors = neighbors[0].size();
 	const IndexType N = (end-begin);
 
+	NeighborsGraph graph = neighbors_graph(begin,end,neighbors,callback);
 	DenseSymmetricMatrix shortest_distances(N,N);
 
-#pragma omp parallel shared(shortest_distances,neighbors,begin,callback) default(none)
+#pragma omp parallel
 	{
-		bool* f = new bool[N];
-		bool* s = new bool[N];
-		IndexType k;
-
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-		reservable_priority_queue<HeapElement,HeapElementComparator> heap(N);
-#else
-		fibonacci_heap heap(N);
-#endif
+		std::vector<ScalarType> distances(N);
+		radix_heap heap;
 
-#pragma omp for nowait
-		for (k=0; k<N; k++)
+#pragma omp for schedule(dynamic, 16) nowait
+		for (IndexType k=0; k<N; k++)
 		{
-			// fill s and f with false, fill shortest_D with infinity
+			relax_shortest_distances(graph,k,distances,heap);
 			for (IndexType j=0; j<N; j++)
-			{
-				shortest_distances(k,j) = std::numeric_limits<DenseMatrix::Scalar>::max();
-				s[j] = false;
-				f[j] = false;
-			}
-			// set distance from k to k as zero
-			shortest_distances(k,k) = 0.0;
+				shortest_distances(k,j) = distances[j];
+		}
+	}
+	return shortest_distances;
+}
 
-			// insert kth object to heap with zero distance and set f[k] true
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-			HeapElement heap_element_of_self(k,0.0);
-			heap.push(heap_element_of_self);
-#else
-			heap.insert(k,0.0);
-#endif
-			f[k] = true;
+//! Computes squared shortest distances between landmarks using
+//! Dijkstra algorithm, symmetrized as the neighborhood graph is
+//! directed.
+//!
+//! @param graph neighborhood graph
+//! @param landmarks landmarks
+//!
+inline DenseSymmetricMatrix compute_landmark_shortest_distances_matrix(const NeighborsGraph& graph,
+		const Landmarks& landmarks)
+{
+	timed_context context("Landmarks shortest path relaxing");
+	const IndexType N = graph.n_vertices();
+	const IndexType N_landmarks = landmarks.size();
 
-			// while heap is not empty
-			while (!heap.empty())
-			{
-				// extract min and set (s)olution state as true and (f)rontier as false
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-				int min_item = heap.top().first;
-				ScalarType min_item_d = heap.top().second;
-				heap.pop();
-				if (min_item_d > shortest_distances(k,min_item))
-					continue;
-#else
-				ScalarType tmp;
-				int min_item = heap.extract_min(tmp);
-#endif
+	DenseMatrix squared_distances(N_landmarks,N_landmarks);
 
-				s[min_item] = true;
-				f[min_item] = false;
+#pragma omp parallel
+	{
+		std::vector<ScalarType> distances(N);
+		radix_heap heap;
 
-				// for-each edge (min_item->w)
-				for (IndexType i=0; i<n_neighbors; i++)
-				{
-					// get w idx
-					int w = neighbors[min_item][i];
-					// if w is not in solution yet
-					if (s[w] == false)
-					{
-						// get distance from k to i through min_item
-						ScalarType dist = shortest_distances(k,min_item) + callback.distance(begin[min_item],begin[w]);
-						// if distance can be relaxed
-						if (dist < shortest_distances(k,w))
-						{
-							// relax distance
-							shortest_distances(k,w) = dist;
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-							HeapElement relaxed_heap_element(w,dist);
-							heap.push(relaxed_heap_element);
-							f[w] = true;
-#else
-							// if w is in (f)rontier
-							if (f[w])
-							{
-								// decrease distance in heap
-								heap.decrease_key(w, dist);
-							}
-							else
-							{
-								// insert w to heap and set (f)rontier as true
-								heap.insert(w, dist);
-								f[w] = true;
-							}
-#endif
-						}
-					}
-				}
-			}
-			heap.clear();
+#pragma omp for schedule(dynamic, 1) nowait
+		for (IndexType k=0; k<N_landmarks; k++)
+		{
+			relax_shortest_distances(graph,landmarks[k],distances,heap);
+			for (IndexType l=0; l<N_landmarks; l++)
+				squared_distances(k,l) = distances[landmarks[l]]*distances[landmarks[l]];
 		}
-
-		delete[] s;
-		delete[] f;
 	}
-	return shortest_distances;
+	DenseSymmetricMatrix symmetric_distances = squared_distances + squared_distances.transpose();
+	symmetric_distances *= 0.5;
+	return symmetric_distances;
 }
 
-//! Computes shortest distances (so-called geodesic distances)
-//! using Dijkstra algorithm with landmarks.
+//! Places all vectors by distance-based triangulation against the
+//! landmarks embedded with multidimensional scaling. The embedding is
+//! linear in the squared geodesic distances to landmarks so shortest
+//! distances from each landmark are accumulated into it as soon as
+//! they are relaxed and never stored for all vectors.
 //!
-//! @param begin begin data iterator
-//! @param end end data iterator
+//! de Silva, V., & Tenenbaum, J. B. (2004).
+//! Sparse multidimensional scaling using landmark points.
+//! Technical report, Stanford University.
+//!
+//! @param graph neighborhood graph
 //! @param landmarks landmarks
-//! @param neighbors neighbors of each vector
-//! @param callback distance callback
+//! @param landmark_distances_squared mean squared distances from each landmark
+//!        to other landmarks
+//! @param landmarks_embedding eigendecomposition of the landmarks embedding
+//! @param target_dimension target dimension of embedding
 //!
-template <class RandomAccessIterator, class DistanceCallback>
-DenseMatrix compute_shortest_distances_matrix(RandomAccessIterator begin, RandomAccessIterator end,
-		Landmarks& landmarks, Neighbors& neighbors, DistanceCallback callback)
+inline DenseMatrix triangulate_shortest_distances(const NeighborsGraph& graph, const Landmarks& landmarks,
+		const DenseVector& landmark_distances_squared, EigendecompositionResult& landmarks_embedding,
+		IndexType target_dimension)
 {
-	timed_context context("Distances shortest path relaxing");
-	const IndexType n_neighbors = neighbors[0].size();
-	const IndexType N = end-begin;
+	timed_context context("Landmark triangulation");
+	const IndexType N = graph.n_vertices();
 	const IndexType N_landmarks = landmarks.size();
 
-	DenseMatrix shortest_distances(landmarks.size(),N);
+	// pseudoinverse transposed of the landmarks embedding
+	for (IndexType i=0; i<target_dimension; ++i)
+		landmarks_embedding.first.col(i).array() /= landmarks_embedding.second(i);
 
-#pragma omp parallel shared(shortest_distances,begin,landmarks,neighbors,callback) default(none)
-	{
-		bool* f = new bool[N];
-		bool* s = new bool[N];
-		IndexType k;
+	DenseMatrix embedding = DenseMatrix::Zero(target_dimension,N);
 
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-		reservable_priority_queue<HeapElement,HeapElementComparator> heap(N);
-#else
-		fibonacci_heap heap(N);
-#endif
+#pragma omp parallel
+	{
+		std::vector<ScalarType> distances(N);
+		radix_heap heap;
+		DenseMatrix local_embedding = DenseMatrix::Zero(target_dimension,N);
 
-#pragma omp for nowait
-		for (k=0; k<N_landmarks; k++)
+#pragma omp for schedule(dynamic, 1) nowait
+		for (IndexType k=0; k<N_landmarks; k++)
 		{
-			// fill s and f with false, fill shortest_D with infinity
+			relax_shortest_distances(graph,landmarks[k],distances,heap);
+			DenseVector coefficients = -0.5*landmarks_embedding.first.row(k).transpose();
 			for (IndexType j=0; j<N; j++)
 			{
-				shortest_distances(k,j) = std::numeric_limits<DenseMatrix::Scalar>::max();
-				s[j] = false;
-				f[j] = false;
+				ScalarType centered_distance = distances[j]*distances[j] - landmark_distances_squared(k);
+				local_embedding.col(j).noalias() += coefficients*centered_distance;
 			}
-			// set distance from k to k as zero
-			shortest_distances(k,landmarks[k]) = 0.0;
-
-			// insert kth object to heap with zero distance and set f[k] true
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-			HeapElement heap_element_of_self(landmarks[k],0.0);
-			heap.push(heap_element_of_self);
-#else
-			heap.insert(landmarks[k],0.0);
-#endif
-			f[k] = true;
-
-			// while heap is not empty
-			while (!heap.empty())
-			{
-				// extract min and set (s)olution state as true and (f)rontier as false
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-				int min_item = heap.top().first;
-				ScalarType min_item_d = heap.top().second;
-				heap.pop();
-				if (min_item_d > shortest_distances(k,min_item))
-					continue;
-#else
-				ScalarType tmp;
-				int min_item = heap.extract_min(tmp);
-#endif
-
-				s[min_item] = true;
-				f[min_item] = false;
-
-				// for-each edge (min_item->w)
-				for (IndexType i=0; i<n_neighbors; i++)
-				{
-					// get w idx
-					int w = neighbors[min_item][i];
-					// if w is not in solution yet
-					if (s[w] == false)
-					{
-						// get distance from k to i through min_item
-						ScalarType dist = shortest_distances(k,min_item) + callback.distance(begin[min_item],begin[w]);
-						// if distance can be relaxed
-						if (dist < shortest_distances(k,w))
-						{
-							// relax distance
-							shortest_distances(k,w) = dist;
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-							HeapElement relaxed_heap_element(w,dist);
-							heap.push(relaxed_heap_element);
-							f[w] = true;
-#else
-							// if w is in (f)rontier
-							if (f[w])
-							{
-								// decrease distance in heap
-								heap.decrease_key(w, dist);
-							}
-							else
-							{
-								// insert w to heap and set (f)rontier as true
-								heap.insert(w, dist);
-								f[w] = true;
-							}
-#endif
-						}
-					}
-				}
-			}
-			heap.clear();
 		}
 
-		delete[] s;
-		delete[] f;
+#pragma omp critical
+		embedding += local_embedding;
 	}
-	return shortest_distances;
+	return embedding.transpose();
 }
 
 }
@@ -87,6 +87,8 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 #else
 	tapkee::NeighborsMethod neighbors_method = tapkee::VpTree;
 #endif
+	if (parameters.approximate_neighbors)
+		neighbors_method = tapkee::NnDescent;
 	size_t N = 0;
 
 	switch (parameters.method)
@@ -158,6 +160,24 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 			break;
 	}
 
+#ifndef HAVE_ARPACK
+	// spectral methods only need a few eigenvectors, the Lanczos method
+	// finds them without the cubic dense eigendecomposition
+	switch (parameters.method)
+	{
+		case SHOGUN_KERNEL_LOCALLY_LINEAR_EMBEDDING:
+		case SHOGUN_LOCALLY_LINEAR_EMBEDDING:
+		case SHOGUN_LOCAL_TANGENT_SPACE_ALIGNMENT:
+		case SHOGUN_HESSIAN_LOCALLY_LINEAR_EMBEDDING:
+		case SHOGUN_LAPLACIAN_EIGENMAPS:
+		case SHOGUN_DIFFUSION_MAPS:
+			eigen_method = tapkee::Lanczos;
+			break;
+		default:
+			break;
+	}
+#endif
+
 	std::vector<int32_t> indices(N);
 	for (size_t i=0; i<N; i++)
 		indices[i] = i;
@@ -179,6 +199,7 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 		 tapkee::fa_epsilon = parameters.fa_epsilon,
 		 tapkee::sne_perplexity = parameters.sne_perplexity,
 		 tapkee::sne_theta = parameters.sne_theta,
+		 tapkee::sne_fft_interpolation = parameters.sne_fft_interpolation,
 		 tapkee::squishing_rate = parameters.squishing_rate
 		 );
 
@@ -44,18 +44,20 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN() :
 		method(SHOGUN_KERNEL_LOCALLY_LINEAR_EMBEDDING),
-		n_neighbors(10), n_timesteps(3),
+		n_neighbors(10), approximate_neighbors(false), n_timesteps(3),
 		target_dimension(2), spe_num_updates(100),
 		eigenshift(1e-9), landmark_ratio(0.5),
 		gaussian_kernel_width(1.0), spe_tolerance(1e-5),
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
-		sne_perplexity(30.0), squishing_rate(0.99),
+		sne_perplexity(30.0), sne_fft_interpolation(false),
+		squishing_rate(0.99),
 		kernel(NULL), distance(NULL), features(NULL)
 	{
 	}
 	TAPKEE_METHODS_FOR_SHOGUN method;
 	uint32_t n_neighbors;
+	bool approximate_neighbors;
 	uint32_t n_timesteps;
 	uint32_t target_dimension;
 	uint32_t spe_num_updates;
@@ -68,6 +70,7 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t fa_epsilon;
 	float64_t sne_theta;
 	float64_t sne_perplexity;
+	bool sne_fft_interpolation;
 	float64_t squishing_rate;
 	CKernel* kernel;
 	CDistance* distance;
@@ -0,0 +1,131 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef TAPKEE_RADIX_HEAP_H_
+#define TAPKEE_RADIX_HEAP_H_
+
+/* Tapkee includes */
+#include <shogun/lib/tapkee/defines.hpp>
+/* End of Tapkee includes */
+
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <stdint.h>
+
+namespace tapkee
+{
+namespace tapkee_internal
+{
+
+//! Monotone priority queue of non-negative keys as required by Dijkstra
+//! algorithm where extracted keys never decrease. Keys are bucketed by the
+//! highest bit in which they differ from the last extracted key so that
+//! each element is moved between buckets at most 64 times. Non-negative
+//! doubles compare as their bit patterns which are used as radix keys.
+//!
+//! Ahuja, R. K., Mehlhorn, K., Orlin, J., & Tarjan, R. E. (1990).
+//! Faster algorithms for the shortest path problem.
+//! Journal of the ACM, 37(2), 213-223.
+//!
+class radix_heap
+{
+public:
+	typedef std::pair<uint64_t,IndexType> Element;
+
+	radix_heap() : buckets(65), last(0), n_elements(0)
+	{
+	}
+
+	//! @return whether there are no elements
+	inline bool empty() const
+	{
+		return n_elements == 0;
+	}
+
+	//! Inserts value with the key, which should not be less than the
+	//! last extracted key
+	inline void push(ScalarType key, IndexType value)
+	{
+		uint64_t bits = to_bits(key);
+		buckets[bucket_index(bits)].push_back(Element(bits,value));
+		n_elements++;
+	}
+
+	//! Extracts a value with the minimal key
+	inline IndexType extract_min(ScalarType& key)
+	{
+		if (buckets[0].empty())
+		{
+			size_t i = 1;
+			while (buckets[i].empty())
+				i++;
+
+			uint64_t new_last = buckets[i][0].first;
+			for (size_t j=1; j<buckets[i].size(); j++)
+				new_last = std::min(new_last,buckets[i][j].first);
+			last = new_last;
+
+			// all elements of the bucket now agree with the last
+			// key on more bits and move to lower buckets
+			for (size_t j=0; j<buckets[i].size(); j++)
+				buckets[bucket_index(buckets[i][j].first)].push_back(buckets[i][j]);
+			buckets[i].clear();
+		}
+		Element element = buckets[0].back();
+		buckets[0].pop_back();
+		n_elements--;
+		key = from_bits(element.first);
+		return element.second;
+	}
+
+	//! Removes all elements keeping the memory allocated
+	inline void clear()
+	{
+		for (size_t i=0; i<buckets.size(); i++)
+			buckets[i].clear();
+		last = 0;
+		n_elements = 0;
+	}
+
+private:
+
+	inline size_t bucket_index(uint64_t bits) const
+	{
+		uint64_t difference = bits ^ last;
+		if (difference == 0)
+			return 0;
+#if defined(__GNUC__)
+		return 64 - __builtin_clzll(difference);
+#else
+		size_t index = 0;
+		for (; difference; difference >>= 1)
+			index++;
+		return index;
+#endif
+	}
+
+	static inline uint64_t to_bits(ScalarType key)
+	{
+		double value = static_cast<double>(key);
+		uint64_t bits;
+		std::memcpy(&bits,&value,sizeof(bits));
+		return bits;
+	}
+
+	static inline ScalarType from_bits(uint64_t bits)
+	{
+		double value;
+		std::memcpy(&value,&bits,sizeof(value));
+		return static_cast<ScalarType>(value);
+	}
+
+	std::vector<std::vector<Element> > buckets;
+	uint64_t last;
+	IndexType n_elements;
+};
+
+}
+}
+
+#endif
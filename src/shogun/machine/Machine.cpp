@@ -14,7 +14,7 @@ using namespace shogun;
 
 CMachine::CMachine()
     : CStoppableSGObject(), m_max_train_time(0), m_labels(NULL),
-      m_solver_type(ST_AUTO)
+      m_solver_type(ST_AUTO), m_warm_start(false)
 {
 	SG_ADD(&m_max_train_time, "max_train_time", "Maximum training time.");
 	SG_ADD(&m_labels, "labels", "Labels to be used.");
@@ -24,6 +24,10 @@ CMachine::CMachine()
 	    SG_OPTIONS(
 	        ST_AUTO, ST_CPLEX, ST_GLPK, ST_NEWTON, ST_DIRECT, ST_ELASTICNET,
 	        ST_BLOCK_NORM));
+	SG_ADD(
+	    &m_warm_start, "warm_start",
+	    "Whether training starts from the current model.",
+	    ParameterProperties::SETTING);
 }
 
 CMachine::~CMachine()
@@ -113,6 +117,16 @@ ESolverType CMachine::get_solver_type()
 	return m_solver_type;
 }
 
+void CMachine::set_warm_start(bool warm_start)
+{
+	m_warm_start = warm_start;
+}
+
+bool CMachine::get_warm_start() const
+{
+	return m_warm_start;
+}
+
 CLabels* CMachine::apply(CFeatures* data)
 {
 	SG_DEBUG("entering %s::apply(%s at %p)\n",
@@ -197,6 +197,18 @@ class CMachine : public CStoppableSGObject
 		 */
 		float64_t get_max_train_time();
 
+		/** Sets whether training starts from the current model instead of
+		 * from scratch. Machines that do not support this ignore it. Useful
+		 * when training on the same data repeatedly with slightly different
+		 * hyperparameters, e.g. along a regularization path.
+		 *
+		 * @param warm_start whether to warm start training
+		 */
+		void set_warm_start(bool warm_start);
+
+		/** @return whether training starts from the current model */
+		bool get_warm_start() const;
+
 		/** get classifier type
 		 *
 		 * @return classifier type NONE
@@ -317,6 +329,9 @@ class CMachine : public CStoppableSGObject
 
 		/** solver type */
 		ESolverType m_solver_type;
+
+		/** whether training starts from the current model */
+		bool m_warm_start;
 };
 }
 #endif // _MACHINE_H__
@@ -8,6 +8,8 @@
 
 #include <shogun/machine/OnlineLinearMachine.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/features/streaming/StreamingSparseFeatures.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -17,12 +19,16 @@
 using namespace shogun;
 
 COnlineLinearMachine::COnlineLinearMachine()
-: CMachine(), bias(0), features(NULL)
+: CMachine(), bias(0), features(NULL), m_batch_size(1), m_hogwild(true)
 {
 	SG_ADD(&m_w, "m_w", "Parameter vector w.", ParameterProperties::MODEL);
 	SG_ADD(&bias, "bias", "Bias b.", ParameterProperties::MODEL);
 	SG_ADD((CSGObject**) &features, "features",
 	    "Feature object.");
+	SG_ADD(&m_batch_size, "batch_size",
+	    "Number of examples trained on in parallel.");
+	SG_ADD(&m_hogwild, "hogwild",
+	    "Whether examples of a batch update w concurrently.");
 }
 
 COnlineLinearMachine::~COnlineLinearMachine()
@@ -93,10 +99,19 @@ bool COnlineLinearMachine::train_machine(CFeatures *data)
 	}
 	start_train();
 	features->start_parser();
-	while (features->get_next_example())
+	if (m_batch_size>1)
 	{
-		train_example(features, features->get_label());
-		features->release_example();
+		SExampleBatch batch;
+		while (read_example_batch(batch, m_batch_size))
+			train_batch(batch);
+	}
+	else
+	{
+		while (features->get_next_example())
+		{
+			train_example(features, features->get_label());
+			features->release_example();
+		}
 	}
 
 	features->end_parser();
@@ -104,3 +119,75 @@ bool COnlineLinearMachine::train_machine(CFeatures *data)
 
 	return true;
 }
+
+void COnlineLinearMachine::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size>0, "Batch size (%d) must be positive\n", batch_size)
+	m_batch_size=batch_size;
+}
+
+int32_t COnlineLinearMachine::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void COnlineLinearMachine::set_hogwild(bool hogwild)
+{
+	m_hogwild=hogwild;
+}
+
+bool COnlineLinearMachine::get_hogwild() const
+{
+	return m_hogwild;
+}
+
+bool COnlineLinearMachine::read_example_batch(SExampleBatch& batch, int32_t batch_size)
+{
+	batch.offsets.assign(1, 0);
+	batch.indices.clear();
+	batch.values.clear();
+	batch.labels.clear();
+
+	while (batch.size()<batch_size && features->get_next_example())
+	{
+		features->expand_if_required(m_w.vector, m_w.vlen);
+
+		if (features->get_feature_class()==C_STREAMING_DENSE)
+		{
+			CStreamingDenseFeatures<float32_t>* feat=
+				dynamic_cast<CStreamingDenseFeatures<float32_t>*>(features);
+			REQUIRE(feat, "Expected streaming dense features of float32_t\n")
+
+			SGVector<float32_t> vec=feat->get_vector();
+			for (index_t j=0; j<vec.vlen; j++)
+			{
+				if (vec[j]!=0)
+				{
+					batch.indices.push_back(j);
+					batch.values.push_back(vec[j]);
+				}
+			}
+		}
+		else if (features->get_feature_class()==C_STREAMING_SPARSE)
+		{
+			CStreamingSparseFeatures<float32_t>* feat=
+				dynamic_cast<CStreamingSparseFeatures<float32_t>*>(features);
+			REQUIRE(feat, "Expected streaming sparse features of float32_t\n")
+
+			SGSparseVector<float32_t> vec=feat->get_vector();
+			for (index_t j=0; j<vec.num_feat_entries; j++)
+			{
+				batch.indices.push_back(vec.features[j].feat_index);
+				batch.values.push_back(vec.features[j].entry);
+			}
+		}
+		else
+			SG_ERROR("Training on batches requires dense or sparse streaming features\n")
+
+		batch.labels.push_back(features->get_label());
+		batch.offsets.push_back(batch.indices.size());
+		features->release_example();
+	}
+
+	return batch.size()>0;
+}
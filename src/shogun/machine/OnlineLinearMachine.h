@@ -15,6 +15,8 @@
 #include <shogun/features/streaming/StreamingDotFeatures.h>
 #include <shogun/machine/Machine.h>
 
+#include <vector>
+
 
 namespace shogun
 {
@@ -22,6 +24,64 @@ class CBinaryLabels;
 class CFeatures;
 class CRegressionLabels;
 
+/** examples read from streaming features to be trained on together,
+ * stored as sparse vectors in the compressed sparse row layout
+ */
+struct SExampleBatch
+{
+	/** entries of i-th example are in [offsets[i],offsets[i+1]) */
+	std::vector<int64_t> offsets;
+	/** feature indices of entries */
+	std::vector<int32_t> indices;
+	/** feature values of entries */
+	std::vector<float32_t> values;
+	/** labels of examples */
+	std::vector<float64_t> labels;
+
+	/** @return number of examples */
+	int32_t size() const
+	{
+		return labels.size();
+	}
+
+	/** dot product of an example with a dense vector
+	 *
+	 * @param i index of example
+	 * @param w dense vector
+	 * @return dot product
+	 */
+	float64_t dense_dot(int32_t i, const float32_t* w) const
+	{
+		float64_t result=0;
+		for (int64_t k=offsets[i]; k<offsets[i+1]; k++)
+			result+=w[indices[k]]*values[k];
+		return result;
+	}
+
+	/** adds a scaled example to a dense vector
+	 *
+	 * @param i index of example
+	 * @param alpha scalar to multiply with
+	 * @param w dense vector
+	 */
+	void add_to_dense_vec(int32_t i, float64_t alpha, float32_t* w) const
+	{
+		for (int64_t k=offsets[i]; k<offsets[i+1]; k++)
+			w[indices[k]]+=alpha*values[k];
+	}
+
+	/** @param i index of example
+	 * @return squared norm of example
+	 */
+	float64_t squared_norm(int32_t i) const
+	{
+		float64_t result=0;
+		for (int64_t k=offsets[i]; k<offsets[i+1]; k++)
+			result+=values[k]*values[k];
+		return result;
+	}
+};
+
 /** @brief Class OnlineLinearMachine is a generic interface for linear
  * machines like classifiers which work through online algorithms.
  *
@@ -47,6 +107,16 @@ class CRegressionLabels;
  *		f({\bf x})= {\bf w} \cdot \Phi({\bf x}) + b.
  *	\f]
  *
+ * Machines that implement train_batch() can read batches of examples from
+ * dense or sparse streaming features of float32_t and train on the examples
+ * of a batch in parallel, see set_batch_size(). With Hogwild updates, the
+ * examples update w concurrently without any locking, otherwise the updates
+ * of all examples of a batch are computed for the same w and added
+ * afterwards.
+ *
+ * Niu, F., Recht, B., Re, C., & Wright, S. J. (2011).
+ * Hogwild!: A lock-free approach to parallelizing stochastic gradient
+ * descent. Advances in Neural Information Processing Systems 24.
  * */
 class COnlineLinearMachine : public CMachine
 {
@@ -205,6 +275,33 @@ class COnlineLinearMachine : public CMachine
 		 */
 		virtual void train_example(CStreamingDotFeatures *feature, float64_t label) { SG_NOTIMPLEMENTED }
 
+		/** train on a batch of examples, used instead of train_example()
+		 * if the batch size is larger than one
+		 *
+		 * @param batch examples and their labels
+		 */
+		virtual void train_batch(const SExampleBatch& batch) { SG_NOTIMPLEMENTED }
+
+		/** set number of examples that are read from the stream and
+		 * trained on in parallel, one trains on each example in turn
+		 *
+		 * @param batch_size number of examples per batch
+		 */
+		void set_batch_size(int32_t batch_size);
+
+		/** @return number of examples per batch */
+		int32_t get_batch_size() const;
+
+		/** set whether examples of a batch update w concurrently
+		 * (Hogwild), or their updates are added after the batch
+		 *
+		 * @param hogwild whether to use Hogwild updates
+		 */
+		void set_hogwild(bool hogwild);
+
+		/** @return whether Hogwild updates are used */
+		bool get_hogwild() const;
+
 		/** whether train require labels */
 		virtual bool train_require_labels() const
 		{
@@ -229,6 +326,15 @@ class COnlineLinearMachine : public CMachine
 		 */
 		SGVector<float64_t> apply_get_outputs(CFeatures* data);
 
+		/** read the next examples from the features, expanding w to
+		 * their dimension
+		 *
+		 * @param batch batch to read examples into
+		 * @param batch_size maximum number of examples
+		 * @return whether any example was read
+		 */
+		bool read_example_batch(SExampleBatch& batch, int32_t batch_size);
+
 	protected:
 		/** w */
 		SGVector<float32_t> m_w;
@@ -236,6 +342,12 @@ class COnlineLinearMachine : public CMachine
 		float32_t bias;
 		/** features */
 		CStreamingDotFeatures* features;
+
+		/** number of examples per batch */
+		int32_t m_batch_size;
+
+		/** whether examples of a batch update w concurrently */
+		bool m_hogwild;
 };
 }
 #endif
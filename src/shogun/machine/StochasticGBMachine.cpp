@@ -37,6 +37,15 @@
 
 using namespace shogun;
 
+// minimal number of labels in a shard of the loss minimized by lbfgs
+static const int32_t labels_per_shard=1024;
+
+// first label of a shard when splitting len labels into num_shards
+static inline int32_t shard_begin(int32_t len, int32_t shard, int32_t num_shards)
+{
+	return int64_t(len)*shard/num_shards;
+}
+
 CStochasticGBMachine::CStochasticGBMachine(CMachine* machine, CLossFunction* loss, int32_t num_iterations,
 						float64_t learning_rate, float64_t subset_fraction)
 : RandomMixin<CMachine>()
@@ -309,14 +318,27 @@ float64_t CStochasticGBMachine::get_gamma(void* instance)
 	lbfgs_parameter_init(&lbfgs_param);
 	lbfgs_param.linesearch=2;
 
+	// losses over labels are summed up in parallel shards
+	CDynamicObjectArray* objects=static_cast<CDynamicObjectArray*>(instance);
+	CLabels* labels=dynamic_cast<CLabels*>(objects->get_element(0));
+	REQUIRE(labels,"0 index element of objects is NULL\n")
+	int32_t num_shards=CMath::max(1,labels->get_num_labels()/labels_per_shard);
+	SG_UNREF(labels);
+
 	float64_t gamma=0;
-	lbfgs(1,&gamma,NULL,CStochasticGBMachine::lbfgs_evaluate,NULL,instance,&lbfgs_param);
+	lbfgs_sharded(1,&gamma,NULL,CStochasticGBMachine::lbfgs_evaluate_shard,num_shards,NULL,instance,&lbfgs_param);
 
 	return gamma;
 }
 
 float64_t CStochasticGBMachine::lbfgs_evaluate(void *obj, const float64_t *parameters, float64_t *gradient, const int dim,
 												const float64_t step)
+{
+	return lbfgs_evaluate_shard(obj,parameters,gradient,dim,step,0,1);
+}
+
+float64_t CStochasticGBMachine::lbfgs_evaluate_shard(void *obj, const float64_t *parameters, float64_t *gradient,
+		const int dim, const float64_t step, const int shard, const int num_shards)
 {
 	REQUIRE(obj,"object cannot be NULL\n")
 	CDynamicObjectArray* objects=static_cast<CDynamicObjectArray*>(obj);
@@ -338,7 +360,7 @@ float64_t CStochasticGBMachine::lbfgs_evaluate(void *obj, const float64_t *param
 
 		*gradient=0;
 		float64_t ret=0;
-		for (int32_t i=0;i<labels.vlen;i++)
+		for (int32_t i=shard_begin(labels.vlen,shard,num_shards);i<shard_begin(labels.vlen,shard+1,num_shards);i++)
 		{
 			*gradient+=lossf->first_derivative((*parameters),labels[i]);
 			ret+=lossf->loss((*parameters),labels[i]);
@@ -374,7 +396,7 @@ float64_t CStochasticGBMachine::lbfgs_evaluate(void *obj, const float64_t *param
 
 	*gradient=0;
 	float64_t ret=0;
-	for (int32_t i=0;i<labels.vlen;i++)
+	for (int32_t i=shard_begin(labels.vlen,shard,num_shards);i<shard_begin(labels.vlen,shard+1,num_shards);i++)
 	{
 		*gradient+=lossf->first_derivative((*parameters)*hm[i]+f[i],labels[i]);
 		ret+=lossf->loss((*parameters)*hm[i]+f[i],labels[i]);
@@ -208,6 +208,19 @@ protected:
 	 */
 	static float64_t lbfgs_evaluate(void *obj, const float64_t *parameters, float64_t *gradient, const int dim, const float64_t step);
 
+	/** call-back evaluate method for lbfgs over a shard of labels
+	 *
+	 * @param obj object parameters required for loss calculation
+	 * @param parameters current state of variables of target function
+	 * @param gradient stores gradient computed by this method
+	 * @param dim dimensions
+	 * @param step step in linesearch
+	 * @param shard index of the shard
+	 * @param num_shards number of shards
+	 */
+	static float64_t lbfgs_evaluate_shard(void *obj, const float64_t *parameters, float64_t *gradient, const int dim,
+			const float64_t step, const int shard, const int num_shards);
+
 	/** initialize */
 	void init();
 
@@ -917,7 +917,8 @@ class CMath : public CSGObject
 		template <class T>
 			static void radix_sort_helper(T* array, int32_t size, uint16_t i)
 			{
-				static size_t count[256], nc, cmin;
+				/* per thread, such that strings can be sorted concurrently */
+				static thread_local size_t count[256], nc, cmin;
 				T *ak;
 				uint8_t c=0;
 				radix_stack_t<T> s[RADIX_STACK_SIZE], *sp, *olds, *bigs;
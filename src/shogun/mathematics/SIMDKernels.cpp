@@ -0,0 +1,440 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/lib/cpu.h>
+#include <shogun/mathematics/SIMDKernels.h>
+
+#if defined(HAVE_SSE2) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace shogun
+{
+namespace simd
+{
+#ifdef SIMD_KERNELS_X86
+	/* kernels are compiled for the instruction set extensions with target
+	 * attributes, so that the library runs on any x86 CPU and picks them
+	 * at runtime */
+#define SIMD_AVX2 __attribute__((target("avx2,fma")))
+#define SIMD_AVX512 __attribute__((target("avx2,fma,avx512f,avx512cd")))
+
+	SIMD_AVX2 static inline float64_t horizontal_sum(__m256d v)
+	{
+		__m128d sum = _mm_add_pd(
+		    _mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+	}
+
+	/* loads 4 feature indices, strided ones are gathered */
+	SIMD_AVX2 static inline __m128i
+	load_indices_avx2(const index_t* indices, int32_t stride, __m128i offsets)
+	{
+		if (stride == 1)
+			return _mm_loadu_si128((const __m128i*)indices);
+		return _mm_i32gather_epi32(indices, offsets, sizeof(index_t));
+	}
+
+	SIMD_AVX2 static inline __m256d
+	load_values_avx2(const float64_t* values, int32_t stride, __m128i offsets)
+	{
+		if (stride == 1)
+			return _mm256_loadu_pd(values);
+		return _mm256_i32gather_pd(values, offsets, sizeof(float64_t));
+	}
+
+	SIMD_AVX2 static inline __m256d
+	load_values_avx2(const float32_t* values, int32_t stride, __m128i offsets)
+	{
+		if (stride == 1)
+			return _mm256_cvtps_pd(_mm_loadu_ps(values));
+		return _mm256_cvtps_pd(
+		    _mm_i32gather_ps(values, offsets, sizeof(float32_t)));
+	}
+
+	template <class T>
+	SIMD_AVX2 static float64_t sparse_dot_avx2(
+	    const index_t* indices, int32_t index_stride, const T* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense)
+	{
+		const __m128i index_offsets = _mm_setr_epi32(
+		    0, index_stride, 2 * index_stride, 3 * index_stride);
+		const __m128i value_offsets = _mm_setr_epi32(
+		    0, value_stride, 2 * value_stride, 3 * value_stride);
+
+		/* two accumulators hide the latency of fused multiply-adds */
+		__m256d acc0 = _mm256_setzero_pd();
+		__m256d acc1 = _mm256_setzero_pd();
+		int64_t k = 0;
+		for (; k + 8 <= nnz; k += 8)
+		{
+			__m128i idx0 = load_indices_avx2(
+			    indices + k * index_stride, index_stride, index_offsets);
+			__m128i idx1 = load_indices_avx2(
+			    indices + (k + 4) * index_stride, index_stride, index_offsets);
+			__m256d v0 = load_values_avx2(
+			    values + k * value_stride, value_stride, value_offsets);
+			__m256d v1 = load_values_avx2(
+			    values + (k + 4) * value_stride, value_stride, value_offsets);
+			acc0 = _mm256_fmadd_pd(
+			    v0, _mm256_i32gather_pd(dense, idx0, sizeof(float64_t)), acc0);
+			acc1 = _mm256_fmadd_pd(
+			    v1, _mm256_i32gather_pd(dense, idx1, sizeof(float64_t)), acc1);
+		}
+		for (; k + 4 <= nnz; k += 4)
+		{
+			__m128i idx = load_indices_avx2(
+			    indices + k * index_stride, index_stride, index_offsets);
+			__m256d v = load_values_avx2(
+			    values + k * value_stride, value_stride, value_offsets);
+			acc0 = _mm256_fmadd_pd(
+			    v, _mm256_i32gather_pd(dense, idx, sizeof(float64_t)), acc0);
+		}
+
+		float64_t result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+		for (; k < nnz; k++)
+			result += dense[indices[k * index_stride]] * values[k * value_stride];
+		return result;
+	}
+
+	/* loads 8 feature indices, strided ones are gathered */
+	SIMD_AVX512 static inline __m256i
+	load_indices_avx512(const index_t* indices, int32_t stride, __m256i offsets)
+	{
+		if (stride == 1)
+			return _mm256_loadu_si256((const __m256i*)indices);
+		return _mm256_i32gather_epi32(indices, offsets, sizeof(index_t));
+	}
+
+	SIMD_AVX512 static inline __m512d
+	load_values_avx512(const float64_t* values, int32_t stride, __m256i offsets)
+	{
+		if (stride == 1)
+			return _mm512_loadu_pd(values);
+		return _mm512_i32gather_pd(offsets, values, sizeof(float64_t));
+	}
+
+	SIMD_AVX512 static inline __m512d
+	load_values_avx512(const float32_t* values, int32_t stride, __m256i offsets)
+	{
+		if (stride == 1)
+			return _mm512_cvtps_pd(_mm256_loadu_ps(values));
+		return _mm512_cvtps_pd(
+		    _mm256_i32gather_ps(values, offsets, sizeof(float32_t)));
+	}
+
+	SIMD_AVX512 static inline __m256i strided_offsets_avx512(int32_t stride)
+	{
+		return _mm256_mullo_epi32(
+		    _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+		    _mm256_set1_epi32(stride));
+	}
+
+	template <class T>
+	SIMD_AVX512 static float64_t sparse_dot_avx512(
+	    const index_t* indices, int32_t index_stride, const T* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense)
+	{
+		const __m256i index_offsets = strided_offsets_avx512(index_stride);
+		const __m256i value_offsets = strided_offsets_avx512(value_stride);
+
+		__m512d acc0 = _mm512_setzero_pd();
+		__m512d acc1 = _mm512_setzero_pd();
+		int64_t k = 0;
+		for (; k + 16 <= nnz; k += 16)
+		{
+			__m256i idx0 = load_indices_avx512(
+			    indices + k * index_stride, index_stride, index_offsets);
+			__m256i idx1 = load_indices_avx512(
+			    indices + (k + 8) * index_stride, index_stride, index_offsets);
+			__m512d v0 = load_values_avx512(
+			    values + k * value_stride, value_stride, value_offsets);
+			__m512d v1 = load_values_avx512(
+			    values + (k + 8) * value_stride, value_stride, value_offsets);
+			acc0 = _mm512_fmadd_pd(
+			    v0, _mm512_i32gather_pd(idx0, dense, sizeof(float64_t)), acc0);
+			acc1 = _mm512_fmadd_pd(
+			    v1, _mm512_i32gather_pd(idx1, dense, sizeof(float64_t)), acc1);
+		}
+		for (; k + 8 <= nnz; k += 8)
+		{
+			__m256i idx = load_indices_avx512(
+			    indices + k * index_stride, index_stride, index_offsets);
+			__m512d v = load_values_avx512(
+			    values + k * value_stride, value_stride, value_offsets);
+			acc0 = _mm512_fmadd_pd(
+			    v, _mm512_i32gather_pd(idx, dense, sizeof(float64_t)), acc0);
+		}
+
+		float64_t result = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+		for (; k < nnz; k++)
+			result += dense[indices[k * index_stride]] * values[k * value_stride];
+		return result;
+	}
+
+	/* AVX2 has no scatters, so only AVX-512 is used to add onto the dense
+	 * vector. Lanes with equal feature indices would lose all but one
+	 * addition in a scatter, so such blocks are added sequentially. */
+	template <class T>
+	SIMD_AVX512 static void sparse_axpy_avx512(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const T* values, int32_t value_stride, int64_t nnz, float64_t* dense)
+	{
+		const __m256i index_offsets = strided_offsets_avx512(index_stride);
+		const __m256i value_offsets = strided_offsets_avx512(value_stride);
+		const __m512d alphas = _mm512_set1_pd(alpha);
+
+		int64_t k = 0;
+		for (; k + 8 <= nnz; k += 8)
+		{
+			__m256i idx = load_indices_avx512(
+			    indices + k * index_stride, index_stride, index_offsets);
+			__m512i conflicts = _mm512_maskz_conflict_epi32(
+			    0xFF, _mm512_castsi256_si512(idx));
+			if (_mm512_test_epi32_mask(conflicts, conflicts))
+			{
+				for (int64_t j = k; j < k + 8; j++)
+					dense[indices[j * index_stride]] +=
+					    alpha * values[j * value_stride];
+				continue;
+			}
+			__m512d v = load_values_avx512(
+			    values + k * value_stride, value_stride, value_offsets);
+			__m512d d = _mm512_i32gather_pd(idx, dense, sizeof(float64_t));
+			_mm512_i32scatter_pd(
+			    dense, idx, _mm512_fmadd_pd(alphas, v, d), sizeof(float64_t));
+		}
+		for (; k < nnz; k++)
+			dense[indices[k * index_stride]] += alpha * values[k * value_stride];
+	}
+
+	SIMD_AVX2 static float64_t
+	dense_dot_avx2(const float32_t* x, const float64_t* w, int32_t len)
+	{
+		__m256d acc0 = _mm256_setzero_pd();
+		__m256d acc1 = _mm256_setzero_pd();
+		int32_t i = 0;
+		for (; i + 8 <= len; i += 8)
+		{
+			acc0 = _mm256_fmadd_pd(
+			    _mm256_cvtps_pd(_mm_loadu_ps(x + i)), _mm256_loadu_pd(w + i),
+			    acc0);
+			acc1 = _mm256_fmadd_pd(
+			    _mm256_cvtps_pd(_mm_loadu_ps(x + i + 4)),
+			    _mm256_loadu_pd(w + i + 4), acc1);
+		}
+		float64_t result = horizontal_sum(_mm256_add_pd(acc0, acc1));
+		for (; i < len; i++)
+			result += x[i] * w[i];
+		return result;
+	}
+
+	/* four vectors at a time share the loads of w */
+	SIMD_AVX2 static void dense_dot_batch_avx2(
+	    const float32_t* x, int32_t len, int32_t num_vectors,
+	    const float64_t* w, float64_t* output)
+	{
+		int32_t v = 0;
+		for (; v + 4 <= num_vectors; v += 4)
+		{
+			const float32_t* x0 = x + int64_t(v) * len;
+			const float32_t* x1 = x0 + len;
+			const float32_t* x2 = x1 + len;
+			const float32_t* x3 = x2 + len;
+			__m256d acc0 = _mm256_setzero_pd();
+			__m256d acc1 = _mm256_setzero_pd();
+			__m256d acc2 = _mm256_setzero_pd();
+			__m256d acc3 = _mm256_setzero_pd();
+			int32_t i = 0;
+			for (; i + 4 <= len; i += 4)
+			{
+				__m256d wi = _mm256_loadu_pd(w + i);
+				acc0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x0 + i)), wi, acc0);
+				acc1 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x1 + i)), wi, acc1);
+				acc2 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x2 + i)), wi, acc2);
+				acc3 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x3 + i)), wi, acc3);
+			}
+			output[v] = horizontal_sum(acc0);
+			output[v + 1] = horizontal_sum(acc1);
+			output[v + 2] = horizontal_sum(acc2);
+			output[v + 3] = horizontal_sum(acc3);
+			for (; i < len; i++)
+			{
+				output[v] += x0[i] * w[i];
+				output[v + 1] += x1[i] * w[i];
+				output[v + 2] += x2[i] * w[i];
+				output[v + 3] += x3[i] * w[i];
+			}
+		}
+		for (; v < num_vectors; v++)
+			output[v] = dense_dot_avx2(x + int64_t(v) * len, w, len);
+	}
+
+	SIMD_AVX2 static void
+	dense_axpy_avx2(float64_t alpha, const float32_t* x, float64_t* y, int32_t len)
+	{
+		const __m256d alphas = _mm256_set1_pd(alpha);
+		int32_t i = 0;
+		for (; i + 4 <= len; i += 4)
+		{
+			_mm256_storeu_pd(
+			    y + i, _mm256_fmadd_pd(
+			               alphas, _mm256_cvtps_pd(_mm_loadu_ps(x + i)),
+			               _mm256_loadu_pd(y + i)));
+		}
+		for (; i < len; i++)
+			y[i] += alpha * x[i];
+	}
+
+	SIMD_AVX2 static int64_t
+	count_char_avx2(const char* text, int64_t len, char c)
+	{
+		const __m256i pattern = _mm256_set1_epi8(c);
+		int64_t count = 0;
+		int64_t i = 0;
+		for (; i + 32 <= len; i += 32)
+		{
+			__m256i block = _mm256_loadu_si256((const __m256i*)(text + i));
+			uint32_t matches = _mm256_movemask_epi8(
+			    _mm256_cmpeq_epi8(block, pattern));
+			count += __builtin_popcount(matches);
+		}
+		for (; i < len; i++)
+			count += text[i] == c;
+		return count;
+	}
+
+#undef SIMD_AVX2
+#undef SIMD_AVX512
+#endif // SIMD_KERNELS_X86
+
+	template <class T>
+	static float64_t sparse_dot_dispatch(
+	    const index_t* indices, int32_t index_stride, const T* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense)
+	{
+#ifdef SIMD_KERNELS_X86
+		switch (get_cpu_simd_level())
+		{
+		case CPU_SIMD_AVX512:
+			return sparse_dot_avx512(
+			    indices, index_stride, values, value_stride, nnz, dense);
+		case CPU_SIMD_AVX2:
+			return sparse_dot_avx2(
+			    indices, index_stride, values, value_stride, nnz, dense);
+		default:
+			break;
+		}
+#endif
+		return sparse_dot<T>(
+		    indices, index_stride, values, value_stride, nnz, dense);
+	}
+
+	template <class T>
+	static void sparse_axpy_dispatch(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const T* values, int32_t value_stride, int64_t nnz, float64_t* dense)
+	{
+#ifdef SIMD_KERNELS_X86
+		if (get_cpu_simd_level() == CPU_SIMD_AVX512)
+		{
+			sparse_axpy_avx512(
+			    alpha, indices, index_stride, values, value_stride, nnz, dense);
+			return;
+		}
+#endif
+		sparse_axpy<T>(
+		    alpha, indices, index_stride, values, value_stride, nnz, dense);
+	}
+
+	float64_t sparse_dot(
+	    const index_t* indices, int32_t index_stride, const float64_t* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense)
+	{
+		return sparse_dot_dispatch(
+		    indices, index_stride, values, value_stride, nnz, dense);
+	}
+
+	float64_t sparse_dot(
+	    const index_t* indices, int32_t index_stride, const float32_t* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense)
+	{
+		return sparse_dot_dispatch(
+		    indices, index_stride, values, value_stride, nnz, dense);
+	}
+
+	void sparse_axpy(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const float64_t* values, int32_t value_stride, int64_t nnz,
+	    float64_t* dense)
+	{
+		sparse_axpy_dispatch(
+		    alpha, indices, index_stride, values, value_stride, nnz, dense);
+	}
+
+	void sparse_axpy(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const float32_t* values, int32_t value_stride, int64_t nnz,
+	    float64_t* dense)
+	{
+		sparse_axpy_dispatch(
+		    alpha, indices, index_stride, values, value_stride, nnz, dense);
+	}
+
+	float64_t dense_dot(const float32_t* x, const float64_t* w, int32_t len)
+	{
+#ifdef SIMD_KERNELS_X86
+		if (get_cpu_simd_level() >= CPU_SIMD_AVX2)
+			return dense_dot_avx2(x, w, len);
+#endif
+		float64_t result = 0;
+		for (int32_t i = 0; i < len; i++)
+			result += x[i] * w[i];
+		return result;
+	}
+
+	void dense_dot_batch(
+	    const float32_t* x, int32_t len, int32_t num_vectors,
+	    const float64_t* w, float64_t* output)
+	{
+#ifdef SIMD_KERNELS_X86
+		if (get_cpu_simd_level() >= CPU_SIMD_AVX2)
+		{
+			dense_dot_batch_avx2(x, len, num_vectors, w, output);
+			return;
+		}
+#endif
+		for (int32_t v = 0; v < num_vectors; v++)
+			output[v] = dense_dot(x + int64_t(v) * len, w, len);
+	}
+
+	void dense_axpy(
+	    float64_t alpha, const float32_t* x, float64_t* y, int32_t len)
+	{
+#ifdef SIMD_KERNELS_X86
+		if (get_cpu_simd_level() >= CPU_SIMD_AVX2)
+		{
+			dense_axpy_avx2(alpha, x, y, len);
+			return;
+		}
+#endif
+		for (int32_t i = 0; i < len; i++)
+			y[i] += alpha * x[i];
+	}
+
+	int64_t count_char(const char* text, int64_t len, char c)
+	{
+#ifdef SIMD_KERNELS_X86
+		if (get_cpu_simd_level() >= CPU_SIMD_AVX2)
+			return count_char_avx2(text, len, c);
+#endif
+		int64_t count = 0;
+		for (int64_t i = 0; i < len; i++)
+			count += text[i] == c;
+		return count;
+	}
+}
+}
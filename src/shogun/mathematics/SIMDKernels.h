@@ -0,0 +1,187 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __SIMD_KERNELS_H__
+#define __SIMD_KERNELS_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGSparseVector.h>
+
+namespace shogun
+{
+/** Kernels for the innermost loops of linear methods, i.e. dot products
+ * of feature vectors with a dense weight vector and additions of feature
+ * vectors to it. For single and double precision values, the kernels are
+ * vectorized with gathers and scatters for AVX2 or AVX-512 chosen at
+ * runtime, see get_cpu_simd_level(). Other types use scalar loops.
+ *
+ * Sparse vectors are given by strided arrays of feature indices and values,
+ * so that both contiguous arrays and the interleaved entries of
+ * SGSparseVector can be passed. Feature indices must be within the dense
+ * vector.
+ */
+namespace simd
+{
+	/** dot product of a sparse and a dense vector
+	 * sum_k values[k*value_stride]*dense[indices[k*index_stride]]
+	 *
+	 * @param indices feature indices
+	 * @param index_stride distance between feature indices
+	 * @param values non-zero entries
+	 * @param value_stride distance between non-zero entries
+	 * @param nnz number of non-zero entries
+	 * @param dense dense vector
+	 * @return dot product
+	 */
+	template <class T>
+	float64_t sparse_dot(
+	    const index_t* indices, int32_t index_stride, const T* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense)
+	{
+		float64_t result = 0;
+		for (int64_t k = 0; k < nnz; k++)
+			result += dense[indices[k * index_stride]] * values[k * value_stride];
+		return result;
+	}
+
+	/** @copydoc sparse_dot */
+	float64_t sparse_dot(
+	    const index_t* indices, int32_t index_stride, const float64_t* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense);
+
+	/** @copydoc sparse_dot */
+	float64_t sparse_dot(
+	    const index_t* indices, int32_t index_stride, const float32_t* values,
+	    int32_t value_stride, int64_t nnz, const float64_t* dense);
+
+	/** adds a scaled sparse vector onto a dense one
+	 * dense[indices[k*index_stride]] += alpha*values[k*value_stride]
+	 *
+	 * @param alpha scalar to multiply with
+	 * @param indices feature indices
+	 * @param index_stride distance between feature indices
+	 * @param values non-zero entries
+	 * @param value_stride distance between non-zero entries
+	 * @param nnz number of non-zero entries
+	 * @param dense dense vector
+	 */
+	template <class T>
+	void sparse_axpy(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const T* values, int32_t value_stride, int64_t nnz, float64_t* dense)
+	{
+		for (int64_t k = 0; k < nnz; k++)
+			dense[indices[k * index_stride]] += alpha * values[k * value_stride];
+	}
+
+	/** @copydoc sparse_axpy */
+	void sparse_axpy(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const float64_t* values, int32_t value_stride, int64_t nnz,
+	    float64_t* dense);
+
+	/** @copydoc sparse_axpy */
+	void sparse_axpy(
+	    float64_t alpha, const index_t* indices, int32_t index_stride,
+	    const float32_t* values, int32_t value_stride, int64_t nnz,
+	    float64_t* dense);
+
+	/** dot product of a sparse vector stored as SGSparseVector and a
+	 * dense vector
+	 *
+	 * @param vec sparse vector
+	 * @param dense dense vector
+	 * @return dot product
+	 */
+	template <class T>
+	float64_t sparse_dot(const SGSparseVector<T>& vec, const float64_t* dense)
+	{
+		static_assert(
+		    sizeof(SGSparseVectorEntry<T>) % sizeof(T) == 0,
+		    "Entries should be strided by a multiple of their values");
+
+		if (vec.num_feat_entries == 0)
+			return 0;
+
+		return sparse_dot(
+		    &vec.features[0].feat_index,
+		    sizeof(SGSparseVectorEntry<T>) / sizeof(index_t),
+		    &vec.features[0].entry, sizeof(SGSparseVectorEntry<T>) / sizeof(T),
+		    vec.num_feat_entries, dense);
+	}
+
+	/** adds a scaled sparse vector stored as SGSparseVector onto a dense
+	 * vector
+	 *
+	 * @param alpha scalar to multiply with
+	 * @param vec sparse vector
+	 * @param dense dense vector
+	 */
+	template <class T>
+	void sparse_axpy(
+	    float64_t alpha, const SGSparseVector<T>& vec, float64_t* dense)
+	{
+		static_assert(
+		    sizeof(SGSparseVectorEntry<T>) % sizeof(T) == 0,
+		    "Entries should be strided by a multiple of their values");
+
+		if (vec.num_feat_entries == 0)
+			return;
+
+		sparse_axpy(
+		    alpha, &vec.features[0].feat_index,
+		    sizeof(SGSparseVectorEntry<T>) / sizeof(index_t),
+		    &vec.features[0].entry, sizeof(SGSparseVectorEntry<T>) / sizeof(T),
+		    vec.num_feat_entries, dense);
+	}
+
+	/** dot product of a single precision and a double precision vector,
+	 * accumulated in double precision
+	 *
+	 * @param x single precision vector
+	 * @param w double precision vector
+	 * @param len length of vectors
+	 * @return dot product
+	 */
+	float64_t dense_dot(const float32_t* x, const float64_t* w, int32_t len);
+
+	/** dot products of consecutive single precision vectors with a double
+	 * precision vector, which is loaded once for several of them
+	 *
+	 * @param x single precision vectors stored column-wise
+	 * @param len length of vectors
+	 * @param num_vectors number of vectors
+	 * @param w double precision vector
+	 * @param output dot product for each vector
+	 */
+	void dense_dot_batch(
+	    const float32_t* x, int32_t len, int32_t num_vectors,
+	    const float64_t* w, float64_t* output);
+
+	/** adds a scaled single precision vector onto a double precision one
+	 * y += alpha*x
+	 *
+	 * @param alpha scalar to multiply with
+	 * @param x single precision vector
+	 * @param y double precision vector
+	 * @param len length of vectors
+	 */
+	void dense_axpy(
+	    float64_t alpha, const float32_t* x, float64_t* y, int32_t len);
+
+	/** number of occurrences of a character in a text, e.g. of newlines
+	 * to count lines
+	 *
+	 * @param text text
+	 * @param len length of text
+	 * @param c character to count
+	 * @return number of occurrences
+	 */
+	int64_t count_char(const char* text, int64_t len, char c);
+}
+}
+
+#endif /* __SIMD_KERNELS_H__ */
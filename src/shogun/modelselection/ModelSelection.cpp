@@ -5,10 +5,28 @@
  *          Sergey Lisitsyn
  */
 
+#include <shogun/base/Parameter.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/progress.h>
+#include <shogun/evaluation/CrossValidation.h>
+#include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/labels/Labels.h>
+#include <shogun/lib/DynamicObjectArray.h>
+#include <shogun/lib/View.h>
+#include <shogun/machine/Machine.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/modelselection/ModelSelection.h>
 #include <shogun/modelselection/ModelSelectionParameters.h>
-#include <shogun/evaluation/CrossValidation.h>
-#include <shogun/base/Parameter.h>
+#include <shogun/modelselection/ParameterCombination.h>
+#include <shogun/util/hash.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
 
 using namespace shogun;
 
@@ -33,12 +51,16 @@ void CModelSelection::init()
 {
 	m_model_parameters=NULL;
 	m_machine_eval=NULL;
+	m_halving_factor=0;
 
 	SG_ADD((CSGObject**)&m_model_parameters, "model_parameters",
 			"Parameter tree for model selection");
 
 	SG_ADD((CSGObject**)&m_machine_eval, "machine_evaluation",
 			"Machine evaluation strategy");
+	SG_ADD(&m_halving_factor, "halving_factor",
+			"Reduction factor of successive halving",
+			ParameterProperties::SETTING);
 }
 
 CModelSelection::~CModelSelection()
@@ -46,3 +68,358 @@ CModelSelection::~CModelSelection()
 	SG_UNREF(m_model_parameters);
 	SG_UNREF(m_machine_eval);
 }
+
+void CModelSelection::set_halving_factor(int32_t factor)
+{
+	REQUIRE(factor>=0, "Halving factor (%d) must not be negative\n", factor)
+	m_halving_factor=factor;
+}
+
+int32_t CModelSelection::get_halving_factor() const
+{
+	return m_halving_factor;
+}
+
+void CModelSelection::set_path_parameter(const std::string& name)
+{
+	m_path_parameter=name;
+}
+
+const std::string& CModelSelection::get_path_parameter() const
+{
+	return m_path_parameter;
+}
+
+CParameterCombination* CModelSelection::select_best_combination(
+		CDynamicObjectArray* combinations, bool print_state)
+{
+	bool maximize=
+			m_machine_eval->get_evaluation_direction()==ED_MAXIMIZE;
+	float64_t worst=maximize ? CMath::ALMOST_NEG_INFTY : CMath::ALMOST_INFTY;
+
+	if (print_state)
+	{
+		if (maximize)
+			SG_PRINT("Direction is maximize\n")
+		else
+			SG_PRINT("Direction is minimize\n")
+	}
+
+	SGVector<index_t> candidates(combinations->get_num_elements());
+	candidates.range_fill();
+
+	/* successive halving: evaluate on growing subsamples of the data and
+	 * only keep the best 1/m_halving_factor of the combinations each round.
+	 * The last round always uses all data */
+	int32_t num_rounds=1;
+	if (m_halving_factor>1 && candidates.vlen>1)
+	{
+		num_rounds=std::ceil(
+				std::log((float64_t)candidates.vlen)/
+				std::log((float64_t)m_halving_factor));
+	}
+
+	auto features=m_machine_eval->get<CFeatures*>("features");
+	auto labels=m_machine_eval->get<CLabels*>("labels");
+	auto splitting=m_machine_eval->get<CSplittingStrategy*>(
+			"splitting_strategy");
+	index_t num_vectors=labels->get_num_labels();
+	index_t min_subsample=2*splitting->get_num_subsets();
+
+	SGVector<float64_t> results;
+	for (int32_t round=0; round<num_rounds; ++round)
+	{
+		bool last_round=round==num_rounds-1;
+		CFeatures* round_features=NULL;
+		CLabels* round_labels=NULL;
+
+		if (!last_round)
+		{
+			index_t num_subsample=num_vectors/
+					std::pow(m_halving_factor, num_rounds-1-round);
+
+			/* too few vectors for a meaningful evaluation */
+			if (num_subsample<min_subsample)
+				continue;
+
+			/* evenly strided subsample */
+			SGVector<index_t> subsample(num_subsample);
+			for (index_t i=0; i<num_subsample; ++i)
+				subsample[i]=(int64_t)i*num_vectors/num_subsample;
+
+			round_features=view(features, subsample);
+			round_labels=view(labels, subsample);
+			SG_REF(round_features);
+			SG_REF(round_labels);
+
+			SG_DEBUG("Successive halving round %d/%d: evaluating %d "
+					"combinations on %d vectors\n", round+1, num_rounds,
+					candidates.vlen, num_subsample)
+		}
+
+		if (m_path_parameter.empty())
+		{
+			results=evaluate_combinations(combinations, candidates,
+					round_features, round_labels, print_state);
+		}
+		else
+		{
+			results=evaluate_paths(combinations, candidates,
+					round_features, round_labels, print_state);
+		}
+
+		SG_UNREF(round_features);
+		SG_UNREF(round_labels);
+
+		if (last_round)
+			break;
+
+		/* failed evaluations are treated as the worst possible result */
+		for (auto& result : results)
+		{
+			if (CMath::is_nan(result))
+				result=worst;
+		}
+
+		/* keep the best combinations, ties are broken by order */
+		std::vector<index_t> order(candidates.vlen);
+		for (index_t i=0; i<candidates.vlen; ++i)
+			order[i]=i;
+
+		std::stable_sort(order.begin(), order.end(),
+				[&results, maximize](index_t a, index_t b)
+				{
+					return maximize ? results[a]>results[b] :
+							results[a]<results[b];
+				});
+
+		index_t num_survivors=
+				(candidates.vlen+m_halving_factor-1)/m_halving_factor;
+		std::sort(order.begin(), order.begin()+num_survivors);
+
+		SGVector<index_t> survivors(num_survivors);
+		for (index_t i=0; i<num_survivors; ++i)
+			survivors[i]=candidates[order[i]];
+
+		candidates=survivors;
+	}
+
+	/* search for best one, the first one wins in case of ties */
+	index_t best=-1;
+	float64_t best_result=worst;
+	for (index_t i=0; i<candidates.vlen; ++i)
+	{
+		if (maximize ? results[i]>best_result : results[i]<best_result)
+		{
+			best=candidates[i];
+			best_result=results[i];
+		}
+	}
+
+	if (best<0)
+		return NULL;
+
+	return (CParameterCombination*)combinations->get_element(best);
+}
+
+SGVector<float64_t> CModelSelection::evaluate_combinations(
+		CDynamicObjectArray* combinations, SGVector<index_t> candidates,
+		CFeatures* features, CLabels* labels, bool print_state)
+{
+	SGVector<float64_t> results(candidates.vlen);
+
+	/* underlying learning machine */
+	CMachine* machine=m_machine_eval->get_machine();
+
+	/* split threads between combinations and the folds of each evaluation */
+	int32_t num_threads=env()->get_num_threads();
+	int32_t num_outer=CMath::max(1, CMath::min(num_threads, candidates.vlen));
+	int32_t num_inner=CMath::max(1, num_threads/num_outer);
+#ifdef HAVE_OPENMP
+	int32_t max_active_levels=omp_get_max_active_levels();
+	omp_set_max_active_levels(2);
+#endif
+
+	auto pb=SG_PROGRESS(range(candidates.vlen));
+	#pragma omp parallel for num_threads(num_outer) schedule(dynamic)
+	for (index_t i=0; i<candidates.vlen; ++i)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(num_inner);
+#endif
+		CParameterCombination* current_combination=(CParameterCombination*)
+				combinations->get_element(candidates[i]);
+
+		/* combinations may share objects like kernels, so they are applied
+		 * to the attached machine and copied out while holding the lock */
+		CMachine* current_machine=NULL;
+		#pragma omp critical
+		{
+			if (print_state)
+			{
+				SG_PRINT("trying combination:\n")
+				current_combination->print_tree();
+			}
+
+			current_combination->apply_to_modsel_parameter(
+					machine->m_model_selection_parameters);
+			current_machine=make_clone(machine,
+					ParameterProperties::HYPER | ParameterProperties::SETTING);
+		}
+
+		CMachineEvaluation* evaluation=m_machine_eval->clone_for_machine(
+				current_machine, features, labels);
+
+		/* note that this may implicitly lock and unlock the machine */
+		CCrossValidationResult* result=
+				evaluation->evaluate()->as<CCrossValidationResult>();
+		results[i]=result->get_mean();
+
+		if (print_state)
+		{
+			#pragma omp critical
+			result->print_result();
+		}
+
+		SG_UNREF(result);
+		SG_UNREF(evaluation);
+		SG_UNREF(current_machine);
+		SG_UNREF(current_combination);
+		pb.print_progress();
+	}
+	pb.complete();
+
+#ifdef HAVE_OPENMP
+	omp_set_max_active_levels(max_active_levels);
+#endif
+	SG_UNREF(machine);
+
+	return results;
+}
+
+SGVector<float64_t> CModelSelection::evaluate_paths(
+		CDynamicObjectArray* combinations, SGVector<index_t> candidates,
+		CFeatures* features, CLabels* labels, bool print_state)
+{
+	SGVector<float64_t> results(candidates.vlen);
+
+	/* underlying learning machine */
+	CMachine* machine=m_machine_eval->get_machine();
+	REQUIRE(machine->has(m_path_parameter), "%s has no parameter \"%s\" "
+			"to follow a regularization path along\n", machine->get_name(),
+			m_path_parameter.c_str())
+
+	/* group the combinations that only differ in the path parameter, in
+	 * order of their first occurrence */
+	std::vector<float64_t> values(candidates.vlen);
+	std::vector<std::vector<index_t>> paths;
+	std::unordered_map<size_t, size_t> path_index;
+	for (index_t i=0; i<candidates.vlen; ++i)
+	{
+		CParameterCombination* current_combination=(CParameterCombination*)
+				combinations->get_element(candidates[i]);
+		current_combination->apply_to_modsel_parameter(
+				machine->m_model_selection_parameters);
+		SG_UNREF(current_combination);
+
+		values[i]=machine->get<float64_t>(m_path_parameter);
+		auto key=hyperparameter_hash(machine, m_path_parameter);
+		auto it=path_index.emplace(key, paths.size()).first;
+		if (it->second==paths.size())
+			paths.emplace_back();
+
+		paths[it->second].push_back(i);
+	}
+
+	for (auto& path : paths)
+	{
+		std::stable_sort(path.begin(), path.end(),
+				[&values](index_t a, index_t b)
+				{
+					return values[a]<values[b];
+				});
+	}
+
+	SG_DEBUG("Evaluating %d combinations along %d paths\n", candidates.vlen,
+			paths.size())
+
+	/* split threads between paths and the folds of each evaluation */
+	int32_t num_threads=env()->get_num_threads();
+	int32_t num_outer=CMath::max(1,
+			CMath::min(num_threads, (int32_t)paths.size()));
+	int32_t num_inner=CMath::max(1, num_threads/num_outer);
+#ifdef HAVE_OPENMP
+	int32_t max_active_levels=omp_get_max_active_levels();
+	omp_set_max_active_levels(2);
+#endif
+
+	auto pb=SG_PROGRESS(range(candidates.vlen));
+	#pragma omp parallel for num_threads(num_outer) schedule(dynamic)
+	for (size_t p=0; p<paths.size(); ++p)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(num_inner);
+#endif
+		CMachineEvaluation* evaluation=NULL;
+		for (auto i : paths[p])
+		{
+			CParameterCombination* current_combination=
+					(CParameterCombination*)combinations->get_element(
+							candidates[i]);
+
+			/* see evaluate_combinations() */
+			CMachine* current_machine=NULL;
+			#pragma omp critical
+			{
+				if (print_state)
+				{
+					SG_PRINT("trying combination:\n")
+					current_combination->print_tree();
+				}
+
+				current_combination->apply_to_modsel_parameter(
+						machine->m_model_selection_parameters);
+				current_machine=make_clone(machine,
+						ParameterProperties::HYPER |
+						ParameterProperties::SETTING);
+			}
+
+			/* the same evaluation is reused along the path, so that it can
+			 * warm start from the previous combination */
+			if (!evaluation)
+			{
+				evaluation=m_machine_eval->clone_for_machine(
+						current_machine, features, labels);
+				if (evaluation->has("warm_start"))
+					evaluation->put("warm_start", true);
+			}
+			else
+				evaluation->set_machine(current_machine);
+
+			CCrossValidationResult* result=
+					evaluation->evaluate()->as<CCrossValidationResult>();
+			results[i]=result->get_mean();
+
+			if (print_state)
+			{
+				#pragma omp critical
+				result->print_result();
+			}
+
+			SG_UNREF(result);
+			SG_UNREF(current_machine);
+			SG_UNREF(current_combination);
+			pb.print_progress();
+		}
+
+		SG_UNREF(evaluation);
+	}
+	pb.complete();
+
+#ifdef HAVE_OPENMP
+	omp_set_max_active_levels(max_active_levels);
+#endif
+	SG_UNREF(machine);
+
+	return results;
+}
@@ -13,10 +13,13 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/evaluation/MachineEvaluation.h>
 
+#include <string>
+
 namespace shogun
 {
 class CModelSelectionParameters;
 class CParameterCombination;
+class CDynamicObjectArray;
 
 /** @brief Abstract base class for model selection.
  *
@@ -24,6 +27,21 @@ class CParameterCombination;
  * cross-validation instance and searches for the best combination of parameters
  * in the abstract method select_model(), which has to be implemented in
  * concrete sub-classes.
+ *
+ * Combinations are evaluated in parallel, each on its own clone of the
+ * machine. The available threads are split between the combinations and the
+ * (also parallel) folds of the evaluation.
+ *
+ * Optionally, bad combinations can be discarded early by successive halving
+ * (see set_halving_factor()): all combinations are first evaluated on a small
+ * subsample of the data, and only the best ones are evaluated on
+ * successively larger subsamples until the full data is used.
+ *
+ * Alternatively, the combinations can be evaluated as regularization paths
+ * (see set_path_parameter()): combinations that only differ in one parameter
+ * are evaluated one after another in increasing order of that parameter,
+ * each warm starting from the models of the previous one, while different
+ * paths are evaluated in parallel.
  */
 class CModelSelection: public CSGObject
 {
@@ -50,15 +68,87 @@ public:
 	 */
 	virtual CParameterCombination* select_model(bool print_state=false)=0;
 
+	/** Sets the reduction factor of successive halving. In each round only
+	 * the best 1/factor of the combinations survive, while the number of
+	 * vectors they are evaluated on is multiplied by factor. A factor smaller
+	 * than two disables successive halving (default).
+	 *
+	 * @param factor reduction factor
+	 */
+	void set_halving_factor(int32_t factor);
+
+	/** @return reduction factor of successive halving */
+	int32_t get_halving_factor() const;
+
+	/** Sets the parameter of the machine along which regularization paths
+	 * are evaluated, e.g. "C1". Combinations that only differ in this
+	 * parameter are evaluated in increasing order of it, with the machine
+	 * evaluation (if it supports this, like CCrossValidation) and the
+	 * machine warm starting from the previous combination. An empty name
+	 * disables paths (default).
+	 *
+	 * @param name name of a floating point parameter of the machine
+	 */
+	void set_path_parameter(const std::string& name);
+
+	/** @return parameter along which regularization paths are evaluated */
+	const std::string& get_path_parameter() const;
+
 private:
 	/** initializer */
 	void init();
 
 protected:
+	/** Evaluates the given combinations and returns the best one
+	 *
+	 * @param combinations all combinations to evaluate
+	 * @param print_state if true, the current combination is printed
+	 *
+	 * @return best combination of model parameters (already SG_REF'ed)
+	 */
+	CParameterCombination* select_best_combination(
+			CDynamicObjectArray* combinations, bool print_state);
+
+	/** Evaluates a subset of combinations in parallel, each on a clone of
+	 * the machine
+	 *
+	 * @param combinations all combinations
+	 * @param candidates indices of the combinations to evaluate
+	 * @param features features to evaluate on, or NULL for all
+	 * @param labels labels to evaluate on, or NULL for all
+	 * @param print_state if true, the current combination is printed
+	 *
+	 * @return evaluation result for each candidate
+	 */
+	SGVector<float64_t> evaluate_combinations(
+			CDynamicObjectArray* combinations, SGVector<index_t> candidates,
+			CFeatures* features, CLabels* labels, bool print_state);
+
+	/** Evaluates a subset of combinations along regularization paths.
+	 * Paths are evaluated in parallel, the combinations of each path in
+	 * increasing order of the path parameter using a warm started machine
+	 * evaluation.
+	 *
+	 * @param combinations all combinations
+	 * @param candidates indices of the combinations to evaluate
+	 * @param features features to evaluate on, or NULL for all
+	 * @param labels labels to evaluate on, or NULL for all
+	 * @param print_state if true, the current combination is printed
+	 *
+	 * @return evaluation result for each candidate
+	 */
+	SGVector<float64_t> evaluate_paths(
+			CDynamicObjectArray* combinations, SGVector<index_t> candidates,
+			CFeatures* features, CLabels* labels, bool print_state);
+
 	/** model parameters */
 	CModelSelectionParameters* m_model_parameters;
 	/** cross validation */
 	CMachineEvaluation* m_machine_eval;
+	/** reduction factor of successive halving */
+	int32_t m_halving_factor;
+	/** parameter along which regularization paths are evaluated */
+	std::string m_path_parameter;
 };
 }
 #endif /* __MODELSELECTION_H_ */
@@ -12,6 +12,9 @@
 
 using namespace shogun;
 
+// minimal number of examples in a shard of the objective
+static const int32_t examples_per_shard = 1024;
+
 void ShareBoostOptimizer::optimize()
 {
 	int32_t N = m_sb->m_multiclass_strategy->get_num_classes() * m_sb->m_activeset.vlen;
@@ -24,7 +27,10 @@ void ShareBoostOptimizer::optimize()
 
 	lbfgs_progress_t progress = m_verbose ? &ShareBoostOptimizer::lbfgs_progress : NULL;
 
-	lbfgs(N, W, &objval, &ShareBoostOptimizer::lbfgs_evaluate, progress, this, &param);
+	// examples are evaluated in parallel shards, each of which writes
+	// predictions and rho of its own examples only
+	int32_t num_shards = CMath::max(1, m_sb->m_fea.num_cols / examples_per_shard);
+	lbfgs_sharded(N, W, &objval, &ShareBoostOptimizer::lbfgs_evaluate_shard, num_shards, progress, this, &param);
 
 	int32_t w_len = m_sb->m_activeset.vlen;
 	for (int32_t i=0; i < m_sb->m_multiclass_strategy->get_num_classes(); ++i)
@@ -39,41 +45,64 @@ void ShareBoostOptimizer::optimize()
 	SG_FREE(W);
 }
 
-float64_t ShareBoostOptimizer::lbfgs_evaluate(void *userdata, const float64_t *W,
-		float64_t *grad, const int32_t n, const float64_t step)
+float64_t ShareBoostOptimizer::lbfgs_evaluate_shard(void *userdata, const float64_t *W,
+		float64_t *grad, const int32_t n, const float64_t step, const int32_t shard,
+		const int32_t num_shards)
 {
 	ShareBoostOptimizer *optimizer = static_cast<ShareBoostOptimizer *>(userdata);
+	CShareBoost *sb = optimizer->m_sb;
+
+	int32_t m = sb->m_activeset.vlen;
+	int32_t k = sb->m_multiclass_strategy->get_num_classes();
 
-	optimizer->m_sb->compute_pred(W);
-	optimizer->m_sb->compute_rho();
+	SGMatrix<float64_t> fea = sb->m_fea;
+	auto lab = multiclass_labels(sb->m_labels);
 
-	int32_t m = optimizer->m_sb->m_activeset.vlen;
-	int32_t k = optimizer->m_sb->m_multiclass_strategy->get_num_classes();
+	int32_t begin = int64_t(fea.num_cols) * shard / num_shards;
+	int32_t end = int64_t(fea.num_cols) * (shard+1) / num_shards;
 
-	SGMatrix<float64_t> fea = optimizer->m_sb->m_fea;
-	auto lab = multiclass_labels(optimizer->m_sb->m_labels);
+	// compute predictions and rho of the examples in the shard, the
+	// same as compute_pred(W) and compute_rho() do for all examples
+	for (int32_t ii=begin; ii < end; ++ii)
+	{
+		for (int32_t j=0; j < k; ++j)
+		{
+			float64_t pred = 0;
+			for (int32_t i=0; i < m; ++i)
+				pred += W[j*m + i] * fea(sb->m_activeset[i], ii);
+			sb->m_pred(ii, j) = pred;
+		}
+
+		int32_t label = lab->get_int_label(ii);
+		sb->m_rho_norm[ii] = 0;
+		for (int32_t j=0; j < k; ++j)
+		{
+			sb->m_rho(j, ii) =
+			    std::exp((label == j) - sb->m_pred(ii, label) + sb->m_pred(ii, j));
+			sb->m_rho_norm[ii] += sb->m_rho(j, ii);
+		}
+	}
 
 	// compute gradient
-	for (int32_t i=0; i < m; ++i)
+	std::fill(grad, grad+n, 0);
+	for (int32_t ii=begin; ii < end; ++ii)
 	{
+		int32_t label = lab->get_int_label(ii);
 		for (int32_t j=0; j < k; ++j)
 		{
-			int32_t idx = j*m + i;
-			float64_t g=0;
-			for (int32_t ii=0; ii < fea.num_cols; ++ii)
-				g += fea(optimizer->m_sb->m_activeset[i], ii) *
-					(optimizer->m_sb->m_rho(j,ii)/optimizer->m_sb->m_rho_norm[ii] -
-					 (j == lab->get_int_label(ii)));
-			g /= fea.num_cols;
-			grad[idx] = g;
+			float64_t coef = sb->m_rho(j,ii)/sb->m_rho_norm[ii] - (j == label);
+			for (int32_t i=0; i < m; ++i)
+				grad[j*m + i] += fea(sb->m_activeset[i], ii) * coef;
 		}
 	}
+	for (int32_t idx=0; idx < n; ++idx)
+		grad[idx] /= fea.num_cols;
 
 	// compute objective function
 	float64_t objval = 0;
-	for (int32_t ii=0; ii < fea.num_cols; ++ii)
+	for (int32_t ii=begin; ii < end; ++ii)
 	{
-		objval += std::log(optimizer->m_sb->m_rho_norm[ii]);
+		objval += std::log(sb->m_rho_norm[ii]);
 	}
 	objval /= fea.num_cols;
 
@@ -27,8 +27,9 @@ public:
 	/** run optimization to compute the coefficients */
 	void optimize();
 private:
-	/** the callback for l-bfgs */
-	static float64_t lbfgs_evaluate(void *userdata, const float64_t *W, float64_t *grad, const int32_t n, const float64_t step);
+	/** the callback for l-bfgs, evaluating a shard of the examples */
+	static float64_t lbfgs_evaluate_shard(void *userdata, const float64_t *W, float64_t *grad, const int32_t n,
+			const float64_t step, const int32_t shard, const int32_t num_shards);
 
 	/** the callback for logging */
 	static int lbfgs_progress(
@@ -102,6 +102,24 @@ public:
 		SGVector<float64_t> raw_negative_descend_direction,
 		float64_t learning_rate);
 
+	/** Update the target variable based on the given sparse negative descend direction
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the sparse negative descend direction given the current value
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Does the updater support lazy updates given sparse negative descend directions?
+	 *
+	 * @return true if no descend correction is used
+	 */
+	virtual bool supports_lazy_update() const
+	{
+		return m_correction==NULL;
+	}
+
 protected:
 	/** Get the negative descend direction given current variable  and gradient 
 	 *
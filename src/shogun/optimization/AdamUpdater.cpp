@@ -134,13 +134,19 @@ float64_t AdamUpdater::get_negative_descend_direction(float64_t variable,
 	return res;
 }
 
-void AdamUpdater::update_variable(SGVector<float64_t> variable_reference,
-	SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+void AdamUpdater::update_idle_state(index_t idx, int32_t num_iterations)
+{
+	m_gradient_first_moment[idx]*=CMath::pow(m_decay_factor_first_moment,
+		(float64_t)num_iterations);
+	m_gradient_second_moment[idx]*=CMath::pow(m_decay_factor_second_moment,
+		(float64_t)num_iterations);
+}
+
+void AdamUpdater::begin_iteration(index_t len)
 {
-	REQUIRE(variable_reference.vlen==raw_negative_descend_direction.vlen, "");
 	if(m_gradient_first_moment.vlen==0)
 	{
-		m_gradient_first_moment=SGVector<float64_t>(variable_reference.vlen);
+		m_gradient_first_moment=SGVector<float64_t>(len);
 		m_gradient_first_moment.set_const(0.0);
 
 		m_gradient_second_moment=SGVector<float64_t>(m_gradient_first_moment.vlen);
@@ -158,7 +164,29 @@ void AdamUpdater::update_variable(SGVector<float64_t> variable_reference,
 	        1.0 -
 	        CMath::pow(
 	            m_decay_factor_first_moment, (float64_t)m_iteration_counter));
+}
+
+void AdamUpdater::update_variable(SGVector<float64_t> variable_reference,
+	SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	REQUIRE(variable_reference.vlen==raw_negative_descend_direction.vlen, "");
+	begin_iteration(variable_reference.vlen);
 
 	DescendUpdaterWithCorrection::update_variable(variable_reference, raw_negative_descend_direction,
 		learning_rate);
 }
+
+void AdamUpdater::update_variable_sparse(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	if(!supports_lazy_update())
+	{
+		DescendUpdater::update_variable_sparse(variable_reference,
+			raw_negative_descend_direction, learning_rate);
+		return;
+	}
+	begin_iteration(variable_reference.vlen);
+
+	DescendUpdaterWithCorrection::update_variable_sparse(variable_reference,
+		raw_negative_descend_direction, learning_rate);
+}
@@ -32,6 +32,7 @@
 #ifndef DESCENDUPDATER_H
 #define DESCENDUPDATER_H
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/base/SGObject.h>
 namespace shogun
 {
@@ -62,6 +63,45 @@ public:
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> negative_descend_direction, float64_t learning_rate)=0;
 
+	/** Does the updater support lazy updates given sparse negative descend directions?
+	 *
+	 * A lazy update only touches the entries of the target variable given in the
+	 * direction. The state of other entries is brought up to date when they are
+	 * touched again or when finish_lazy_update() is called.
+	 *
+	 * @return whether the updater supports lazy updates
+	 */
+	virtual bool supports_lazy_update() const { return false; }
+
+	/** Update the target variable based on the given sparse negative descend direction,
+	 * whose entries not given are zero
+	 *
+	 * The default implementation does a dense update.
+	 * Feature indices of the direction must be unique.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param negative_descend_direction the sparse negative descend direction given the current value
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> negative_descend_direction, float64_t learning_rate)
+	{
+		SGVector<float64_t> direction(variable_reference.vlen);
+		direction.zero();
+		for(index_t k=0; k<negative_descend_direction.num_feat_entries; k++)
+		{
+			index_t idx=negative_descend_direction.features[k].feat_index;
+			REQUIRE(idx>=0 && idx<direction.vlen, "The index (%d) is invalid\n", idx);
+			direction[idx]+=negative_descend_direction.features[k].entry;
+		}
+		update_variable(variable_reference, direction, learning_rate);
+	}
+
+	/** Bring all entries of the target variable up to date after lazy updates
+	 *
+	 * @param variable_reference a reference of the target variable
+	 */
+	virtual void finish_lazy_update(SGVector<float64_t> variable_reference) {}
 };
 
 }
@@ -35,6 +35,11 @@
 
 using namespace shogun;
 
+DescendUpdaterWithCorrection::DescendUpdaterWithCorrection()
+	:DescendUpdater()
+{
+	init();
+}
 
 DescendUpdaterWithCorrection::~DescendUpdaterWithCorrection()
 {
@@ -59,6 +64,9 @@ void DescendUpdaterWithCorrection::update_variable(SGVector<float64_t> variable_
 		"The length of variable_reference (%d) and the length of gradient (%d) do not match\n",
 		variable_reference.vlen,raw_negative_descend_direction.vlen);
 
+	if(m_last_lazy_update.vlen>0)
+		finish_lazy_update(variable_reference);
+
 	if(m_correction)
 	{
 		MomentumCorrection* momentum_correction=dynamic_cast<MomentumCorrection *>(m_correction);
@@ -86,9 +94,60 @@ void DescendUpdaterWithCorrection::update_variable(SGVector<float64_t> variable_
 	}
 }
 
+void DescendUpdaterWithCorrection::update_variable_sparse(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	REQUIRE(variable_reference.vlen>0,"variable_reference must set\n");
+	if(!supports_lazy_update())
+	{
+		DescendUpdater::update_variable_sparse(variable_reference,
+			raw_negative_descend_direction, learning_rate);
+		return;
+	}
+
+	if(m_last_lazy_update.vlen!=variable_reference.vlen)
+	{
+		m_last_lazy_update=SGVector<int32_t>(variable_reference.vlen);
+		m_last_lazy_update.zero();
+		m_lazy_iteration=0;
+	}
+	m_lazy_iteration++;
+
+	for(index_t k=0; k<raw_negative_descend_direction.num_feat_entries; k++)
+	{
+		index_t idx=raw_negative_descend_direction.features[k].feat_index;
+		REQUIRE(idx>=0 && idx<variable_reference.vlen, "The index (%d) is invalid\n", idx);
+		int32_t num_idle=m_lazy_iteration-1-m_last_lazy_update[idx];
+		if(num_idle>0)
+			update_idle_state(idx, num_idle);
+
+		variable_reference[idx]-=get_negative_descend_direction(variable_reference[idx],
+			raw_negative_descend_direction.features[k].entry, idx, learning_rate);
+		m_last_lazy_update[idx]=m_lazy_iteration;
+	}
+}
+
+void DescendUpdaterWithCorrection::finish_lazy_update(SGVector<float64_t> variable_reference)
+{
+	for(index_t idx=0; idx<m_last_lazy_update.vlen; idx++)
+	{
+		int32_t num_idle=m_lazy_iteration-m_last_lazy_update[idx];
+		if(num_idle>0)
+			update_idle_state(idx, num_idle);
+	}
+	m_last_lazy_update=SGVector<int32_t>();
+	m_lazy_iteration=0;
+}
+
 void DescendUpdaterWithCorrection::init()
 {
 	m_correction=NULL;
+	m_lazy_iteration=0;
+	m_last_lazy_update=SGVector<int32_t>();
 	SG_ADD((CSGObject **)&m_correction, "DescendUpdaterWithCorrection__m_correction",
 		"correction in DescendUpdaterWithCorrection");
+	SG_ADD(&m_lazy_iteration, "DescendUpdaterWithCorrection__m_lazy_iteration",
+		"lazy_iteration in DescendUpdaterWithCorrection");
+	SG_ADD(&m_last_lazy_update, "DescendUpdaterWithCorrection__m_last_lazy_update",
+		"last_lazy_update in DescendUpdaterWithCorrection");
 }
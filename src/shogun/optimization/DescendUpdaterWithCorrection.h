@@ -51,6 +51,9 @@ namespace shogun
 class DescendUpdaterWithCorrection: public DescendUpdater
 {
 public:
+	/*  Constructor */
+	DescendUpdaterWithCorrection();
+
 	/*  Destructor */
 	virtual ~DescendUpdaterWithCorrection();
 
@@ -65,7 +68,27 @@ public:
 	 */
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
-	
+
+	/** Update the target variable based on the given sparse negative descend direction
+	 *
+	 * If lazy updates are supported, only the given entries are updated. The
+	 * state of each entry is first brought up to date with the iterations in
+	 * which the entry was not touched, see update_idle_state().
+	 * Otherwise, a dense update is done.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the sparse negative descend direction given the current value
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Bring all entries of the target variable up to date after lazy updates
+	 *
+	 * @param variable_reference a reference of the target variable
+	 */
+	virtual void finish_lazy_update(SGVector<float64_t> variable_reference);
+
 	/** Set the type of descend correction
 	 *
 	 * @param correction the type of descend correction
@@ -95,9 +118,25 @@ protected:
 	virtual float64_t get_negative_descend_direction(float64_t variable,
 		float64_t raw_negative_descend_direction, index_t idx, float64_t learning_rate)=0;
 
+	/** Update the state of an entry for iterations in which its negative
+	 * descend direction was zero, which is skipped by lazy updates
+	 *
+	 * Updaters supporting lazy updates must not move the entry in these iterations.
+	 *
+	 * @param idx the index of the variable
+	 * @param num_iterations the number of skipped iterations
+	 */
+	virtual void update_idle_state(index_t idx, int32_t num_iterations) {}
+
 	/** descend correction object */
 	DescendCorrection* m_correction;
 
+	/** the number of lazy updates */
+	int32_t m_lazy_iteration;
+
+	/** the last lazy update in which each entry was touched */
+	SGVector<int32_t> m_last_lazy_update;
+
 private:
 	/**  Init */
 	void init();
@@ -112,6 +112,21 @@ public:
 	 */
 	virtual SGVector<float64_t> get_gradient()=0;
 
+	/** Get the SAMPLE gradient of the given sample wrt target variables as a sparse vector
+	 *
+	 * Unlike get_sparse_gradient(), the method must not change the state of
+	 * the cost function so that it can be called from several threads while
+	 * target variables are being updated, see SGDMinimizer::set_asynchronous_update().
+	 *
+	 * @param idx the index of the sample
+	 * @return sparse sample gradient of target variables
+	 */
+	virtual SGSparseVector<float64_t> get_sample_sparse_gradient(index_t idx)
+	{
+		SG_NOTIMPLEMENTED
+		return SGSparseVector<float64_t>();
+	}
+
 	/** Get the cost given current target variables 
 	 *
 	 * For least squares cost function, that is the value of \f$f(w)\f$.
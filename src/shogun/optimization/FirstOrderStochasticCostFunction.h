@@ -32,6 +32,7 @@
 #ifndef FIRSTORDERSTOCHASTICCOSTFUNCTION_H
 #define FIRSTORDERSTOCHASTICCOSTFUNCTION_H
 #include <shogun/lib/config.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/optimization/FirstOrderCostFunction.h>
 namespace shogun
 {
@@ -79,6 +80,50 @@ public:
 	 */
 	virtual SGVector<float64_t> get_gradient()=0;
 
+	/** Does the cost function provide sparse sample gradients?
+	 *
+	 * If so, the indices of the entries in get_sparse_gradient() must not depend
+	 * on the target variables and the sample gradient must only depend on
+	 * these entries of the target variables, as for linear models of sparse
+	 * features. Minimizers use this for lazy updates.
+	 *
+	 * @return whether get_sparse_gradient() is supported
+	 */
+	virtual bool has_sparse_gradient() { return false; }
+
+	/** Get the SAMPLE gradient wrt target variables as a sparse vector
+	 *
+	 * The sparse vector contains all entries of
+	 * \f$ \frac{\partial f_i(w) }{\partial w} \f$
+	 * which may be non-zero, where the index \f$i\f$ is obtained by next_sample().
+	 * Feature indices must be unique.
+	 *
+	 * @return sparse sample gradient of variables
+	 */
+	virtual SGSparseVector<float64_t> get_sparse_gradient()
+	{
+		SG_NOTIMPLEMENTED
+		return SGSparseVector<float64_t>();
+	}
+
+	/** Get the indices of the entries of get_sparse_gradient()
+	 *
+	 * As the indices do not depend on the target variables, minimizers use
+	 * them to bring these entries up to date before the sample gradient is
+	 * evaluated. The default implementation evaluates the sparse gradient,
+	 * cost functions should override it when the indices are cheaper to get.
+	 *
+	 * @return indices of the sparse sample gradient
+	 */
+	virtual SGVector<index_t> get_sparse_gradient_support()
+	{
+		SGSparseVector<float64_t> grad=get_sparse_gradient();
+		SGVector<index_t> support(grad.num_feat_entries);
+		for(index_t k=0; k<grad.num_feat_entries; k++)
+			support[k]=grad.features[k].feat_index;
+		return support;
+	}
+
 	/** Get the cost given current target variables 
 	 *
 	 * For least squares, that is the value of \f$f(w)\f$.
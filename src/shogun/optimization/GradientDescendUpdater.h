@@ -59,6 +59,15 @@ public:
 	 */
 	virtual const char* get_name() const { return "GradientDescendUpdater"; }
 
+	/** Does the updater support lazy updates given sparse negative descend directions?
+	 *
+	 * @return true if no descend correction is used
+	 */
+	virtual bool supports_lazy_update() const
+	{
+		return m_correction==NULL;
+	}
+
 protected:
 	/** Get the negative descend direction given current variable and gradient
 	 *
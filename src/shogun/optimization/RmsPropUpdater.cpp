@@ -103,6 +103,11 @@ float64_t RmsPropUpdater::get_negative_descend_direction(float64_t variable,
 	return res;
 }
 
+void RmsPropUpdater::update_idle_state(index_t idx, int32_t num_iterations)
+{
+	m_gradient_accuracy[idx]*=CMath::pow(m_decay_factor, (float64_t)num_iterations);
+}
+
 void RmsPropUpdater::update_variable(SGVector<float64_t> variable_reference,
 	SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
 {
@@ -117,3 +122,15 @@ void RmsPropUpdater::update_variable(SGVector<float64_t> variable_reference,
 	}
 	DescendUpdaterWithCorrection::update_variable(variable_reference, raw_negative_descend_direction, learning_rate);
 }
+
+void RmsPropUpdater::update_variable_sparse(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	REQUIRE(variable_reference.vlen>0,"variable_reference must set\n");
+	if(m_gradient_accuracy.vlen==0)
+	{
+		m_gradient_accuracy=SGVector<float64_t>(variable_reference.vlen);
+		m_gradient_accuracy.set_const(0.0);
+	}
+	DescendUpdaterWithCorrection::update_variable_sparse(variable_reference, raw_negative_descend_direction, learning_rate);
+}
@@ -106,6 +106,25 @@ public:
 	 */
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Update the target variable based on the given sparse negative descend direction
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the sparse negative descend direction given the current value
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Does the updater support lazy updates given sparse negative descend directions?
+	 *
+	 * @return true if no descend correction is used
+	 */
+	virtual bool supports_lazy_update() const
+	{
+		return m_correction==NULL;
+	}
+
 protected:
 	/** Get the negative descend direction given current variable  and gradient 
 	 *
@@ -121,6 +140,13 @@ protected:
 	virtual float64_t get_negative_descend_direction(float64_t variable,
 		float64_t gradient, index_t idx, float64_t learning_rate);
 
+	/** Decay the second moment of an entry for iterations in which its gradient was zero
+	 *
+	 * @param idx the index of the variable
+	 * @param num_iterations the number of skipped iterations
+	 */
+	virtual void update_idle_state(index_t idx, int32_t num_iterations);
+
 	/** learning_rate \f$\alpha\f$ at iteration */
 	float64_t m_build_in_learning_rate;
 
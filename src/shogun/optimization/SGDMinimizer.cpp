@@ -30,6 +30,8 @@
  */
 #include <shogun/optimization/SGDMinimizer.h>
 #include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/FirstOrderSAGCostFunction.h>
+#include <shogun/base/Parameter.h>
 #include <shogun/lib/config.h>
 using namespace shogun;
 
@@ -56,8 +58,16 @@ float64_t SGDMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	FirstOrderStochasticCostFunction *fun=dynamic_cast<FirstOrderStochasticCostFunction *>(m_fun);
 	REQUIRE(fun,"the cost function must be a stochastic cost function\n");
+	bool lazy_update=!m_penalty_type && fun->has_sparse_gradient() &&
+		m_gradient_updater->supports_lazy_update();
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
+		if(m_asynchronous_update)
+		{
+			do_asynchronous_pass(variable_reference);
+			continue;
+		}
+
 		fun->begin_sample();
 		while(fun->next_sample())
 		{
@@ -65,6 +75,12 @@ float64_t SGDMinimizer::minimize()
 			float64_t learning_rate=1.0;
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+			if(lazy_update)
+			{
+				SGSparseVector<float64_t> grad=fun->get_sparse_gradient();
+				m_gradient_updater->update_variable_sparse(variable_reference,grad,learning_rate);
+				continue;
+			}
 			SGVector<float64_t> grad=m_fun->get_gradient();
 			update_gradient(grad,variable_reference);
 			m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
@@ -72,15 +88,48 @@ float64_t SGDMinimizer::minimize()
 			do_proximal_operation(variable_reference);
 		}
 	}
+	m_gradient_updater->finish_lazy_update(variable_reference);
 	float64_t cost=m_fun->get_cost();
 	return cost+get_penalty(variable_reference);
 }
 
+void SGDMinimizer::do_asynchronous_pass(SGVector<float64_t> variable_reference)
+{
+	int32_t num_samples=dynamic_cast<FirstOrderSAGCostFunction *>(m_fun)->get_sample_size();
+
+#pragma omp parallel for schedule(dynamic, 64)
+	for(index_t idx=0; idx<num_samples; idx++)
+	{
+		FirstOrderSAGCostFunction *fun=static_cast<FirstOrderSAGCostFunction *>(m_fun);
+		SGSparseVector<float64_t> grad=fun->get_sample_sparse_gradient(idx);
+
+#pragma omp critical
+		{
+			m_iter_counter++;
+			float64_t learning_rate=1.0;
+			if(m_learning_rate)
+				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+			m_gradient_updater->update_variable_sparse(variable_reference,grad,learning_rate);
+		}
+	}
+}
+
 void SGDMinimizer::init()
 {
+	m_asynchronous_update=false;
+	SG_ADD(&m_asynchronous_update, "SGDMinimizer__m_asynchronous_update",
+		"asynchronous_update in SGDMinimizer");
 }
 
 void SGDMinimizer::init_minimization()
 {
 	FirstOrderStochasticMinimizer::init_minimization();
+	if(m_asynchronous_update)
+	{
+		FirstOrderSAGCostFunction *fun=dynamic_cast<FirstOrderSAGCostFunction *>(m_fun);
+		REQUIRE(fun && fun->has_sparse_gradient(),
+			"the cost function must be a stochastic average gradient cost function "
+			"with sparse gradients in the asynchronous mode\n");
+		REQUIRE(!m_penalty_type, "Penalty is not supported in the asynchronous mode\n");
+	}
 }
@@ -40,6 +40,17 @@ namespace shogun
  *
  * A good introduction to SGD can be found at
  * http://cs231n.github.io/neural-networks-3/#sgd
+ *
+ * If the cost function provides sparse sample gradients, no penalty is used
+ * and the gradient updater supports lazy updates, only the entries of the
+ * target variables in the support of each sample gradient are updated.
+ *
+ * In the asynchronous mode, sample gradients are computed by several threads
+ * while other threads update the target variables, as in
+ * Recht, Benjamin, et al.
+ * "Hogwild: A lock-free approach to parallelizing stochastic gradient descent."
+ * Advances in Neural Information Processing Systems. 2011.
+ * Updates are serialized so that the state of gradient updaters stays consistent.
  */
 
 class SGDMinimizer: public FirstOrderStochasticMinimizer
@@ -69,10 +80,41 @@ public:
 	 */
 	virtual float64_t minimize();
 
+	/** Set whether to compute sample gradients from several threads
+	 *
+	 * The cost function must be a FirstOrderSAGCostFunction with sparse
+	 * gradients, see FirstOrderSAGCostFunction::get_sample_sparse_gradient().
+	 * Each pass goes through all samples in an unspecified order.
+	 *
+	 * @param asynchronous_update whether to use the asynchronous mode
+	 */
+	virtual void set_asynchronous_update(bool asynchronous_update)
+	{
+		m_asynchronous_update=asynchronous_update;
+	}
+
+	/** Are sample gradients computed from several threads?
+	 *
+	 * @return whether the asynchronous mode is used
+	 */
+	virtual bool get_asynchronous_update() const
+	{
+		return m_asynchronous_update;
+	}
+
 protected:
 	/*  init the minimization process */
 	virtual void init_minimization();
 
+	/** Go through all samples once in the asynchronous mode
+	 *
+	 * @param variable_reference a reference of the target variable
+	 */
+	virtual void do_asynchronous_pass(SGVector<float64_t> variable_reference);
+
+	/** whether sample gradients are computed from several threads */
+	bool m_asynchronous_update;
+
 private:
 	  /* Init */
 	void init();
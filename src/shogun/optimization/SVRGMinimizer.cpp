@@ -30,6 +30,7 @@
  */
 #include <shogun/optimization/SVRGMinimizer.h>
 #include <shogun/optimization/SGDMinimizer.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
 #include <shogun/base/Parameter.h>
 using namespace shogun;
 
@@ -93,6 +94,10 @@ float64_t SVRGMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	FirstOrderSAGCostFunction *fun=dynamic_cast<FirstOrderSAGCostFunction *>(m_fun);
 	REQUIRE(fun,"the cost function must be a stochastic average gradient cost function\n");
+	GradientDescendUpdater* gradient_descend_updater=
+		dynamic_cast<GradientDescendUpdater *>(m_gradient_updater);
+	bool lazy_update=!m_penalty_type && fun->has_sparse_gradient() &&
+		gradient_descend_updater && gradient_descend_updater->supports_lazy_update();
 	for(;m_cur_passes<(m_num_passes-m_num_sgd_passes);m_cur_passes++)
 	{
 		if(m_cur_passes%m_svrg_interval==0)
@@ -103,6 +108,12 @@ float64_t SVRGMinimizer::minimize()
 			std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, m_previous_variable.vector);
 			m_average_gradient=fun->get_average_gradient();
 		}
+
+		if(lazy_update)
+		{
+			do_lazy_pass(variable_reference);
+			continue;
+		}
 		fun->begin_sample();
 		while(fun->next_sample())
 		{
@@ -131,3 +142,62 @@ float64_t SVRGMinimizer::minimize()
 	float64_t cost=m_fun->get_cost();
 	return cost+get_penalty(variable_reference);
 }
+
+void SVRGMinimizer::do_lazy_pass(SGVector<float64_t> variable_reference)
+{
+	FirstOrderSAGCostFunction *fun=static_cast<FirstOrderSAGCostFunction *>(m_fun);
+	/* entries are behind by the average gradient scaled with the sum of
+	 * learning rates since they were last touched */
+	float64_t learning_rate_sum=0;
+	SGVector<float64_t> last_learning_rate_sum(variable_reference.vlen);
+	last_learning_rate_sum.zero();
+
+	fun->begin_sample();
+	while(fun->next_sample())
+	{
+		m_iter_counter++;
+		float64_t learning_rate=1.0;
+		if(m_learning_rate)
+			learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+
+		/* the support does not depend on the variable, so it is brought up to
+		 * date before the sample gradient is evaluated on it */
+		SGVector<index_t> support=fun->get_sparse_gradient_support();
+		for(index_t k=0; k<support.vlen; k++)
+		{
+			index_t idx=support[k];
+			variable_reference[idx]-=m_average_gradient[idx]*
+				(learning_rate_sum-last_learning_rate_sum[idx]);
+		}
+		SGSparseVector<float64_t> grad_new=fun->get_sparse_gradient();
+
+		SGVector<float64_t> var(support.vlen);
+		for(index_t k=0; k<support.vlen; k++)
+		{
+			index_t idx=support[k];
+			var[k]=variable_reference[idx];
+			variable_reference[idx]=m_previous_variable[idx];
+		}
+		SGSparseVector<float64_t> grad_old=fun->get_sparse_gradient();
+		for(index_t k=0; k<support.vlen; k++)
+			variable_reference[support[k]]=var[k];
+
+		learning_rate_sum+=learning_rate;
+		for(index_t k=0; k<grad_new.num_feat_entries; k++)
+			variable_reference[grad_new.features[k].feat_index]-=learning_rate*grad_new.features[k].entry;
+		for(index_t k=0; k<grad_old.num_feat_entries; k++)
+			variable_reference[grad_old.features[k].feat_index]+=learning_rate*grad_old.features[k].entry;
+		for(index_t k=0; k<support.vlen; k++)
+		{
+			index_t idx=support[k];
+			variable_reference[idx]-=learning_rate*m_average_gradient[idx];
+			last_learning_rate_sum[idx]=learning_rate_sum;
+		}
+	}
+
+	for(index_t idx=0; idx<variable_reference.vlen; idx++)
+	{
+		variable_reference[idx]-=m_average_gradient[idx]*
+			(learning_rate_sum-last_learning_rate_sum[idx]);
+	}
+}
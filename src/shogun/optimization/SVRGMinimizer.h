@@ -116,6 +116,17 @@ protected:
 	/**  init the minimization process */
 	virtual void init_minimization();
 
+	/** Go through data once with sparse sample gradients
+	 *
+	 * The average gradient is applied to each entry of the target variables
+	 * just in time, i.e. when the entry is in the support of the next sample
+	 * gradient or at the end of the pass, which gives the same result as the
+	 * dense update with GradientDescendUpdater.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 */
+	virtual void do_lazy_pass(SGVector<float64_t> variable_reference);
+
 	/** the number to go through data  using SGD before SVRG update */
 	int32_t m_num_sgd_passes;
 
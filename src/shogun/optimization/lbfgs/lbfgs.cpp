@@ -68,6 +68,7 @@ licence.
 #include <vector>
 
 #include <shogun/optimization/lbfgs/lbfgs.h>
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/memory.h>
@@ -87,6 +88,10 @@ struct tag_callback_data {
     lbfgs_evaluate_t proc_evaluate;
     lbfgs_progress_t proc_progress;
     lbfgs_adjust_step_t proc_adjust_step;
+    lbfgs_evaluate_shard_t proc_evaluate_shard;
+    int32_t num_shards;
+    SGMatrix<float64_t> shard_gradients;    /* [n, num_shards] */
+    SGVector<float64_t> shard_values;       /* [num_shards] */
 };
 typedef struct tag_callback_data callback_data_t;
 
@@ -207,15 +212,42 @@ void lbfgs_parameter_init(lbfgs_parameter_t *param)
     sg_memcpy(param, &_defparam, sizeof(*param));
 }
 
-int32_t lbfgs(
+/* Evaluates the objective function and its gradient, either at once or as
+   sums over shards which are evaluated in parallel. */
+static float64_t evaluate(
+    callback_data_t *cd,
+    const float64_t *x,
+    float64_t *g,
+    const float64_t step
+    )
+{
+    if (cd->proc_evaluate_shard == NULL)
+        return cd->proc_evaluate(cd->instance, x, g, cd->n, step);
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int32_t shard = 0; shard < cd->num_shards; ++shard) {
+        cd->shard_values[shard] = cd->proc_evaluate_shard(
+            cd->instance, x, cd->shard_gradients.get_column_vector(shard),
+            cd->n, step, shard, cd->num_shards);
+    }
+
+    /* Sum up in the order of shards to not depend on the scheduling. */
+    SGVector<float64_t> g_wrap(g, cd->n, false);
+    sg_memcpy(g, cd->shard_gradients.matrix, cd->n*sizeof(float64_t));
+    float64_t f = cd->shard_values[0];
+    for (int32_t shard = 1; shard < cd->num_shards; ++shard) {
+        f += cd->shard_values[shard];
+        linalg::add(g_wrap, cd->shard_gradients.get_column(shard), g_wrap);
+    }
+    return f;
+}
+
+static int32_t lbfgs_minimize(
     int32_t n,
     float64_t *x,
     float64_t *ptr_fx,
-    lbfgs_evaluate_t proc_evaluate,
-    lbfgs_progress_t proc_progress,
-    void *instance,
-    lbfgs_parameter_t *_param,
-    lbfgs_adjust_step_t proc_adjust_step
+    callback_data_t& cd,
+    lbfgs_parameter_t *_param
     )
 {
     int32_t ret;
@@ -235,14 +267,6 @@ int32_t lbfgs(
     float64_t rate = 0.;
     line_search_proc linesearch = line_search_morethuente;
 
-    /* Construct a callback data. */
-    callback_data_t cd;
-    cd.n = n;
-    cd.instance = instance;
-    cd.proc_evaluate = proc_evaluate;
-    cd.proc_progress = proc_progress;
-    cd.proc_adjust_step=proc_adjust_step;
-
     /* Check the input parameters for errors. */
     if (n <= 0) {
         return LBFGSERR_INVALID_N;
@@ -346,6 +370,12 @@ int32_t lbfgs(
         /* Allocate an array for storing previous values of the objective function. */
         if (0 < param.past)
             pf = SGVector<float64_t>(param.past);
+
+        /* Allocate gradients and values of shards. */
+        if (cd.proc_evaluate_shard != NULL) {
+            cd.shard_gradients = SGMatrix<float64_t>(n, cd.num_shards);
+            cd.shard_values = SGVector<float64_t>(cd.num_shards);
+        }
     }
     catch (const ShogunException& e)
     {
@@ -354,7 +384,7 @@ int32_t lbfgs(
     }
 
     /* Evaluate the function value and its gradient. */
-    fx = cd.proc_evaluate(cd.instance, x, g.vector, cd.n, 0);
+    fx = evaluate(&cd, x, g.vector, 0);
     if (0. != param.orthantwise_c) {
         /* Compute the L1 norm of the variable and add it to the object value. */
         xnorm = owlqn_x1norm(x, param.orthantwise_start, param.orthantwise_end);
@@ -437,7 +467,7 @@ int32_t lbfgs(
 
 			/* Roll back */
 			if (ls == LBFGSERR_INVALID_VALUE)
-				fx = cd.proc_evaluate(cd.instance, x, g.vector, cd.n, step);
+				fx = evaluate(&cd, x, g.vector, step);
 
 			goto lbfgs_exit;
 		}
@@ -609,6 +639,59 @@ lbfgs_exit:
 	return ret;
 }
 
+int32_t lbfgs(
+    int32_t n,
+    float64_t *x,
+    float64_t *ptr_fx,
+    lbfgs_evaluate_t proc_evaluate,
+    lbfgs_progress_t proc_progress,
+    void *instance,
+    lbfgs_parameter_t *_param,
+    lbfgs_adjust_step_t proc_adjust_step
+    )
+{
+    /* Construct a callback data. */
+    callback_data_t cd;
+    cd.n = n;
+    cd.instance = instance;
+    cd.proc_evaluate = proc_evaluate;
+    cd.proc_progress = proc_progress;
+    cd.proc_adjust_step=proc_adjust_step;
+    cd.proc_evaluate_shard = NULL;
+    cd.num_shards = 0;
+
+    return lbfgs_minimize(n, x, ptr_fx, cd, _param);
+}
+
+int32_t lbfgs_sharded(
+    int32_t n,
+    float64_t *x,
+    float64_t *ptr_fx,
+    lbfgs_evaluate_shard_t proc_evaluate_shard,
+    int32_t num_shards,
+    lbfgs_progress_t proc_progress,
+    void *instance,
+    lbfgs_parameter_t *_param,
+    lbfgs_adjust_step_t proc_adjust_step
+    )
+{
+    if (proc_evaluate_shard == NULL || num_shards <= 0) {
+        return LBFGSERR_INVALIDPARAMETERS;
+    }
+
+    /* Construct a callback data. */
+    callback_data_t cd;
+    cd.n = n;
+    cd.instance = instance;
+    cd.proc_evaluate = NULL;
+    cd.proc_progress = proc_progress;
+    cd.proc_adjust_step=proc_adjust_step;
+    cd.proc_evaluate_shard = proc_evaluate_shard;
+    cd.num_shards = num_shards;
+
+    return lbfgs_minimize(n, x, ptr_fx, cd, _param);
+}
+
 
 
 static int32_t line_search_backtracking(
@@ -648,6 +731,7 @@ static int32_t line_search_backtracking(
     dgtest = param->ftol * dginit;
     const index_t max_iter = 20;
 
+    SGVector<float64_t> x_wrap(x, n, false);
     for (;;) {
         sg_memcpy(x, xp.vector, n*sizeof(float64_t));
         if (cd->proc_adjust_step)
@@ -659,20 +743,20 @@ static int32_t line_search_backtracking(
                 return LBFGSERR_INVALID_VALUE;
         }
 
-        SGVector<float64_t>::add(x, 1, x, *stp, s, n);
+        linalg::add(x_wrap, s, x_wrap, 1.0, *stp);
         float64_t decay=0.5;
         index_t iter=0;
 
         while(true)
         {
             /* Evaluate the function and gradient values. */
-            *f = cd->proc_evaluate(cd->instance, x, g.vector, cd->n, *stp);
+            *f = evaluate(cd, x, g.vector, *stp);
             ++count;
             if (CMath::is_nan(*f) || std::isinf(*f))
                 *stp*=decay;
             else
                 break;
-            SGVector<float64_t>::add(x, 1, x, -1.0*(*stp), s, n);
+            linalg::add(x_wrap, s, x_wrap, 1.0, -1.0*(*stp));
             iter++;
             if (iter>max_iter)
                 return LBFGSERR_INVALID_VALUE;
@@ -767,7 +851,7 @@ static int32_t line_search_backtracking_owlqn(
         owlqn_project(x, wp.vector, param->orthantwise_start, param->orthantwise_end);
 
         /* Evaluate the function and gradient values. */
-        *f = cd->proc_evaluate(cd->instance, x, g.vector, cd->n, *stp);
+        *f = evaluate(cd, x, g.vector, *stp);
 
         /* Compute the L1 norm of the variables and add it to the object value. */
         norm = owlqn_x1norm(x, param->orthantwise_start, param->orthantwise_end);
@@ -862,6 +946,7 @@ static int32_t line_search_morethuente(
     fx = fy = finit;
     dgx = dgy = dginit;
 
+    SGVector<float64_t> x_wrap(x, n, false);
     for (;;) {
         /*
             Set the minimum and maximum steps to correspond to the
@@ -895,10 +980,10 @@ static int32_t line_search_morethuente(
         if (cd->proc_adjust_step)
             *stp=cd->proc_adjust_step(cd->instance, x, s.vector, cd->n, *stp);
 
-        SGVector<float64_t>::add(x, 1, x, *stp, s, n);
+        linalg::add(x_wrap, s, x_wrap, 1.0, *stp);
 
         /* Evaluate the function and gradient values. */
-        *f = cd->proc_evaluate(cd->instance, x, g.vector, cd->n, *stp);
+        *f = evaluate(cd, x, g.vector, *stp);
 
         dg = linalg::dot(g, s);
 
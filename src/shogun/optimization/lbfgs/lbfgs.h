@@ -362,6 +362,39 @@ typedef float64_t (*lbfgs_evaluate_t)(
     const float64_t step
     );
 
+/**
+ * Callback interface to provide objective function and gradient evaluations
+ * over a shard of the data.
+ *
+ *  The lbfgs_sharded() function calls this function for every shard to obtain
+ *  the values of objective function and its gradients when needed, from
+ *  several threads at once. The objective function and its gradients are
+ *  the sums over all shards. A client program must implement this function
+ *  so that calls for different shards can run concurrently, e.g. by only
+ *  reading shared data or writing to disjoint parts of it.
+ *
+ *  @param  instance    The user data sent for lbfgs_sharded() function by the client.
+ *  @param  x           The current values of variables.
+ *  @param  g           The gradient vector of the shard. The callback function
+ *                      must compute all gradient values of the shard for the
+ *                      current variables.
+ *  @param  n           The number of variables.
+ *  @param  step        The current step of the line search routine.
+ *  @param  shard       The index of the shard.
+ *  @param  num_shards  The number of shards.
+ *  @retval float64_t The value of the objective function of the shard for
+ *                          the current variables.
+ */
+typedef float64_t (*lbfgs_evaluate_shard_t)(
+    void *instance,
+    const float64_t *x,
+    float64_t *g,
+    const int n,
+    const float64_t step,
+    const int shard,
+    const int num_shards
+    );
+
 /**
  * Callback interface to receive the progress of the optimization process.
  *
@@ -492,6 +525,44 @@ int lbfgs(
     lbfgs_adjust_step_t proc_adjust_step=NULL
     );
 
+/**
+ * Start a L-BFGS optimization of an objective function which is a sum over
+ * shards of the data.
+ *
+ *  Shards are evaluated in parallel and their objective values and gradients
+ *  are summed in the order of shards, so results do not depend on the number
+ *  of threads. Other arguments are the same as of lbfgs().
+ *
+ *  @param  n           The number of variables.
+ *  @param  x           The array of variables.
+ *  @param  ptr_fx      The pointer to the variable that receives the final
+ *                      value of the objective function for the variables.
+ *  @param  proc_evaluate_shard   The callback function to provide function and
+ *                          gradient evaluations of a shard given a current
+ *                          values of variables.
+ *  @param  num_shards  The number of shards.
+ *  @param  proc_progress   The callback function to receive the progress.
+ *  @param  instance    A user data for the client program.
+ *  @param  param       The pointer to a structure representing parameters for
+ *                      L-BFGS optimization.
+ *  @param  proc_adjust_step   The callback function to adjust step size based on constraints.
+ *
+ *  @retval int         The status code. This function returns zero if the
+ *                      minimization process terminates without an error. A
+ *                      non-zero value indicates an error.
+ */
+int lbfgs_sharded(
+    int n,
+    float64_t *x,
+    float64_t *ptr_fx,
+    lbfgs_evaluate_shard_t proc_evaluate_shard,
+    int num_shards,
+    lbfgs_progress_t proc_progress,
+    void *instance,
+    lbfgs_parameter_t *param,
+    lbfgs_adjust_step_t proc_adjust_step=NULL
+    );
+
 /**
  * Initialize L-BFGS parameters to the default values.
  *
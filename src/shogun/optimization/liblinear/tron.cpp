@@ -64,13 +64,14 @@ CTron::CTron(const function *f, float64_t e, int32_t it)
 	this->fun_obj=const_cast<function *>(f);
 	this->eps=e;
 	this->max_iter=it;
+	this->num_iter=0;
 }
 
 CTron::~CTron()
 {
 }
 
-void CTron::tron(float64_t *w, float64_t max_train_time)
+void CTron::tron(float64_t *w, float64_t max_train_time, bool warm_start)
 {
 	// Parameters for updating the iterates.
 	float64_t eta0 = 1e-4, eta1 = 0.25, eta2 = 0.75;
@@ -90,14 +91,25 @@ void CTron::tron(float64_t *w, float64_t max_train_time)
 	double *w_new = SG_MALLOC(double, n);
 	double *g = SG_MALLOC(double, n);
 
+	// the stopping criterion is relative to the gradient at zero, also
+	// when starting from a given w
 	for (i=0; i<n; i++)
-		w[i] = 0;
+		w_new[i] = 0;
+
+	f = fun_obj->fun(w_new);
+	fun_obj->grad(w_new, g);
+	float64_t gnorm1 = tron_dnrm2(n, g, inc);
+
+	if (warm_start)
+	{
+		f = fun_obj->fun(w);
+		fun_obj->grad(w, g);
+	}
+	else
+		sg_memcpy(w, w_new, sizeof(float64_t)*n);
 
-	f = fun_obj->fun(w);
-	fun_obj->grad(w, g);
 	delta = tron_dnrm2(n, g, inc);
-	float64_t gnorm1 = delta;
-	float64_t gnorm = gnorm1;
+	float64_t gnorm = delta;
 
 	if (gnorm <= eps*gnorm1)
 		search = 0;
@@ -182,6 +194,7 @@ void CTron::tron(float64_t *w, float64_t max_train_time)
 	}
 
 	pb.complete_absolute();
+	num_iter = iter-1;
 
 	SG_FREE(g);
 	SG_FREE(r);
@@ -68,10 +68,14 @@ public:
 
 	/** tron
 	 *
-	 * @param w w
+	 * @param w w, starting point if warm_start, result
 	 * @param max_train_time maximum training time
+	 * @param warm_start whether to start from the given w instead of zero
 	 */
-	void tron(float64_t *w, float64_t max_train_time);
+	void tron(float64_t *w, float64_t max_train_time, bool warm_start=false);
+
+	/** @return number of iterations of the last call to tron */
+	int32_t get_num_iterations() const { return num_iter; }
 
 	/** @return object name */
 	virtual const char* get_name() const { return "Tron"; }
@@ -82,6 +86,7 @@ private:
 
 	float64_t eps;
 	int32_t max_iter;
+	int32_t num_iter;
 	function *fun_obj;
 };
 }
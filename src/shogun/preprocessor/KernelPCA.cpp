@@ -13,20 +13,30 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include <shogun/clustering/KMeans.h>
+#include <shogun/distance/EuclideanDistance.h>
 #include <shogun/features/Features.h>
+#include <shogun/features/RandomFourierDotFeatures.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace shogun;
 
-CKernelPCA::CKernelPCA() : CPreprocessor()
+CKernelPCA::CKernelPCA() : RandomMixin<CPreprocessor>()
 {
 	init();
 }
 
-CKernelPCA::CKernelPCA(CKernel* k) : CPreprocessor()
+CKernelPCA::CKernelPCA(CKernel* k) : RandomMixin<CPreprocessor>()
 {
 	init();
 	set_kernel(k);
@@ -40,6 +50,10 @@ void CKernelPCA::init()
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
 	m_kernel = NULL;
+	m_method = KPCA_EXACT;
+	m_landmark_selection = LANDMARKS_KMEANS;
+	m_num_landmarks = 100;
+	m_num_random_features = 100;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data");
@@ -49,15 +63,36 @@ void CKernelPCA::init()
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_method, "method", "kernel PCA method",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(KPCA_EXACT, KPCA_NYSTROEM, KPCA_RANDOM_FEATURES));
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_landmark_selection, "landmark_selection",
+	    "landmark selection of the Nystroem method",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(LANDMARKS_KMEANS, LANDMARKS_LEVERAGE));
+	SG_ADD(
+	    &m_num_landmarks, "num_landmarks",
+	    "number of landmarks of the Nystroem method",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_num_random_features, "num_random_features",
+	    "number of random Fourier features", ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_random_coefficients, "random_coefficients",
+	    "coefficients of the random Fourier features");
 }
 
 void CKernelPCA::cleanup()
 {
 	m_transformation_matrix = SGMatrix<float64_t>();
 	m_bias_vector = SGVector<float64_t>();
+	m_random_coefficients = SGMatrix<float64_t>();
 
 	if (m_init_features)
 		SG_UNREF(m_init_features);
+	m_init_features = NULL;
 
 	m_fitted = false;
 }
@@ -75,6 +110,20 @@ void CKernelPCA::fit(CFeatures* features)
 	if (m_fitted)
 		cleanup();
 
+	if (m_method == KPCA_NYSTROEM)
+	{
+		fit_nystroem(features);
+		m_fitted = true;
+		return;
+	}
+
+	if (m_method == KPCA_RANDOM_FEATURES)
+	{
+		fit_random_features(features);
+		m_fitted = true;
+		return;
+	}
+
 	SG_REF(features);
 	m_init_features = features;
 
@@ -126,11 +175,209 @@ void CKernelPCA::fit(CFeatures* features)
 	SG_INFO("Done\n")
 }
 
+void CKernelPCA::fit_nystroem(CFeatures* features)
+{
+	int32_t n = features->get_num_vectors();
+	int32_t num_landmarks = std::min(m_num_landmarks, n);
+
+	CFeatures* landmarks = nullptr;
+	if (m_landmark_selection == LANDMARKS_KMEANS)
+	{
+		REQUIRE(
+		    features->get_feature_class() == C_DENSE &&
+		        features->get_feature_type() == F_DREAL,
+		    "K-means landmarks require dense real valued features\n");
+
+		auto kmeans =
+		    some<CKMeans>(num_landmarks, new CEuclideanDistance(), true);
+		seed(kmeans.get());
+		kmeans->train(features);
+		landmarks =
+		    new CDenseFeatures<float64_t>(kmeans->get_cluster_centers());
+	}
+	else
+		landmarks = select_leverage_landmarks(features);
+
+	SG_REF(landmarks);
+	m_init_features = landmarks;
+
+	m_kernel->init(landmarks, landmarks);
+	auto landmarks_kernel = m_kernel->get_kernel_matrix();
+	m_kernel->init(landmarks, features);
+	auto cross_kernel = m_kernel->get_kernel_matrix();
+	m_kernel->cleanup();
+
+	// pseudo inverse square root of the landmark kernel matrix
+	SGVector<float64_t> eigenvalues(num_landmarks);
+	SGMatrix<float64_t> eigenvectors(num_landmarks, num_landmarks);
+	linalg::eigen_solver_symmetric(landmarks_kernel, eigenvalues, eigenvectors);
+	auto tolerance = std::numeric_limits<float64_t>::epsilon() * num_landmarks *
+	                 std::max(eigenvalues[num_landmarks - 1], 0.0);
+	SGMatrix<float64_t> scaled(num_landmarks, num_landmarks);
+	for (auto j : range(num_landmarks))
+	{
+		auto scale = eigenvalues[j] > tolerance
+		                 ? 1.0 / std::sqrt(eigenvalues[j])
+		                 : 0.0;
+		for (auto i : range(num_landmarks))
+			scaled(i, j) = eigenvectors(i, j) * scale;
+	}
+	auto map = linalg::matrix_prod(scaled, eigenvectors, false, true);
+
+	SG_INFO("Embedding %d vectors using %d landmarks\n", n, num_landmarks)
+	fit_embedding(linalg::matrix_prod(map, cross_kernel), map);
+}
+
+CFeatures* CKernelPCA::select_leverage_landmarks(CFeatures* features)
+{
+	int32_t n = features->get_num_vectors();
+	int32_t num_landmarks = std::min(m_num_landmarks, n);
+	int32_t num_pilots = std::min(2 * num_landmarks, n);
+
+	// the scores are approximated with a uniformly drawn pilot sample, which
+	// keeps the kernel matrix at n times the number of pilots
+	SGVector<index_t> indices(n);
+	std::iota(indices.begin(), indices.end(), 0);
+	random::shuffle(indices.begin(), indices.end(), m_prng);
+	SGVector<index_t> pilot_indices(num_pilots);
+	std::copy_n(indices.begin(), num_pilots, pilot_indices.begin());
+	std::sort(pilot_indices.begin(), pilot_indices.end());
+	auto pilots = wrap(features->copy_subset(pilot_indices));
+
+	m_kernel->init(pilots, pilots);
+	auto pilot_kernel = m_kernel->get_kernel_matrix();
+	m_kernel->init(features, pilots);
+	auto cross_kernel = m_kernel->get_kernel_matrix();
+	m_kernel->cleanup();
+
+	// ridge leverage score of x is |(W + lambda I)^{-1/2} k_P(x)|^2, the
+	// ridge is a small fraction of the average eigenvalue
+	SGVector<float64_t> eigenvalues(num_pilots);
+	SGMatrix<float64_t> eigenvectors(num_pilots, num_pilots);
+	linalg::eigen_solver_symmetric(pilot_kernel, eigenvalues, eigenvectors);
+	auto ridge = 1e-3 * linalg::sum(eigenvalues) / num_pilots +
+	             std::numeric_limits<float64_t>::epsilon();
+	for (auto j : range(num_pilots))
+	{
+		auto scale = 1.0 / std::sqrt(std::max(eigenvalues[j], 0.0) + ridge);
+		for (auto i : range(num_pilots))
+			eigenvectors(i, j) *= scale;
+	}
+	auto projected = linalg::matrix_prod(cross_kernel, eigenvectors);
+
+	// weighted sampling without replacement, the vectors with the largest
+	// log(u)/score are selected (Efraimidis & Spirakis, 2006)
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	SGVector<float64_t> keys(n);
+	for (auto i : range(n))
+	{
+		float64_t score = 0;
+		for (auto j : range(num_pilots))
+			score += projected(i, j) * projected(i, j);
+		keys[i] = std::log(uniform(m_prng)) /
+		          std::max(score, std::numeric_limits<float64_t>::min());
+	}
+	std::partial_sort(
+	    indices.begin(), indices.begin() + num_landmarks, indices.end(),
+	    [&keys](index_t a, index_t b) { return keys[a] > keys[b]; });
+
+	SGVector<index_t> landmark_indices(num_landmarks);
+	std::copy_n(indices.begin(), num_landmarks, landmark_indices.begin());
+	std::sort(landmark_indices.begin(), landmark_indices.end());
+	return features->copy_subset(landmark_indices);
+}
+
+void CKernelPCA::fit_random_features(CFeatures* features)
+{
+	REQUIRE(
+	    m_kernel->get_kernel_type() == K_GAUSSIAN,
+	    "Random Fourier features approximate the gaussian kernel only\n");
+	REQUIRE(
+	    features->get_feature_class() == C_DENSE &&
+	        features->get_feature_type() == F_DREAL,
+	    "Random Fourier features require dense real valued features\n");
+
+	// same distribution as CRandomFourierDotFeatures, drawn here so that the
+	// preprocessor seed controls the features
+	auto width = m_kernel->as<CGaussianKernel>()->get_width();
+	auto dim = features->as<CDotFeatures>()->get_dim_feature_space();
+	m_random_coefficients = SGMatrix<float64_t>(dim + 1, m_num_random_features);
+	NormalDistribution<float64_t> normal_dist;
+	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 2 * CMath::PI);
+	for (auto j : range(m_num_random_features))
+	{
+		for (auto i : range(dim))
+			m_random_coefficients(i, j) =
+			    std::sqrt(2.0 / width) * normal_dist(m_prng);
+		m_random_coefficients(dim, j) = uniform_real_dist(m_prng);
+	}
+
+	SG_INFO(
+	    "Embedding %d vectors using %d random features\n",
+	    features->get_num_vectors(), m_num_random_features)
+	fit_embedding(random_features(features), SGMatrix<float64_t>());
+}
+
+SGMatrix<float64_t> CKernelPCA::random_features(CFeatures* features) const
+{
+	REQUIRE(
+	    features->get_feature_class() == C_DENSE &&
+	        features->get_feature_type() == F_DREAL,
+	    "Random Fourier features require dense real valued features\n");
+
+	SGVector<float64_t> params(1);
+	params[0] = m_kernel->as<CGaussianKernel>()->get_width();
+	auto rff = some<CRandomFourierDotFeatures>(
+	    features->as<CDotFeatures>(), m_random_coefficients.num_cols, GAUSSIAN,
+	    params, m_random_coefficients);
+	return rff->get_computed_dot_feature_matrix();
+}
+
+void CKernelPCA::fit_embedding(
+    const SGMatrix<float64_t>& embedding, const SGMatrix<float64_t>& map)
+{
+	int32_t dim = embedding.num_rows;
+	if (m_target_dim > dim)
+	{
+		SG_SWARNING(
+		    "Target dimension (%d) is not a valid value, it must be "
+		    "less or equal than the embedding dimension. "
+		    "Setting it to maximum allowed size (%d).",
+		    m_target_dim, dim);
+		m_target_dim = dim;
+	}
+
+	auto mean = linalg::rowwise_sum(embedding);
+	linalg::scale(mean, mean, 1.0 / embedding.num_cols);
+	SGMatrix<float64_t> centered = embedding.clone();
+	linalg::add_vector(centered, mean, centered, 1.0, -1.0);
+	auto scatter = linalg::matrix_prod(centered, centered, false, true);
+
+	SGVector<float64_t> eigenvalues(m_target_dim);
+	SGMatrix<float64_t> eigenvectors(dim, m_target_dim);
+	linalg::eigen_solver_symmetric(
+	    scatter, eigenvalues, eigenvectors, m_target_dim);
+
+	// unit principal axes of the embedding, eigenvalues are in increasing
+	// order
+	SGMatrix<float64_t> axes(dim, m_target_dim);
+	for (auto i : range(m_target_dim))
+		axes.set_column(i, eigenvectors.get_column(m_target_dim - i - 1));
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	linalg::matrix_prod(axes, mean, m_bias_vector, true);
+	linalg::scale(m_bias_vector, m_bias_vector, -1.0);
+
+	m_transformation_matrix =
+	    map.matrix ? linalg::matrix_prod(map, axes) : axes;
+}
+
 CFeatures* CKernelPCA::transform(CFeatures* features, bool inplace)
 {
 	assert_fitted();
 
-	if (dynamic_cast<CDenseFeatures<float64_t>*>(features))
+	if (dynamic_cast<CDenseFeatures<float64_t>*>(features) ||
+	    m_method == KPCA_NYSTROEM)
 	{
 		auto feature_matrix = apply_to_feature_matrix(features);
 		return new CDenseFeatures<float64_t>(feature_matrix);
@@ -148,13 +395,27 @@ CFeatures* CKernelPCA::transform(CFeatures* features, bool inplace)
 SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 {
 	assert_fitted();
-	int32_t n = m_init_features->get_num_vectors();
+
+	if (m_method == KPCA_RANDOM_FEATURES)
+	{
+		auto new_feature_matrix = linalg::matrix_prod(
+		    m_transformation_matrix, random_features(features), true);
+		linalg::add_vector(
+		    new_feature_matrix, m_bias_vector, new_feature_matrix);
+		return new_feature_matrix;
+	}
 
 	m_kernel->init(features, m_init_features);
 	auto kernel_matrix = m_kernel->get_kernel_matrix();
 
-	auto rows_sum = linalg::rowwise_sum(kernel_matrix);
-	linalg::add_vector(kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	// the Nystroem embedding is centered by the bias only
+	if (m_method == KPCA_EXACT)
+	{
+		int32_t n = m_init_features->get_num_vectors();
+		auto rows_sum = linalg::rowwise_sum(kernel_matrix);
+		linalg::add_vector(
+		    kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	}
 
 	SGMatrix<float64_t> new_feature_matrix =
 	    linalg::matrix_prod(m_transformation_matrix, kernel_matrix, true, true);
@@ -243,3 +504,50 @@ CKernel* CKernelPCA::get_kernel() const
 	SG_REF(m_kernel);
 	return m_kernel;
 }
+
+void CKernelPCA::set_method(EKernelPCAMethod method)
+{
+	m_method = method;
+}
+
+EKernelPCAMethod CKernelPCA::get_method() const
+{
+	return m_method;
+}
+
+void CKernelPCA::set_landmark_selection(ELandmarkSelection selection)
+{
+	m_landmark_selection = selection;
+}
+
+ELandmarkSelection CKernelPCA::get_landmark_selection() const
+{
+	return m_landmark_selection;
+}
+
+void CKernelPCA::set_num_landmarks(int32_t num_landmarks)
+{
+	REQUIRE(
+	    num_landmarks > 0, "Number of landmarks (%d) must be positive\n",
+	    num_landmarks);
+	m_num_landmarks = num_landmarks;
+}
+
+int32_t CKernelPCA::get_num_landmarks() const
+{
+	return m_num_landmarks;
+}
+
+void CKernelPCA::set_num_random_features(int32_t num_random_features)
+{
+	REQUIRE(
+	    num_random_features > 0,
+	    "Number of random features (%d) must be positive\n",
+	    num_random_features);
+	m_num_random_features = num_random_features;
+}
+
+int32_t CKernelPCA::get_num_random_features() const
+{
+	return m_num_random_features;
+}
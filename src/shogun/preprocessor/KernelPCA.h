@@ -12,6 +12,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -20,6 +21,26 @@ namespace shogun
 class CFeatures;
 class CKernel;
 
+/** Kernel PCA methods */
+enum EKernelPCAMethod
+{
+	/** eigendecomposition of the full kernel matrix */
+	KPCA_EXACT = 10,
+	/** Nystroem approximation of the kernel from a set of landmarks */
+	KPCA_NYSTROEM = 20,
+	/** random Fourier features, gaussian kernel only */
+	KPCA_RANDOM_FEATURES = 30
+};
+
+/** Landmark selection of the Nystroem method */
+enum ELandmarkSelection
+{
+	/** cluster centers of k-means, dense features only */
+	LANDMARKS_KMEANS = 10,
+	/** vectors sampled by their approximate ridge leverage scores */
+	LANDMARKS_LEVERAGE = 20
+};
+
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
  * Schoelkopf, B., Smola, A. J., & Mueller, K. R. (1999).
@@ -27,8 +48,15 @@ class CKernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * The exact method needs the full kernel matrix of the training data. For
+ * larger data, KPCA_NYSTROEM maps the data to \f$W^{-1/2}k_L(x)\f$, where
+ * \f$k_L(x)\f$ are the kernel values of \f$x\f$ with m landmarks and
+ * \f$W\f$ is the kernel matrix of the landmarks, and KPCA_RANDOM_FEATURES
+ * maps it to random Fourier features (Rahimi & Recht, 2007). Linear PCA of
+ * the m dimensional embedding approximates kernel PCA without forming any
+ * n by n matrix.
  */
-class CKernelPCA : public CPreprocessor
+class CKernelPCA : public RandomMixin<CPreprocessor>
 {
 public:
 		/** default constructor
@@ -111,11 +139,79 @@ public:
 		 */
 		CKernel* get_kernel() const;
 
+		/** setter for method
+		 * @param method kernel PCA method
+		 */
+		void set_method(EKernelPCAMethod method);
+
+		/** getter for method
+		 * @return kernel PCA method
+		 */
+		EKernelPCAMethod get_method() const;
+
+		/** setter for landmark selection of the Nystroem method
+		 * @param selection landmark selection
+		 */
+		void set_landmark_selection(ELandmarkSelection selection);
+
+		/** getter for landmark selection of the Nystroem method
+		 * @return landmark selection
+		 */
+		ELandmarkSelection get_landmark_selection() const;
+
+		/** setter for number of landmarks of the Nystroem method
+		 * @param num_landmarks number of landmarks
+		 */
+		void set_num_landmarks(int32_t num_landmarks);
+
+		/** getter for number of landmarks of the Nystroem method
+		 * @return number of landmarks
+		 */
+		int32_t get_num_landmarks() const;
+
+		/** setter for number of random Fourier features
+		 * @param num_random_features number of random features
+		 */
+		void set_num_random_features(int32_t num_random_features);
+
+		/** getter for number of random Fourier features
+		 * @return number of random features
+		 */
+		int32_t get_num_random_features() const;
+
 	protected:
 
 		/** default init */
 		void init();
 
+	private:
+		/** fit using the Nystroem approximation */
+		void fit_nystroem(CFeatures* features);
+
+		/** fit using random Fourier features */
+		void fit_random_features(CFeatures* features);
+
+		/** select landmarks by approximate ridge leverage scores
+		 * @param features features to select from
+		 * @return landmarks, a subset of the features
+		 */
+		CFeatures* select_leverage_landmarks(CFeatures* features);
+
+		/** linear PCA of an explicit embedding
+		 * @param embedding embedded training vectors as columns
+		 * @param map matrix that maps the kernel features to the embedding,
+		 * empty if they are the same
+		 */
+		void fit_embedding(
+		    const SGMatrix<float64_t>& embedding,
+		    const SGMatrix<float64_t>& map);
+
+		/** random Fourier features of dense features
+		 * @param features dense features
+		 * @return random features as columns
+		 */
+		SGMatrix<float64_t> random_features(CFeatures* features) const;
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -132,6 +228,21 @@ public:
 
 		/** kernel to be used */
 		CKernel* m_kernel;
+
+		/** kernel PCA method */
+		EKernelPCAMethod m_method;
+
+		/** landmark selection of the Nystroem method */
+		ELandmarkSelection m_landmark_selection;
+
+		/** number of landmarks of the Nystroem method */
+		int32_t m_num_landmarks;
+
+		/** number of random Fourier features */
+		int32_t m_num_random_features;
+
+		/** coefficients of the random Fourier features */
+		SGMatrix<float64_t> m_random_coefficients;
 };
 }
 #endif
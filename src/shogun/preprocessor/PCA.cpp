@@ -7,9 +7,12 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/features/Features.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PCA.h>
 
@@ -19,7 +22,7 @@ using namespace Eigen;
 CPCA::CPCA(
     bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method,
     EPCAMemoryMode mem_mode)
-    : CDensePreprocessor<float64_t>()
+    : RandomMixin<CDensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -30,7 +33,7 @@ CPCA::CPCA(
 }
 
 CPCA::CPCA(EPCAMethod method, bool do_whitening, EPCAMemoryMode mem_mode)
-    : CDensePreprocessor<float64_t>()
+    : RandomMixin<CDensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -51,6 +54,9 @@ void CPCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance = 1e-15;
 	m_target_dim = 1;
+	m_oversampling = 10;
+	m_num_power_iterations = 2;
+	m_batch_size = 1000;
 
 	SG_ADD(
 	    &m_transformation_matrix, "transformation_matrix",
@@ -72,6 +78,18 @@ void CPCA::init()
 	SG_ADD(
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_oversampling, "oversampling",
+	    "additional random dimensions of randomized method",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_num_power_iterations, "num_power_iterations",
+	    "power iterations of randomized method",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_batch_size, "batch_size",
+	    "vectors per batch when fitting streaming features",
+	    ParameterProperties::SETTING);
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_mode, "mode", "PCA Mode.",
 	    ParameterProperties::HYPER,
@@ -83,7 +101,7 @@ void CPCA::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_method, "method",
 	    "Method used for PCA calculation", ParameterProperties::NONE,
-	    SG_OPTIONS(AUTO, SVD, EVD));
+	    SG_OPTIONS(AUTO, SVD, EVD, RANDOMIZED));
 }
 
 CPCA::~CPCA()
@@ -95,6 +113,13 @@ void CPCA::fit(CFeatures* features)
 	if (m_fitted)
 		cleanup();
 
+	if (features->get_feature_class() == C_STREAMING_DENSE)
+	{
+		fit_streaming(features);
+		m_fitted = true;
+		return;
+	}
+
 	auto feature_matrix =
 	    features->as<CDenseFeatures<float64_t>>()->get_feature_matrix();
 	auto num_vectors = feature_matrix.num_cols;
@@ -122,7 +147,9 @@ void CPCA::fit(CFeatures* features)
 	if (m_method == AUTO)
 		m_method = (num_vectors > num_features) ? EVD : SVD;
 
-	if (m_method == EVD)
+	if (m_method == RANDOMIZED)
+		init_with_randomized_svd(feature_matrix);
+	else if (m_method == EVD)
 		init_with_evd(feature_matrix, max_dim_allowed);
 	else
 		init_with_svd(feature_matrix, max_dim_allowed);
@@ -192,28 +219,13 @@ void CPCA::init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_
 	// eigenvector matrix
 	transformMatrix = eigenSolve.eigenvectors().block(0,
 				num_features-num_dim, num_features,num_dim);
+	// eigenvalues of the components are the last num_dim ones
 	if (m_whitening)
-	{
-		for (int32_t i=0; i<num_dim; i++)
-		{
-			if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i+max_dim_allowed-num_dim],
-									m_eigenvalue_zero_tolerance))
-			{
-				SG_WARNING(
-				    "Covariance matrix has almost zero Eigenvalue (ie "
-				    "Eigenvalue within a tolerance of %E around 0) at "
-				    "dimension %d. Consider reducing its dimension.\n",
-				    m_eigenvalue_zero_tolerance,
-				    i + max_dim_allowed - num_dim + 1)
-
-				transformMatrix.col(i) = MatrixXd::Zero(num_features,1);
-				continue;
-			}
-
-			transformMatrix.col(i) /= std::sqrt(
-			    eigenValues[i + max_dim_allowed - num_dim] * (num_vectors - 1));
-		}
-	}
+		whiten(
+		    SGVector<float64_t>(
+		        m_eigenvalues_vector.vector + max_dim_allowed - num_dim,
+		        num_dim, false),
+		    num_vectors);
 }
 
 void CPCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_dim_allowed)
@@ -268,24 +280,174 @@ void CPCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_
 	transformMatrix = svd.matrixV().block(0, 0, num_features, num_dim);
 
 	if (m_whitening)
+		whiten(m_eigenvalues_vector, num_vectors);
+}
+
+void CPCA::init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix)
+{
+	REQUIRE(
+	    m_mode == FIXED_NUMBER,
+	    "Randomized PCA only supports FIXED_NUMBER mode\n")
+
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+	int32_t num_samples = std::min(
+	    m_target_dim + m_oversampling, std::min(num_vectors, num_features));
+
+	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
+
+	// random subspace
+	SGMatrix<float64_t> omega(num_features, num_samples);
+	random::fill_array(omega, NormalDistribution<float64_t>(), m_prng);
+	MatrixXd basis = Map<MatrixXd>(omega.matrix, num_features, num_samples);
+
+	// subspace iteration with XX', the basis is orthonormalized after each
+	// step to not lose the smaller components to round off
+	SG_INFO("Computing range of %d dimensional subspace\n", num_samples)
+	for (int32_t i = 0; i <= m_num_power_iterations; i++)
+	{
+		basis = fmatrix * (fmatrix.transpose() * basis);
+		HouseholderQR<MatrixXd> qr(basis);
+		basis = qr.householderQ() * MatrixXd::Identity(num_features, num_samples);
+	}
+
+	// XX' restricted to the subspace is small enough to be decomposed
+	MatrixXd projection = fmatrix.transpose() * basis;
+	SelfAdjointEigenSolver<MatrixXd> eigen_solver(
+	    projection.transpose() * projection);
+
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+	SG_INFO("Reducing from %i to %i features\n", num_features, num_dim)
+
+	// eigenvalues are in ascending order, components in descending order
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transform_matrix(
+	    m_transformation_matrix.matrix, num_features, num_dim);
+	for (int32_t i = 0; i < num_dim; i++)
+	{
+		auto index = num_samples - 1 - i;
+		m_eigenvalues_vector[i] =
+		    std::max(eigen_solver.eigenvalues()[index], 0.0) /
+		    (num_vectors - 1);
+		transform_matrix.col(i) =
+		    basis * eigen_solver.eigenvectors().col(index);
+	}
+
+	if (m_whitening)
+		whiten(m_eigenvalues_vector, num_vectors);
+}
+
+void CPCA::fit_streaming(CFeatures* features)
+{
+	REQUIRE(
+	    m_mode == FIXED_NUMBER,
+	    "Streaming PCA only supports FIXED_NUMBER mode\n")
+	REQUIRE(m_batch_size > 0, "Batch size (%d) must be positive\n", m_batch_size)
+
+	auto stream = features->as<CStreamingDenseFeatures<float64_t>>();
+	stream->start_parser();
+
+	// the data seen so far is summarized by its mean and the top singular
+	// vectors and values of the centered data
+	int64_t num_vectors = 0;
+	VectorXd mean;
+	MatrixXd basis;
+	VectorXd singular_values;
+	while (true)
 	{
-		for (int32_t i = 0; i < num_dim; i++)
+		auto batch = wrap(stream->get_streamed_features(m_batch_size));
+		auto batch_matrix =
+		    batch->as<CDenseFeatures<float64_t>>()->get_feature_matrix();
+		index_t batch_size = batch_matrix.num_cols;
+		if (batch_size == 0)
+			break;
+
+		Map<MatrixXd> fmatrix(
+		    batch_matrix.matrix, batch_matrix.num_rows, batch_size);
+		VectorXd batch_mean = fmatrix.rowwise().mean();
+		auto total = num_vectors + batch_size;
+
+		// [previous components, centered batch, mean correction]
+		index_t num_cols = basis.cols() + batch_size + (num_vectors > 0 ? 1 : 0);
+		SGMatrix<float64_t> stacked(fmatrix.rows(), num_cols);
+		Map<MatrixXd> stacked_matrix(stacked.matrix, fmatrix.rows(), num_cols);
+		if (basis.cols() > 0)
+			stacked_matrix.leftCols(basis.cols()) =
+			    basis * singular_values.asDiagonal();
+		stacked_matrix.middleCols(basis.cols(), batch_size) =
+		    fmatrix.colwise() - batch_mean;
+		if (num_vectors > 0)
 		{
-			if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
-			{
+			stacked_matrix.col(num_cols - 1) =
+			    std::sqrt(float64_t(num_vectors) * batch_size / total) *
+			    (mean - batch_mean);
+			mean = (num_vectors * mean + batch_size * batch_mean) / total;
+		}
+		else
+			mean = batch_mean;
+		num_vectors = total;
 
-				SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
-					"Eigenvalue within a tolerance of %E around 0) at "
-					"dimension %d. Consider reducing its dimension.",
-					m_eigenvalue_zero_tolerance, i + 1)
+		auto rank = std::min(stacked.num_rows, stacked.num_cols);
+		SGVector<float64_t> s(rank);
+		SGMatrix<float64_t> U(stacked.num_rows, rank);
+		linalg::svd(stacked, s, U);
 
-				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
-				continue;
-			}
+		auto num_components = std::min(m_target_dim, rank);
+		basis = Map<MatrixXd>(U.matrix, U.num_rows, rank).leftCols(num_components);
+		singular_values = Map<VectorXd>(s.vector, rank).head(num_components);
+		SG_DEBUG("Updated components with %d vectors\n", batch_size)
+
+		if (batch_size < m_batch_size)
+			break;
+	}
+	stream->end_parser();
 
-			transformMatrix.col(i) /=
-			    std::sqrt(eigenValues[i] * (num_vectors - 1));
+	REQUIRE(
+	    basis.cols() == m_target_dim,
+	    "target dimension (%d) should be less or equal to than minimum of N "
+	    "and D (%d)\n", m_target_dim, basis.cols())
+
+	num_dim = m_target_dim;
+	num_old_dim = basis.rows();
+	SG_INFO(
+	    "Reducing from %i to %i features using %d streamed vectors\n",
+	    num_old_dim, num_dim, num_vectors)
+
+	m_mean_vector = SGVector<float64_t>(num_old_dim);
+	Map<VectorXd>(m_mean_vector.vector, num_old_dim) = mean;
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd>(m_eigenvalues_vector.vector, num_dim) =
+	    singular_values.cwiseProduct(singular_values) / (num_vectors - 1);
+	m_transformation_matrix = SGMatrix<float64_t>(num_old_dim, num_dim);
+	Map<MatrixXd>(m_transformation_matrix.matrix, num_old_dim, num_dim) = basis;
+
+	if (m_whitening)
+		whiten(m_eigenvalues_vector, num_vectors);
+}
+
+void CPCA::whiten(const SGVector<float64_t>& eigenvalues, int32_t num_vectors)
+{
+	Map<MatrixXd> transform_matrix(
+	    m_transformation_matrix.matrix, m_transformation_matrix.num_rows,
+	    m_transformation_matrix.num_cols);
+	for (int32_t i = 0; i < num_dim; i++)
+	{
+		if (CMath::fequals_abs<float64_t>(
+		        0.0, eigenvalues[i], m_eigenvalue_zero_tolerance))
+		{
+			SG_WARNING(
+			    "Covariance matrix has almost zero Eigenvalue (ie "
+			    "Eigenvalue within a tolerance of %E around 0) at "
+			    "dimension %d. Consider reducing its dimension.\n",
+			    m_eigenvalue_zero_tolerance, i + 1)
+
+			transform_matrix.col(i).setZero();
+			continue;
 		}
+
+		transform_matrix.col(i) /= std::sqrt(eigenvalues[i] * (num_vectors - 1));
 	}
 }
 
@@ -409,3 +571,39 @@ int32_t CPCA::get_target_dim() const
 {
 	return m_target_dim;
 }
+
+void CPCA::set_oversampling(int32_t oversampling)
+{
+	REQUIRE(oversampling >= 0, "Oversampling (%d) must be non-negative\n", oversampling)
+	m_oversampling = oversampling;
+}
+
+int32_t CPCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void CPCA::set_num_power_iterations(int32_t num_power_iterations)
+{
+	REQUIRE(
+	    num_power_iterations >= 0,
+	    "Number of power iterations (%d) must be non-negative\n",
+	    num_power_iterations)
+	m_num_power_iterations = num_power_iterations;
+}
+
+int32_t CPCA::get_num_power_iterations() const
+{
+	return m_num_power_iterations;
+}
+
+void CPCA::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size > 0, "Batch size (%d) must be positive\n", batch_size)
+	m_batch_size = batch_size;
+}
+
+int32_t CPCA::get_batch_size() const
+{
+	return m_batch_size;
+}
@@ -13,6 +13,7 @@
 
 #include <shogun/features/Features.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -29,7 +30,12 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized subspace iteration for the top components only, FIXED_NUMBER
+	 * mode only. Time complexity ~(2q+2)dnl with l=target_dim+oversampling
+	 * and q power iterations
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -83,9 +89,22 @@ enum EPCAMemoryMode
  * using the formula \f$e_i = \frac{\sqrt{d_i}}{N-1}\f$.
  * The time complexity of this method is \f$~14DN^2\f$ and should be used when N < D.
  *
+ * <em>RANDOMIZED</em> : Randomized SVD (Halko et al., 2011) of the feature matrix.
+ * The range of \f$XX^T\f$ is approximated by a few power iterations on a random
+ * \f$D\times(T+p)\f$ matrix, with p oversampling dimensions, and the components
+ * are computed from the projection of X on that subspace. Only the top T
+ * eigenvalues are computed, so it requires FIXED_NUMBER mode.
+ * The time complexity of this method is \f$~(2q+2)DN(T+p)\f$ for q power
+ * iterations and should be used when only few components of a large matrix
+ * are needed.
+ *
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
+ * When fitted with CStreamingDenseFeatures, the components are updated
+ * incrementally from batches of the stream (Ross et al., 2008), so the data
+ * never has to be in memory at once. This requires FIXED_NUMBER mode.
+ *
  * This class provides 3 modes to determine the value of T :
  *
  * <em>FIXED_NUMBER</em> : T is supplied by user directly using set_target_dims method
@@ -104,7 +123,7 @@ enum EPCAMemoryMode
  *
  * Note that vectors/matrices don't have to have zero mean as it is substracted within the class.
  */
-class CPCA : public CDensePreprocessor<float64_t>
+class CPCA : public RandomMixin<CDensePreprocessor<float64_t>>
 {
 	public:
 
@@ -183,6 +202,30 @@ class CPCA : public CDensePreprocessor<float64_t>
 		 */
 		void set_target_dim(int32_t dim);
 
+		/** set number of oversampling dimensions of RANDOMIZED method
+		 * @param oversampling number of additional random dimensions
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** @return number of oversampling dimensions of RANDOMIZED method */
+		int32_t get_oversampling() const;
+
+		/** set number of power iterations of RANDOMIZED method
+		 * @param num_power_iterations number of power iterations
+		 */
+		void set_num_power_iterations(int32_t num_power_iterations);
+
+		/** @return number of power iterations of RANDOMIZED method */
+		int32_t get_num_power_iterations() const;
+
+		/** set number of vectors per batch when fitting streaming features
+		 * @param batch_size number of vectors per batch
+		 */
+		void set_batch_size(int32_t batch_size);
+
+		/** @return number of vectors per batch when fitting streaming features */
+		int32_t get_batch_size() const;
+
 		/** getter for target dimension
 		 * @return target dimension
 		 */
@@ -225,11 +268,32 @@ class CPCA : public CDensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** oversampling dimensions of RANDOMIZED method */
+		int32_t m_oversampling;
+
+		/** power iterations of RANDOMIZED method */
+		int32_t m_num_power_iterations;
+
+		/** vectors per batch when fitting streaming features */
+		int32_t m_batch_size;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized svd */
+		void init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix);
+		/** Computes the transformation matrix incrementally from batches of
+		 * streaming features */
+		void fit_streaming(CFeatures* features);
+		/** Divides the columns of the transformation matrix by the singular
+		 * values of the centered data, see whitening
+		 *
+		 * @param eigenvalues covariance eigenvalues of the columns
+		 * @param num_vectors number of vectors of the data
+		 */
+		void whiten(const SGVector<float64_t>& eigenvalues, int32_t num_vectors);
 };
 }
 #endif // PCA_H_
@@ -44,12 +44,13 @@ bool CSortUlongString::save(FILE* f)
 
 void CSortUlongString::apply_to_string_list(std::vector<SGVector<uint64_t>>& string_list)
 {
-	for (auto& vec : string_list)
-	{
-		SG_DEBUG("sorting string of length %i\n", vec.vlen);
+	const int64_t num_strings=string_list.size();
 
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int64_t i=0; i<num_strings; i++)
+	{
 		//CMath::qsort(vec, len);
-		CMath::radix_sort(vec.vector, vec.vlen);
+		CMath::radix_sort(string_list[i].vector, string_list[i].vlen);
 	}
 }
 
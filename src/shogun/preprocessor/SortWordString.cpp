@@ -43,10 +43,13 @@ bool CSortWordString::save(FILE* f)
 
 void CSortWordString::apply_to_string_list(std::vector<SGVector<uint16_t>>& string_list)
 {
-	for (auto& vec : string_list)
+	const int64_t num_strings=string_list.size();
+
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int64_t i=0; i<num_strings; i++)
 	{
 		//CMath::qsort(vec, len);
-		CMath::radix_sort(vec.vector, vec.vlen);
+		CMath::radix_sort(string_list[i].vector, string_list[i].vlen);
 	}
 }
 
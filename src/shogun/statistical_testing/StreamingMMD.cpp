@@ -35,6 +35,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/CombinedKernel.h>
+#include <shogun/distance/CustomDistance.h>
 #include <shogun/features/Features.h>
 #include <shogun/statistical_testing/TestEnums.h>
 #include <shogun/statistical_testing/MMD.h>
@@ -65,6 +66,8 @@ struct CStreamingMMD::Self
 
 	void merge_samples(NextSamples&, std::vector<CFeatures*>&) const;
 	void compute_kernel(ComputationManager&, std::vector<CFeatures*>&, CKernel*) const;
+	void compute_distance(std::vector<CFeatures*>&, const KernelManager&, std::vector<std::shared_ptr<CCustomDistance> >&) const;
+	void compute_kernel(ComputationManager&, std::vector<std::shared_ptr<CCustomDistance> >&, const KernelManager&, index_t) const;
 	void compute_jobs(ComputationManager&) const;
 
 	std::pair<float64_t, float64_t> compute_statistic_variance();
@@ -173,6 +176,32 @@ void CStreamingMMD::Self::compute_kernel(ComputationManager& cm, std::vector<CFe
 	}
 }
 
+void CStreamingMMD::Self::compute_distance(std::vector<CFeatures*>& blocks, const KernelManager& kernel_mgr,
+	std::vector<std::shared_ptr<CCustomDistance> >& distances) const
+{
+	distances.resize(blocks.size());
+#pragma omp parallel for
+	for (int64_t i=0; i<(int64_t)blocks.size(); ++i)
+	{
+		auto distance=kernel_mgr.get_distance_instance();
+		distance->init(blocks[i], blocks[i]);
+		auto precomputed_distance=new CCustomDistance(distance);
+		SG_REF(precomputed_distance);
+		distances[i]=std::shared_ptr<CCustomDistance>(precomputed_distance, [](CCustomDistance* ptr) { SG_UNREF(ptr); });
+		distance->remove_lhs_and_rhs();
+		SG_UNREF(distance);
+	}
+}
+
+void CStreamingMMD::Self::compute_kernel(ComputationManager& cm, std::vector<std::shared_ptr<CCustomDistance> >& distances,
+	const KernelManager& kernel_mgr, index_t k) const
+{
+	cm.num_data(distances.size());
+#pragma omp parallel for
+	for (int64_t i=0; i<(int64_t)distances.size(); ++i)
+		cm.data(i)=kernel_mgr.kernel_matrix_at(k, distances[i].get());
+}
+
 void CStreamingMMD::Self::compute_jobs(ComputationManager& cm) const
 {
 	if (use_gpu)
@@ -195,7 +224,7 @@ std::pair<float64_t, float64_t> CStreamingMMD::Self::compute_statistic_variance(
 
 	DataManager& data_mgr=owner.get_data_mgr();
 	data_mgr.start();
-	auto next_burst=data_mgr.next();
+	auto next_burst=data_mgr.next(true);
 	if (!next_burst.empty())
 	{
 		ComputationManager cm;
@@ -241,7 +270,7 @@ std::pair<float64_t, float64_t> CStreamingMMD::Self::compute_statistic_variance(
 					variance_term_counter++;
 				}
 			}
-			next_burst=data_mgr.next();
+			next_burst=data_mgr.next(true);
 		}
 		cm.done();
 	}
@@ -281,8 +310,13 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 	create_computation_jobs();
 	cm.enqueue_job(statistic_job);
 
+	// shift-invariant kernels with the same distance share the distances
+	// between the samples of each block
+	const bool share_distance=kernel_selection_mgr.same_distance_type();
+	std::vector<std::shared_ptr<CCustomDistance> > distances;
+
 	data_mgr.start();
-	auto next_burst=data_mgr.next();
+	auto next_burst=data_mgr.next(true);
 	std::vector<CFeatures*> blocks;
 	std::vector<std::vector<float32_t> > mmds(num_kernels);
 	while (!next_burst.empty())
@@ -293,10 +327,14 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 				num_blocks);
 		merge_samples(next_burst, blocks);
 		std::for_each(blocks.begin(), blocks.end(), [](CFeatures* ptr) { SG_REF(ptr); });
+		if (share_distance)
+			compute_distance(blocks, kernel_selection_mgr, distances);
 		for (auto k=0; k<num_kernels; ++k)
 		{
-			CKernel* kernel=kernel_selection_mgr.kernel_at(k);
-			compute_kernel(cm, blocks, kernel);
+			if (share_distance)
+				compute_kernel(cm, distances, kernel_selection_mgr, k);
+			else
+				compute_kernel(cm, blocks, kernel_selection_mgr.kernel_at(k));
 			compute_jobs(cm);
 			mmds[k]=cm.result(0);
 			for (auto i=0; i<num_blocks; ++i)
@@ -307,6 +345,7 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 		}
 		std::for_each(blocks.begin(), blocks.end(), [](CFeatures* ptr) { SG_UNREF(ptr); });
 		blocks.resize(0);
+		distances.resize(0);
 		for (auto i=0; i<num_kernels; ++i)
 		{
 			for (auto j=0; j<=i; ++j)
@@ -319,7 +358,7 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > CStreamingMMD::Self::comput
 				Q(j, i)=Q(i, j);
 			}
 		}
-		next_burst=data_mgr.next();
+		next_burst=data_mgr.next(true);
 	}
 	mmds.clear();
 
@@ -354,7 +393,7 @@ SGVector<float64_t> CStreamingMMD::Self::sample_null()
 	std::vector<CFeatures*> blocks;
 
 	data_mgr.start();
-	auto next_burst=data_mgr.next();
+	auto next_burst=data_mgr.next(true);
 
 	while (!next_burst.empty())
 	{
@@ -373,7 +412,7 @@ SGVector<float64_t> CStreamingMMD::Self::sample_null()
 				term_counters[j]++;
 			}
 		}
-		next_burst=data_mgr.next();
+		next_burst=data_mgr.next(true);
 	}
 
 	data_mgr.end();
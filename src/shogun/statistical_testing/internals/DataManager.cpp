@@ -28,6 +28,7 @@
  * either expressed or implied, of the Shogun Development Team.
  */
 
+#include <future>
 #include <memory>
 #include <shogun/io/SGIO.h>
 #include <shogun/features/Features.h>
@@ -390,6 +391,7 @@ void DataManager::start()
 	SG_SDEBUG("Entering!\n");
 	REQUIRE(fetchers.size()>0, "Features are not set!");
 
+	discard_prefetched();
 	if (train_test_mode && !cross_validation_mode)
 		init_active_subset();
 
@@ -398,7 +400,24 @@ void DataManager::start()
 	SG_SDEBUG("Leaving!\n");
 }
 
-NextSamples DataManager::next()
+NextSamples DataManager::next(bool prefetch_next)
+{
+	SG_SDEBUG("Entering!\n");
+	NextSamples next_samples=prefetched.valid() ? prefetched.get() : fetch_next();
+	if (prefetch_next && !next_samples.empty())
+		prefetched=std::async(std::launch::async, [this]() { return fetch_next(); });
+	SG_SDEBUG("Leaving!\n");
+	return next_samples;
+}
+
+void DataManager::discard_prefetched()
+{
+	// waits for a running fetch, the fetched blocks are released
+	if (prefetched.valid())
+		prefetched.get();
+}
+
+NextSamples DataManager::fetch_next()
 {
 	SG_SDEBUG("Entering!\n");
 
@@ -432,6 +451,7 @@ void DataManager::end()
 {
 	SG_SDEBUG("Entering!\n");
 	REQUIRE(fetchers.size()>0, "Features are not set!");
+	discard_prefetched();
 	typedef std::unique_ptr<DataFetcher> fetcher_type;
 	std::for_each(fetchers.begin(), fetchers.end(), [](fetcher_type& f) { f->end(); });
 	SG_SDEBUG("Leaving!\n");
@@ -441,6 +461,7 @@ void DataManager::reset()
 {
 	SG_SDEBUG("Entering!\n");
 	REQUIRE(fetchers.size()>0, "Features are not set!");
+	discard_prefetched();
 	typedef std::unique_ptr<DataFetcher> fetcher_type;
 	std::for_each(fetchers.begin(), fetchers.end(), [](fetcher_type& f) { f->reset(); });
 	SG_SDEBUG("Leaving!\n");
@@ -33,7 +33,9 @@
 
 #include <vector>
 #include <memory>
+#include <future>
 #include <shogun/statistical_testing/internals/InitPerFeature.h>
+#include <shogun/statistical_testing/internals/NextSamples.h>
 #include <shogun/lib/common.h>
 
 namespace shogun
@@ -213,12 +215,23 @@ public:
 	void init_active_subset();
 
 	void start();
-	NextSamples next();
+	/**
+	 * Fetches the next burst of blocks.
+	 *
+	 * @param prefetch_next whether to fetch the burst after this one on a
+	 * background thread while the caller processes the returned one
+	 * @return the next burst, empty if there are no more samples
+	 */
+	NextSamples next(bool prefetch_next=false);
 	void end();
 	void reset();
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 private:
+	NextSamples fetch_next();
+	void discard_prefetched();
+
 	std::vector<std::unique_ptr<DataFetcher> > fetchers;
+	std::future<NextSamples> prefetched;
 
 	bool train_test_mode; // -> if ON, then train/test/fold subset is used (in start()) in end() method, we remove these subsets.
 	bool cross_validation_mode; // -> if ON, then shuffle subset is used, remove it after train_test mode in end()
@@ -38,6 +38,7 @@
 #include <shogun/distance/ManhattanMetric.h>
 #include <shogun/kernel/ShiftInvariantKernel.h>
 #include <shogun/statistical_testing/internals/KernelManager.h>
+#include <shogun/util/hash.h>
 
 using namespace shogun;
 using namespace internal;
@@ -63,6 +64,7 @@ KernelManager::~KernelManager()
 
 void KernelManager::clear()
 {
+	clear_kernel_copies();
 	m_kernels.resize(0);
 	m_precomputed_kernels.resize(0);
 }
@@ -227,3 +229,98 @@ void KernelManager::unset_precomputed_distance() const
 		shift_inv_kernel->num_rhs=0;
 	}
 }
+
+SGMatrix<float32_t> KernelManager::kernel_matrix_at(index_t i, CCustomDistance* distance) const
+{
+	REQUIRE(distance!=nullptr, "Distance instance cannot be null!\n");
+	CKernel* kernel=kernel_at(i);
+	REQUIRE(dynamic_cast<CShiftInvariantKernel*>(kernel)!=nullptr,
+		"Kernel instance (was %s) must be of CShiftInvarintKernel type!\n", kernel->get_name());
+
+	auto shift_inv_kernel=acquire_kernel_copy(i);
+	shift_inv_kernel->m_precomputed_distance=distance;
+	shift_inv_kernel->num_lhs=distance->get_num_vec_lhs();
+	shift_inv_kernel->num_rhs=distance->get_num_vec_rhs();
+
+	const auto num_lhs=shift_inv_kernel->num_lhs;
+	const auto num_rhs=shift_inv_kernel->num_rhs;
+	SGMatrix<float32_t> kernel_matrix(num_lhs, num_rhs);
+	if (num_lhs==num_rhs)
+	{
+		for (auto j=0; j<num_rhs; ++j)
+		{
+			for (auto k=j; k<num_lhs; ++k)
+			{
+				kernel_matrix(k, j)=shift_inv_kernel->kernel(k, j);
+				kernel_matrix(j, k)=kernel_matrix(k, j);
+			}
+		}
+	}
+	else
+	{
+		for (auto j=0; j<num_rhs; ++j)
+		{
+			for (auto k=0; k<num_lhs; ++k)
+				kernel_matrix(k, j)=shift_inv_kernel->kernel(k, j);
+		}
+	}
+
+	// the distance is owned by the caller
+	shift_inv_kernel->m_precomputed_distance=nullptr;
+	shift_inv_kernel->num_lhs=0;
+	shift_inv_kernel->num_rhs=0;
+	release_kernel_copy(i, shift_inv_kernel);
+	return kernel_matrix;
+}
+
+CShiftInvariantKernel* KernelManager::acquire_kernel_copy(index_t i) const
+{
+	CKernel* kernel=kernel_at(i);
+	{
+		std::lock_guard<std::mutex> lock(m_kernel_copies_mutex);
+		if ((index_t)m_kernel_copies.size()<num_kernels())
+			m_kernel_copies.resize(num_kernels(), KernelCopies{nullptr, {}});
+
+		// copies of a replaced or modified kernel are stale
+		auto& copies=m_kernel_copies[i];
+		if (copies.kernel!=kernel || (!copies.idle.empty() &&
+			!hyperparameter_equals(copies.idle.back(), kernel)))
+		{
+			for (auto copy : copies.idle)
+				SG_UNREF(copy);
+			copies.idle.clear();
+			copies.kernel=kernel;
+		}
+
+		if (!copies.idle.empty())
+		{
+			auto copy=copies.idle.back();
+			copies.idle.pop_back();
+			return copy;
+		}
+	}
+
+	auto copy=make_clone(static_cast<CShiftInvariantKernel*>(kernel));
+	copy->remove_lhs_and_rhs();
+	return copy;
+}
+
+void KernelManager::release_kernel_copy(index_t i, CShiftInvariantKernel* copy) const
+{
+	std::lock_guard<std::mutex> lock(m_kernel_copies_mutex);
+	if (m_kernel_copies[i].kernel==kernel_at(i))
+		m_kernel_copies[i].idle.push_back(copy);
+	else
+		SG_UNREF(copy);
+}
+
+void KernelManager::clear_kernel_copies() const
+{
+	std::lock_guard<std::mutex> lock(m_kernel_copies_mutex);
+	for (auto& copies : m_kernel_copies)
+	{
+		for (auto copy : copies.idle)
+			SG_UNREF(copy);
+	}
+	m_kernel_copies.clear();
+}
@@ -33,7 +33,9 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/statistical_testing/internals/InitPerKernel.h>
 
 namespace shogun
@@ -43,6 +45,7 @@ class CKernel;
 class CDistance;
 class CCustomDistance;
 class CCustomKernel;
+class CShiftInvariantKernel;
 
 namespace internal
 {
@@ -68,9 +71,40 @@ public:
 	CDistance* get_distance_instance() const;
 	void set_precomputed_distance(CCustomDistance* distance) const;
 	void unset_precomputed_distance() const;
+
+	/**
+	 * Computes the kernel matrix of the i-th (shift-invariant) kernel from a
+	 * precomputed distance. The kernel itself is not modified, so this can
+	 * be called for different distances, e.g. of different blocks, in parallel.
+	 * Every concurrent call uses its own copy of the kernel, which is kept for
+	 * later calls as long as the kernel and its hyperparameters are unchanged.
+	 *
+	 * @param i the index of the kernel
+	 * @param distance the precomputed distance
+	 * @return the kernel matrix
+	 */
+	SGMatrix<float32_t> kernel_matrix_at(index_t i, CCustomDistance* distance) const;
 private:
+	/** copies of a kernel that are not in use by kernel_matrix_at() */
+	struct KernelCopies
+	{
+		CKernel* kernel;
+		std::vector<CShiftInvariantKernel*> idle;
+	};
+
+	/** @return an idle copy of the i-th kernel, SG_REF'ed, or a new one */
+	CShiftInvariantKernel* acquire_kernel_copy(index_t i) const;
+
+	/** puts a copy of the i-th kernel back to the idle ones */
+	void release_kernel_copy(index_t i, CShiftInvariantKernel* copy) const;
+
+	/** SG_UNREF's all copies of the kernels */
+	void clear_kernel_copies() const;
+
 	std::vector<std::shared_ptr<CKernel> > m_kernels;
 	std::vector<std::shared_ptr<CCustomKernel> > m_precomputed_kernels;
+	mutable std::vector<KernelCopies> m_kernel_copies;
+	mutable std::mutex m_kernel_copies_mutex;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
@@ -87,6 +87,15 @@ struct PermutationMMD : ComputeMMD
 		return null_samples;
 	}
 
+	template <typename T, class PRNG>
+	SGVector<float32_t> operator()(const SGMatrix<T>& kernel_matrix, PRNG& prng)
+	{
+		ASSERT(m_n_x>0 && m_n_y>0);
+		ASSERT(m_num_null_samples>0);
+		precompute_permutation_inds(prng);
+		return compute_null_samples(kernel_matrix);
+	}
+
 	template <class PRNG>
 	SGMatrix<float32_t> operator()(const KernelManager& kernel_mgr, PRNG& prng)
 	{
@@ -96,41 +105,13 @@ struct PermutationMMD : ComputeMMD
 
 		const index_t size=m_n_x+m_n_y;
 		SGMatrix<float32_t> null_samples(m_num_null_samples, kernel_mgr.num_kernels());
-		SGVector<float32_t> km(size*(size+1)/2);
+		PackedKernelMatrix km(size);
 		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
 		{
-			auto kernel=kernel_mgr.kernel_at(k);
-			terms_t terms;
-			for (auto i=0; i<size; ++i)
-			{
-				for (auto j=i; j<size; ++j)
-				{
-					auto index=i*size-i*(i+1)/2+j;
-					km[index]=kernel->kernel(i, j);
-				}
-			}
-
-#pragma omp parallel for
-			for (auto n=0; n<m_num_null_samples; ++n)
-			{
-				terms_t null_terms;
-				for (auto i=0; i<size; ++i)
-				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-					auto index_base=i*size-i*(i+1)/2;
-					for (auto j=i; j<size; ++j)
-					{
-						auto index=index_base+j;
-						auto inverted_col=m_inverted_permuted_inds(j, n);
-
-						if (inverted_row<=inverted_col)
-							add_term_upper(null_terms, km[index], inverted_row, inverted_col);
-						else
-							add_term_upper(null_terms, km[index], inverted_col, inverted_row);
-					}
-				}
-				null_samples(n, k)=compute(null_terms);
-			}
+			precompute_kernel_matrix(kernel_mgr.kernel_at(k), km);
+			auto kernel_null_samples=compute_null_samples_lower(km);
+			std::copy(kernel_null_samples.data(), kernel_null_samples.data()+m_num_null_samples,
+				null_samples.get_column_vector(k));
 		}
 		return null_samples;
 	}
@@ -151,52 +132,190 @@ struct PermutationMMD : ComputeMMD
 		precompute_permutation_inds(prng);
 
 		const index_t size=m_n_x+m_n_y;
-		SGVector<float32_t> null_samples(m_num_null_samples);
 		SGVector<float64_t> result(kernel_mgr.num_kernels());
 
-		SGVector<float32_t> km(size*(size+1)/2);
+		PackedKernelMatrix km(size);
 		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
 		{
-			auto kernel=kernel_mgr.kernel_at(k);
-			terms_t terms;
-			for (auto i=0; i<size; ++i)
+			precompute_kernel_matrix(kernel_mgr.kernel_at(k), km);
+			float32_t statistic=ComputeMMD::operator()(km);
+			SG_SDEBUG("Kernel(%d): statistic=%f\n", k, statistic);
+
+			auto null_samples=compute_null_samples_lower(km);
+			result[k]=compute_p_value(null_samples, statistic);
+			SG_SDEBUG("Kernel(%d): p_value=%f\n", k, result[k]);
+		}
+
+		return result;
+	}
+
+	/**
+	 * Lower triangle of a symmetric kernel matrix, packed column by
+	 * column, which takes half the memory of the full matrix.
+	 */
+	struct PackedKernelMatrix
+	{
+		PackedKernelMatrix(index_t n) : size(n), values(int64_t(n)*(n+1)/2)
+		{
+		}
+
+		/** @return offset of column j, element (i, j) is at offset+i */
+		inline int64_t column_offset(index_t j) const
+		{
+			return int64_t(j)*size-int64_t(j)*(j-1)/2-j;
+		}
+
+		inline float32_t operator()(index_t i, index_t j) const
+		{
+			return i>=j ? values[column_offset(j)+i] : values[column_offset(i)+j];
+		}
+
+		index_t size;
+		SGVector<float32_t> values;
+	};
+
+	/**
+	 * Computes the null samples of all precomputed permutations from the
+	 * full kernel matrix, see compute_null_samples_lower().
+	 *
+	 * @param kernel_matrix the kernel matrix of the joint samples
+	 * @return the null samples
+	 */
+	template <typename T>
+	SGVector<float32_t> compute_null_samples(const SGMatrix<T>& kernel_matrix) const
+	{
+		const index_t size=m_n_x+m_n_y;
+		REQUIRE(kernel_matrix.num_rows==size && kernel_matrix.num_cols==size,
+			"Kernel matrix (%dx%d) does not match the total number of samples (%d)!\n",
+			kernel_matrix.num_rows, kernel_matrix.num_cols, size);
+		return compute_null_samples_lower(kernel_matrix);
+	}
+
+	/**
+	 * Computes the null samples of all precomputed permutations from the
+	 * lower triangle of the kernel matrix. With the membership vector b of
+	 * the samples that a permutation assigns to p, all terms follow from
+	 * b'Kb, the row sums and the diagonal of K. b'Kb is computed for blocks
+	 * of permutations at once as products of cache sized tiles of K with
+	 * their membership matrix, instead of gathering single kernel values
+	 * per permutation. Every tile below the diagonal is used for itself and
+	 * its transpose, so only the lower triangle of K is read.
+	 *
+	 * @param km the kernel matrix of the joint samples, either a SGMatrix
+	 * or a PackedKernelMatrix
+	 * @return the null samples
+	 */
+	template <class Matrix>
+	SGVector<float32_t> compute_null_samples_lower(const Matrix& km) const
+	{
+		const index_t size=m_n_x+m_n_y;
+
+		// cast to 64 bit to avoid overflows
+		Eigen::VectorXd row_sums=Eigen::VectorXd::Zero(size);
+		Eigen::VectorXd diag(size);
+		for (index_t j=0; j<size; ++j)
+		{
+			diag[j]=km(j, j);
+			row_sums[j]+=diag[j];
+			for (index_t i=j+1; i<size; ++i)
 			{
-				for (auto j=i; j<size; ++j)
+				const float64_t value=km(i, j);
+				row_sums[i]+=value;
+				row_sums[j]+=value;
+			}
+		}
+		const float64_t total=row_sums.sum();
+		const float64_t total_diag=diag.sum();
+
+		const index_t num_blocks=(m_num_null_samples+permutation_block_size-1)/permutation_block_size;
+		SGVector<float32_t> null_samples(m_num_null_samples);
+#pragma omp parallel for schedule(dynamic)
+		for (index_t block=0; block<num_blocks; ++block)
+		{
+			const index_t first=block*permutation_block_size;
+			const index_t num=std::min(permutation_block_size, m_num_null_samples-first);
+
+			Eigen::MatrixXd membership(size, num);
+			for (index_t n=0; n<num; ++n)
+			{
+				for (index_t i=0; i<size; ++i)
+					membership(i, n)=m_inverted_permuted_inds(i, first+n)<m_n_x;
+			}
+
+			Eigen::MatrixXd products=Eigen::MatrixXd::Zero(size, num);
+			Eigen::MatrixXd tile;
+			for (index_t j=0; j<size; j+=kernel_tile_size)
+			{
+				const index_t cols=std::min(kernel_tile_size, size-j);
+				for (index_t i=j; i<size; i+=kernel_tile_size)
 				{
-					auto index=i*size-i*(i+1)/2+j;
-					km[index]=kernel->kernel(i, j);
-					add_term_upper(terms, km[index], i, j);
+					const index_t rows=std::min(kernel_tile_size, size-i);
+					tile.resize(rows, cols);
+					for (index_t c=0; c<cols; ++c)
+					{
+						for (index_t r=i==j ? c : 0; r<rows; ++r)
+							tile(r, c)=km(i+r, j+c);
+					}
+
+					if (i==j)
+					{
+						products.middleRows(i, rows).noalias()+=
+							tile.selfadjointView<Eigen::Lower>()*membership.middleRows(j, cols);
+					}
+					else
+					{
+						products.middleRows(i, rows).noalias()+=tile*membership.middleRows(j, cols);
+						products.middleRows(j, cols).noalias()+=tile.transpose()*membership.middleRows(i, rows);
+					}
 				}
 			}
-			float32_t statistic=compute(terms);
-			SG_SDEBUG("Kernel(%d): statistic=%f\n", k, statistic);
 
-#pragma omp parallel for
-			for (auto n=0; n<m_num_null_samples; ++n)
+			SGVector<index_t> permuted_inds;
+			for (index_t n=0; n<num; ++n)
 			{
-				terms_t null_terms;
-				for (auto i=0; i<size; ++i)
+				const float64_t s_xx=membership.col(n).dot(products.col(n));
+				const float64_t r_x=membership.col(n).dot(row_sums);
+				const float64_t d_x=membership.col(n).dot(diag);
+
+				terms_t terms;
+				terms.diag[0]=d_x;
+				terms.diag[1]=total_diag-d_x;
+				terms.term[0]=(s_xx+terms.diag[0])/2;
+				terms.term[1]=(total-2*r_x+s_xx+terms.diag[1])/2;
+				terms.term[2]=r_x-s_xx;
+
+				// the cross diagonal depends on the positions of the samples
+				if (m_stype==ST_UNBIASED_INCOMPLETE)
 				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-					auto index_base=i*size-i*(i+1)/2;
-					for (auto j=i; j<size; ++j)
+					if (permuted_inds.size()!=size)
+						permuted_inds=SGVector<index_t>(size);
+					for (index_t i=0; i<size; ++i)
+						permuted_inds[m_inverted_permuted_inds(i, first+n)]=i;
+					for (index_t i=0; i<m_n_x && i+m_n_x<size; ++i)
 					{
-						auto index=index_base+j;
-						auto inverted_col=m_inverted_permuted_inds(j, n);
-
-						if (inverted_row<=inverted_col)
-							add_term_upper(null_terms, km[index], inverted_row, inverted_col);
-						else
-							add_term_upper(null_terms, km[index], inverted_col, inverted_row);
+						const index_t row=std::max(permuted_inds[i], permuted_inds[i+m_n_x]);
+						const index_t col=std::min(permuted_inds[i], permuted_inds[i+m_n_x]);
+						terms.diag[2]+=km(row, col);
 					}
 				}
-				null_samples[n]=compute(null_terms);
+
+				null_samples[first+n]=compute(terms);
+				SG_SDEBUG("null_samples[%d] = %f!\n", first+n, null_samples[first+n]);
 			}
-			result[k]=compute_p_value(null_samples, statistic);
-			SG_SDEBUG("Kernel(%d): p_value=%f\n", k, result[k]);
 		}
+		return null_samples;
+	}
 
-		return result;
+	inline void precompute_kernel_matrix(CKernel* kernel, PackedKernelMatrix& km) const
+	{
+		const index_t size=km.size;
+#pragma omp parallel for schedule(dynamic)
+		for (index_t j=0; j<size; ++j)
+		{
+			const auto offset=km.column_offset(j);
+			for (index_t i=j; i<size; ++i)
+				km.values[offset+i]=kernel->kernel(i, j);
+		}
 	}
 
 	template <class PRNG>
@@ -238,6 +357,11 @@ struct PermutationMMD : ComputeMMD
 			m_all_inds=SGMatrix<index_t>(size, m_num_null_samples);
 	}
 
+	/** number of permutations that share the kernel tiles */
+	static constexpr index_t permutation_block_size=64;
+	/** number of rows and columns of a kernel tile */
+	static constexpr index_t kernel_tile_size=256;
+
 	index_t m_num_null_samples;
 	bool m_save_inds;
 	SGVector<index_t> m_permuted_inds;
@@ -9,6 +9,8 @@
 
 #include <shogun/base/SGObject.h>
 
+#include <string>
+
 namespace std
 {
 	template<> struct hash<shogun::CSGObject>
@@ -28,4 +30,85 @@ namespace std
 	};
 }
 
+namespace shogun
+{
+	/** Computes a hash of the type and all hyperparameters of an object,
+	 * recursing into hyperparameters that are objects themselves, i.e.
+	 * objects are compared by their hyperparameters and not their address.
+	 *
+	 * @param obj object to hash
+	 * @param exclude name of a hyperparameter of obj to leave out
+	 * @return hash value
+	 */
+	inline size_t hyperparameter_hash(
+	    const CSGObject* obj, const std::string& exclude = "")
+	{
+		size_t seed = std::hash<std::string>{}(obj->get_name());
+		auto combine = [&seed](size_t value) {
+			seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		};
+
+		for (const auto& param : obj->get_params())
+		{
+			if (param.first == exclude ||
+			    !param.second->get_properties().has_property(
+			        ParameterProperties::HYPER))
+				continue;
+
+			combine(std::hash<std::string>{}(param.first));
+
+			auto nested = obj->get(param.first, std::nothrow);
+			if (nested)
+				combine(hyperparameter_hash(nested));
+			else
+				combine(param.second->get_value().hash());
+		}
+
+		return seed;
+	}
+
+	/** Compares the type and all hyperparameters of two objects, recursing
+	 * into hyperparameters that are objects themselves, i.e. the exact
+	 * counterpart of hyperparameter_hash.
+	 *
+	 * @param a first object
+	 * @param b second object
+	 * @param exclude name of a hyperparameter to leave out
+	 * @return whether the hyperparameters are equal
+	 */
+	inline bool hyperparameter_equals(
+	    const CSGObject* a, const CSGObject* b, const std::string& exclude = "")
+	{
+		if (a == b)
+			return true;
+		if (!a || !b || std::string(a->get_name()) != b->get_name())
+			return false;
+
+		auto params_b = b->get_params();
+		for (const auto& param : a->get_params())
+		{
+			if (param.first == exclude ||
+			    !param.second->get_properties().has_property(
+			        ParameterProperties::HYPER))
+				continue;
+
+			auto other = params_b.find(param.first);
+			if (other == params_b.end())
+				return false;
+
+			auto nested = a->get(param.first, std::nothrow);
+			if (nested)
+			{
+				if (!hyperparameter_equals(
+				        nested, b->get(param.first, std::nothrow)))
+					return false;
+			}
+			else if (param.second->get_value() != other->second->get_value())
+				return false;
+		}
+
+		return true;
+	}
+}
+
 #endif
@@ -0,0 +1,71 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/classifier/mkl/MKLClassification.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/CombinedFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+static SGVector<float64_t> train_mkl_weights(int32_t row_cache_size)
+{
+	const index_t num_vec = 60;
+	const index_t dim = 2;
+
+	std::mt19937_64 prng(23);
+	NormalDistribution<float64_t> randn;
+
+	SGMatrix<float64_t> X(dim, num_vec);
+	SGVector<float64_t> y(num_vec);
+	for (auto i : range(num_vec))
+	{
+		y[i] = i % 2 ? 1 : -1;
+		for (auto j : range(dim))
+			X(j, i) = randn(prng) + y[i];
+	}
+
+	auto features = new CDenseFeatures<float64_t>(X);
+	auto combined_features = new CCombinedFeatures();
+	auto kernel = new CCombinedKernel();
+	for (auto width : {0.1, 1.0, 10.0})
+	{
+		combined_features->append_feature_obj(features);
+		kernel->append_kernel(new CGaussianKernel(width));
+	}
+	kernel->init(combined_features, combined_features);
+
+	auto mkl = new CMKLClassification(new CLibSVM());
+	SG_REF(mkl);
+	mkl->set_interleaved_optimization_enabled(false);
+	mkl->set_mkl_norm(2);
+	mkl->set_solver_type(ST_DIRECT);
+	mkl->set_row_cache_size(row_cache_size);
+	mkl->set_kernel(kernel);
+	mkl->set_labels(new CBinaryLabels(y));
+	mkl->train();
+
+	auto weights = kernel->get_subkernel_weights().clone();
+	SG_UNREF(mkl);
+
+	return weights;
+}
+
+TEST(MKLClassification, row_cache_same_result)
+{
+	auto uncached = train_mkl_weights(0);
+	auto cached = train_mkl_weights(256);
+
+	ASSERT_EQ(uncached.vlen, cached.vlen);
+	for (auto i : range(cached.vlen))
+		EXPECT_NEAR(uncached[i], cached[i], 1e-10);
+}
@@ -446,3 +446,34 @@ TEST_F(LibLinear, simple_set_train_L2R_LR_DUAL_BIAS)
 	// bias, not l1
 	train_with_solver_simple(liblinear_solver_type, true, false, t_w);
 }
+TEST_F(LibLinear, warm_start_train_L2R_LR)
+{
+	generate_data_l2();
+
+	auto cold = some<CLibLinear>(L2R_LR);
+	cold->set_bias_enabled(true);
+	cold->set_epsilon(1e-6);
+	cold->set_C(1.2, 1.2);
+	cold->set_features(train_feats);
+	cold->set_labels(ground_truth);
+	cold->train();
+
+	auto warm = some<CLibLinear>(L2R_LR);
+	warm->set_bias_enabled(true);
+	warm->set_epsilon(1e-6);
+	warm->set_C(1.0, 1.0);
+	warm->set_features(train_feats);
+	warm->set_labels(ground_truth);
+	warm->train();
+	warm->set_warm_start(true);
+	warm->set_C(1.2, 1.2);
+	warm->train();
+
+	SGVector<float64_t> w_cold = cold->get_w();
+	SGVector<float64_t> w_warm = warm->get_w();
+	ASSERT_EQ(w_warm.vlen, w_cold.vlen);
+	for (auto i : range(w_cold.vlen))
+		EXPECT_NEAR(w_warm[i], w_cold[i], 1e-4);
+	EXPECT_NEAR(warm->get_bias(), cold->get_bias(), 1e-4);
+	EXPECT_LT(warm->get_num_iterations(), cold->get_num_iterations());
+}
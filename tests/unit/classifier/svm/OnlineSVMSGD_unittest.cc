@@ -0,0 +1,77 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/svm/OnlineLibLinear.h>
+#include <shogun/classifier/svm/OnlineSVMSGD.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+class OnlineLinearMachineBatchTest : public ::testing::TestWithParam<bool>
+{
+protected:
+	virtual void SetUp()
+	{
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> normal_dist;
+
+		data = SGMatrix<float32_t>(dim, num_examples);
+		labels = SGVector<float64_t>(num_examples);
+		for (index_t i = 0; i < num_examples; i++)
+		{
+			labels[i] = i % 2 ? 1 : -1;
+			for (index_t j = 0; j < dim; j++)
+				data(j, i) = labels[i] * 2 + normal_dist(prng);
+		}
+	}
+
+	/* accuracy of machine trained on batches of examples */
+	float64_t train_and_evaluate(COnlineLinearMachine* machine)
+	{
+		machine->set_batch_size(64);
+		machine->set_hogwild(GetParam());
+		EXPECT_EQ(64, machine->get_batch_size());
+		EXPECT_EQ(GetParam(), machine->get_hogwild());
+
+		auto dense = some<CDenseFeatures<float32_t>>(data);
+		auto train_features =
+		    some<CStreamingDenseFeatures<float32_t>>(dense, labels.vector);
+		machine->train(train_features);
+
+		auto test_features = some<CStreamingDenseFeatures<float32_t>>(dense);
+		auto predictions = wrap(machine->apply_binary(test_features));
+		EXPECT_EQ(num_examples, predictions->get_num_labels());
+
+		index_t num_correct = 0;
+		for (index_t i = 0; i < num_examples; i++)
+			num_correct += predictions->get_label(i) == labels[i];
+		return float64_t(num_correct) / num_examples;
+	}
+
+	const index_t num_examples = 1000;
+	const index_t dim = 4;
+	SGMatrix<float32_t> data;
+	SGVector<float64_t> labels;
+};
+
+TEST_P(OnlineLinearMachineBatchTest, svmsgd)
+{
+	auto machine = some<COnlineSVMSGD>(1.0);
+	EXPECT_GT(train_and_evaluate(machine), 0.95);
+}
+
+TEST_P(OnlineLinearMachineBatchTest, liblinear)
+{
+	auto machine = some<COnlineLibLinear>(1.0);
+	EXPECT_GT(train_and_evaluate(machine), 0.95);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Hogwild, OnlineLinearMachineBatchTest, ::testing::Values(true, false));
@@ -4,6 +4,7 @@
  * Authors: Sergey Lisitsyn, Heiko Strathmann
  */
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 #include <set>
 #include <queue>
@@ -14,6 +15,8 @@
 #include <shogun/features/DataGenerator.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/tapkee/tapkee.hpp>
+#include <shogun/lib/tapkee/callbacks/eigen_callbacks.hpp>
 #include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
@@ -149,6 +152,73 @@ TEST(DISABLED_IsomapTest,neighbors_preserving)
 	SG_UNREF(low_dimensional_dist);
 }
 
+TEST(IsomapTest,approximate_neighbors)
+{
+	const index_t n_samples = 200;
+	const index_t n_dimensions = 3;
+	const index_t n_target_dimensions = 2;
+	const index_t n_neighbors = 10;
+
+	SGMatrix<float64_t> high_dimensional_matrix(n_dimensions, n_samples);
+	std::mt19937_64 prng(17);
+	fill_matrix_with_test_data(high_dimensional_matrix, prng);
+	auto high_dimensional_features =
+		some<CDenseFeatures<float64_t>>(high_dimensional_matrix);
+
+	for (index_t approximate = 0; approximate < 2; ++approximate)
+	{
+		auto isomap = some<CIsomap>();
+		isomap->set_k(n_neighbors);
+		isomap->set_target_dim(n_target_dimensions);
+		isomap->set_approximate_neighbors(approximate);
+		EXPECT_EQ(bool(approximate), isomap->get_approximate_neighbors());
+
+		auto embedding = wrap(isomap->transform(high_dimensional_features)
+		                          ->as<CDenseFeatures<float64_t>>());
+		SGMatrix<float64_t> embedding_matrix = embedding->get_feature_matrix();
+		EXPECT_EQ(n_target_dimensions, embedding_matrix.num_rows);
+		EXPECT_EQ(n_samples, embedding_matrix.num_cols);
+	}
+
+	/* NN-descent may miss a few neighbors, so its neighbors are compared
+	 * with the exact ones in terms of recall; neighbors at the distance
+	 * of the k-th exact neighbor count as found because of ties */
+	tapkee::DenseMatrix data = Eigen::Map<tapkee::DenseMatrix>(
+		high_dimensional_matrix.matrix, n_dimensions, n_samples);
+	std::vector<tapkee::IndexType> indices(n_samples);
+	for (index_t i = 0; i < n_samples; ++i)
+		indices[i] = i;
+	typedef std::vector<tapkee::IndexType>::iterator Iterator;
+	tapkee::eigen_distance_callback callback(data);
+	tapkee::tapkee_internal::PlainDistance<Iterator, tapkee::eigen_distance_callback>
+		distance(callback);
+	tapkee::tapkee_internal::Neighbors approximate_neighbors =
+		tapkee::tapkee_internal::find_neighbors(tapkee::NnDescent,
+			indices.begin(), indices.end(), distance, n_neighbors, false);
+	ASSERT_EQ(approximate_neighbors.size(), size_t(n_samples));
+
+	index_t n_found = 0;
+	for (index_t i = 0; i < n_samples; ++i)
+	{
+		std::vector<float64_t> distances;
+		for (index_t j = 0; j < n_samples; ++j)
+		{
+			if (j != i)
+				distances.push_back(callback.distance(i, j));
+		}
+		std::nth_element(distances.begin(), distances.begin() + n_neighbors - 1,
+			distances.end());
+		float64_t kth_distance = distances[n_neighbors - 1];
+
+		for (auto j : approximate_neighbors[i])
+		{
+			if (index_t(j) != i && callback.distance(i, j) <= kth_distance)
+				n_found++;
+		}
+	}
+	EXPECT_GE(float64_t(n_found) / (n_samples * n_neighbors), 0.99);
+}
+
 std::set<index_t> get_neighbors_indices(CDistance* distance_object, index_t feature_vector_index, index_t n_neighbors)
 {
 	index_t n_vectors = distance_object->get_num_vec_lhs();
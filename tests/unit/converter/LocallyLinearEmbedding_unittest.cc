@@ -0,0 +1,70 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include <shogun/converter/LocallyLinearEmbedding.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/tapkee/tapkee.hpp>
+#include <shogun/lib/tapkee/callbacks/eigen_callbacks.hpp>
+
+using namespace shogun;
+
+/* The converter uses ARPACK or, without it, the Lanczos method. The
+ * embedding is compared with the one of the dense eigensolver. */
+TEST(LocallyLinearEmbeddingTest, matches_dense_eigendecomposition)
+{
+	const index_t n_samples = 400;
+	const index_t n_target_dimensions = 2;
+	const index_t n_neighbors = 10;
+
+	// swiss roll with distinct pairwise distances
+	SGMatrix<float64_t> data(3, n_samples);
+	for (index_t i = 0; i < n_samples; ++i)
+	{
+		float64_t t = 1.5 * M_PI * (1 + 2.0 * i / n_samples);
+		data(0, i) = t * std::cos(t);
+		data(1, i) = 10.0 * ((i * 7919) % n_samples) / n_samples;
+		data(2, i) = t * std::sin(t);
+	}
+	auto features = some<CDenseFeatures<float64_t>>(data);
+
+	auto lle = some<CLocallyLinearEmbedding>();
+	lle->set_k(n_neighbors);
+	lle->set_target_dim(n_target_dimensions);
+	auto embedding = wrap(lle->transform(features)->as<CDenseFeatures<float64_t>>());
+	SGMatrix<float64_t> embedding_matrix = embedding->get_feature_matrix();
+	ASSERT_EQ(embedding_matrix.num_rows, n_target_dimensions);
+	ASSERT_EQ(embedding_matrix.num_cols, n_samples);
+
+	tapkee::DenseMatrix tapkee_data = Eigen::Map<tapkee::DenseMatrix>(data.matrix, 3, n_samples);
+	std::vector<tapkee::IndexType> indices(n_samples);
+	for (index_t i = 0; i < n_samples; ++i)
+		indices[i] = i;
+	tapkee::eigen_kernel_callback kernel_callback(tapkee_data);
+	tapkee::eigen_distance_callback distance_callback(tapkee_data);
+	tapkee::eigen_features_callback features_callback(tapkee_data);
+	tapkee::ParametersSet parameters =
+		(tapkee::method = tapkee::KernelLocallyLinearEmbedding,
+		 tapkee::eigen_method = tapkee::Dense,
+		 tapkee::neighbors_method = tapkee::Brute,
+		 tapkee::num_neighbors = n_neighbors,
+		 tapkee::target_dimension = n_target_dimensions,
+		 tapkee::nullspace_shift = lle->get_nullspace_shift());
+	tapkee::DenseMatrix expected = tapkee::embed(indices.begin(), indices.end(),
+		kernel_callback, distance_callback, features_callback, parameters).embedding;
+
+	// coordinates are only defined up to their sign
+	for (index_t j = 0; j < n_target_dimensions; ++j)
+	{
+		float64_t dot = 0;
+		for (index_t i = 0; i < n_samples; ++i)
+			dot += embedding_matrix(j, i) * expected(i, j);
+		float64_t sign = dot < 0 ? -1.0 : 1.0;
+		for (index_t i = 0; i < n_samples; ++i)
+			EXPECT_NEAR(embedding_matrix(j, i), sign * expected(i, j), 1e-6);
+	}
+}
@@ -44,5 +44,33 @@ TEST(TDistributedStochasticNeighborEmbeddingTest,basic)
 	SG_UNREF(high_dimensional_features);
 	SG_UNREF(low_dimensional_features);
 }
+
+TEST(TDistributedStochasticNeighborEmbeddingTest,fft_interpolation)
+{
+	std::mt19937_64 prng(24);
+
+	const index_t n_samples = 15;
+	const index_t n_dimensions = 3;
+	const index_t n_target_dimensions = 2;
+	auto high_dimensional_features = some<CDenseFeatures<float64_t>>(
+	    CDataGenerator::generate_gaussians(n_samples, 1, n_dimensions, prng));
+
+	auto embedder = some<CTDistributedStochasticNeighborEmbedding>();
+	embedder->set_target_dim(n_target_dimensions);
+	embedder->set_perplexity(n_samples / 5.0);
+	embedder->set_fft_interpolation(true);
+	EXPECT_TRUE(embedder->get_fft_interpolation());
+
+	auto low_dimensional_features =
+	    wrap(embedder->transform(high_dimensional_features)
+	             ->as<CDenseFeatures<float64_t>>());
+
+	EXPECT_EQ(n_target_dimensions,low_dimensional_features->get_dim_feature_space());
+	EXPECT_EQ(high_dimensional_features->get_num_vectors(),low_dimensional_features->get_num_vectors());
+
+	auto embedding = low_dimensional_features->get_feature_matrix();
+	for (index_t i = 0; i < embedding.size(); i++)
+		EXPECT_TRUE(std::isfinite(embedding[i]));
+}
 #endif // HAVE_LAPACK
 
@@ -12,8 +12,10 @@
 #include <shogun/evaluation/MulticlassAccuracy.h>
 #include <shogun/evaluation/MeanSquaredError.h>
 
+#include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/kernel/KernelMatrixCache.h>
 
 #include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/classifier/Perceptron.h>
@@ -27,6 +29,8 @@
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <vector>
+
 
 
 using namespace shogun;
@@ -205,3 +209,141 @@ TYPED_TEST(CrossValidationTests, single_multi_same_result)
 
 	EXPECT_NEAR(single, multi, 1e-7);
 }
+
+TEST(CrossValidation, kernel_cache_same_result)
+{
+	auto N = 50;
+	auto D = 3;
+
+	std::mt19937_64 prng(57);
+	NormalDistribution<float64_t> randn;
+
+	SGMatrix<float64_t> X(D, N);
+	SGVector<float64_t> y(N);
+	for (auto i : range(N))
+	{
+		for (auto j : range(D))
+			X(j, i) = randn(prng);
+		y[i] = std::sin(X(0, i)) + randn(prng) * 0.1;
+	}
+
+	auto features = new CDenseFeatures<float64_t>(X);
+	auto labels = new CRegressionLabels(y);
+	auto machine = new CKernelRidgeRegression(0.1, new CGaussianKernel(2.0), labels);
+	auto cv = new CCrossValidation(
+	    machine, features, labels, new CCrossValidationSplitting(labels, 5),
+	    new CMeanSquaredError());
+	SG_REF(cv);
+	cv->put("seed", 1);
+
+	auto result = cv->evaluate();
+	auto expected = result->get<float64_t>("mean");
+	SG_UNREF(result);
+
+	auto cache = new CKernelMatrixCache();
+	cv->set_kernel_cache(cache);
+	result = cv->evaluate();
+	auto cached = result->get<float64_t>("mean");
+	SG_UNREF(result);
+	EXPECT_EQ(cache->get_num_matrices(), 1);
+
+	/* only the regularization changes, the kernel matrix is reused */
+	machine->put("tau", 0.2);
+	result = cv->evaluate();
+	SG_UNREF(result);
+	EXPECT_EQ(cache->get_num_matrices(), 1);
+
+	EXPECT_NEAR(expected, cached, 1e-4);
+
+	SG_UNREF(cv);
+}
+
+TEST(CrossValidation, kernel_cache_exact_keys)
+{
+	SGMatrix<float64_t> X(1, 3);
+	X(0, 0) = 0;
+	X(0, 1) = 1;
+	X(0, 2) = 3;
+
+	auto cache = some<CKernelMatrixCache>();
+	auto kernel = some<CGaussianKernel>(2.0);
+
+	auto features = new CDenseFeatures<float64_t>(X);
+	SG_REF(features);
+	auto matrix = cache->get_kernel_matrix(kernel, features);
+	auto expected = matrix->get_kernel_matrix();
+	SG_UNREF(matrix);
+	SG_UNREF(features);
+
+	/* the cache keeps the features alive, so their address is not reused
+	 * by other features on which a different matrix must be computed */
+	SGMatrix<float64_t> Y(1, 3);
+	Y(0, 0) = 0;
+	Y(0, 1) = 2;
+	Y(0, 2) = 5;
+	auto other_features = some<CDenseFeatures<float64_t>>(Y);
+	matrix = cache->get_kernel_matrix(kernel, other_features);
+	EXPECT_EQ(cache->get_num_matrices(), 2);
+	EXPECT_NE(matrix->kernel(0, 1), expected(0, 1));
+	SG_UNREF(matrix);
+
+	/* a different width is a different matrix, an equal copy is not */
+	auto wider = some<CGaussianKernel>(4.0);
+	matrix = cache->get_kernel_matrix(wider, other_features);
+	SG_UNREF(matrix);
+	EXPECT_EQ(cache->get_num_matrices(), 3);
+
+	auto copy = some<CGaussianKernel>(4.0);
+	matrix = cache->get_kernel_matrix(copy, other_features);
+	SG_UNREF(matrix);
+	EXPECT_EQ(cache->get_num_matrices(), 3);
+}
+
+TEST(CrossValidation, warm_start_same_result)
+{
+	auto N = 50;
+	auto D = 3;
+
+	std::mt19937_64 prng(57);
+	NormalDistribution<float64_t> randn;
+
+	SGMatrix<float64_t> X(D, N);
+	SGVector<float64_t> y(N);
+	for (auto i : range(N))
+	{
+		for (auto j : range(D))
+			X(j, i) = randn(prng);
+		y[i] = X(0, i) + randn(prng) * 0.5 > 0 ? 1 : -1;
+	}
+
+	auto features = new CDenseFeatures<float64_t>(X);
+	auto labels = new CBinaryLabels(y);
+	auto machine = new CLibSVM(0.1, new CGaussianKernel(2.0), labels);
+	auto cv = new CCrossValidation(
+	    machine, features, labels, new CCrossValidationSplitting(labels, 5),
+	    new CContingencyTableEvaluation(ACCURACY));
+	SG_REF(cv);
+	cv->put("seed", 1);
+
+	/* regularization path, once from scratch and once warm started */
+	std::vector<float64_t> Cs = {0.1, 1.0, 10.0};
+	std::vector<float64_t> expected;
+	for (auto C : Cs)
+	{
+		machine->set_C(C, C);
+		auto result = cv->evaluate();
+		expected.push_back(result->get<float64_t>("mean"));
+		SG_UNREF(result);
+	}
+
+	cv->set_warm_start(true);
+	for (auto i : range(Cs.size()))
+	{
+		machine->set_C(Cs[i], Cs[i]);
+		auto result = cv->evaluate();
+		EXPECT_NEAR(result->get<float64_t>("mean"), expected[i], 0.05);
+		SG_UNREF(result);
+	}
+
+	SG_UNREF(cv);
+}
@@ -303,3 +303,33 @@ TEST(DenseFeaturesTest, view)
 			    feature_matrix_subset2(i, j), data(i, subset1[subset2[j]]));
 	}
 }
+
+TEST(DenseFeaturesTest, dense_dot_range_single_precision)
+{
+	index_t dim=13;
+	index_t n=150;
+
+	SGMatrix<float32_t> data(dim, n);
+	for (auto i : range(data.size()))
+		data[i] = (i % 17) / 7.0;
+	SGVector<float64_t> w(dim);
+	for (auto i : range(dim))
+		w[i] = i - 6.5;
+	SGVector<float64_t> alphas(n);
+	for (auto i : range(n))
+		alphas[i] = i % 3 - 1.0;
+
+	auto features = some<CDenseFeatures<float32_t>>(data);
+	index_t start = 5;
+	SGVector<float64_t> output(n - start);
+	features->dense_dot_range(output.vector, start, n, alphas.vector, w.vector, dim, 0.5);
+
+	for (auto i : range(output.vlen))
+	{
+		float64_t expected = 0;
+		for (auto j : range(dim))
+			expected += data(j, i + start) * w[j];
+		EXPECT_NEAR(features->dot(i + start, w), expected, 1e-10);
+		EXPECT_NEAR(output[i], alphas[i] * expected + 0.5, 1e-10);
+	}
+}
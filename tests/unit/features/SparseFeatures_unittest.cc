@@ -413,3 +413,88 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 	SG_UNREF(features);
 }
+
+TEST(SparseFeaturesTest,csr_matches_sparse_vectors)
+{
+	SGMatrix<float64_t> data(4, 5);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=(i%3==0) ? 0 : i;
+
+	/* indptr, indices and values of the same matrix in external buffers */
+	int64_t indptr[6];
+	index_t indices[20];
+	float64_t values[20];
+	indptr[0]=0;
+	for (index_t j=0; j<data.num_cols; ++j)
+	{
+		indptr[j+1]=indptr[j];
+		for (index_t i=0; i<data.num_rows; ++i)
+		{
+			if (data(i,j)!=0)
+			{
+				indices[indptr[j+1]]=i;
+				values[indptr[j+1]]=data(i,j);
+				indptr[j+1]++;
+			}
+		}
+	}
+
+	auto features=some<CSparseFeatures<float64_t>>(data);
+	auto csr_features=some<CSparseFeatures<float64_t>>(
+		SGVector<int64_t>(indptr, 6, false),
+		SGVector<index_t>(indices, indptr[5], false),
+		SGVector<float64_t>(values, indptr[5], false), data.num_rows);
+
+	EXPECT_TRUE(csr_features->is_csr());
+	EXPECT_FALSE(features->is_csr());
+	EXPECT_EQ(features->get_num_vectors(), csr_features->get_num_vectors());
+	EXPECT_EQ(features->get_num_nonzero_entries(), csr_features->get_num_nonzero_entries());
+	EXPECT_TRUE(csr_features->get_full_feature_matrix().equals(data));
+
+	SGVector<float64_t> w(data.num_rows);
+	w.range_fill(1.0);
+	SGVector<float64_t> sum(data.num_rows);
+	SGVector<float64_t> csr_sum(data.num_rows);
+	sum.zero();
+	csr_sum.zero();
+	for (index_t j=0; j<data.num_cols; ++j)
+	{
+		EXPECT_EQ(features->get_nnz_features_for_vector(j),
+			csr_features->get_nnz_features_for_vector(j));
+		EXPECT_EQ(features->dot(j, w), csr_features->dot(j, w));
+		EXPECT_EQ(features->dense_dot(2.0, j, w.vector, w.vlen, 1.0),
+			csr_features->dense_dot(2.0, j, w.vector, w.vlen, 1.0));
+		for (index_t k=0; k<data.num_cols; ++k)
+			EXPECT_EQ(features->dot(j, features, k), csr_features->dot(j, csr_features, k));
+
+		features->add_to_dense_vec(0.5, j, sum.vector, sum.vlen);
+		csr_features->add_to_dense_vec(0.5, j, csr_sum.vector, csr_sum.vlen);
+
+		SGSparseVector<float64_t> vec=csr_features->get_sparse_feature_vector(j);
+		SGSparseVector<float64_t> expected=features->get_sparse_feature_vector(j);
+		ASSERT_EQ(expected.num_feat_entries, vec.num_feat_entries);
+		for (index_t k=0; k<vec.num_feat_entries; ++k)
+		{
+			EXPECT_EQ(expected.features[k].feat_index, vec.features[k].feat_index);
+			EXPECT_EQ(expected.features[k].entry, vec.features[k].entry);
+		}
+	}
+	EXPECT_TRUE(sum.equals(csr_sum));
+
+	SGVector<index_t> subset_idx(2);
+	subset_idx[0]=3;
+	subset_idx[1]=1;
+	csr_features->add_subset(subset_idx);
+	EXPECT_EQ(features->dot(3, w), csr_features->dot(0, w));
+	EXPECT_EQ(features->get_num_nonzero_entries()-
+		features->get_nnz_features_for_vector(0)-
+		features->get_nnz_features_for_vector(2)-
+		features->get_nnz_features_for_vector(4),
+		csr_features->get_num_nonzero_entries());
+
+	SGVector<index_t> copy_idx(1);
+	copy_idx[0]=1;
+	auto copy=wrap(csr_features->copy_subset(copy_idx)->as<CSparseFeatures<float64_t>>());
+	EXPECT_TRUE(copy->is_csr());
+	EXPECT_TRUE(copy->get_full_feature_vector(0).equals(data.get_column(1)));
+}
@@ -9,6 +9,8 @@
 #include <gtest/gtest.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/lib/memory.h>
+#include <cstdio>
+#include <cstring>
 #include <random>
 
 using namespace shogun;
@@ -91,3 +93,148 @@ TEST(StringFeaturesTest,equals)
 	SG_UNREF(f);
 	SG_UNREF(f_clone);
 }
+
+TEST(StringFeaturesTest,packed_strings)
+{
+	const char* dna[]={"ACGT", "GATTACA", "", "TTTTGGGGCCCCAAAAC"};
+	std::vector<SGVector<char>> strings;
+	for (auto s : dna)
+	{
+		SGVector<char> str(strlen(s));
+		sg_memcpy(str.vector, s, strlen(s));
+		strings.push_back(str);
+	}
+
+	auto f=some<CStringFeatures<char>>(strings, DNA);
+	EXPECT_FALSE(f->is_packed());
+	f->pack_strings();
+	EXPECT_TRUE(f->is_packed());
+
+	for (auto two_bit_dna : {false, true})
+	{
+		char filename[]="packed_strings_XXXXXX";
+		generate_temp_filename(filename);
+		ASSERT_TRUE(f->save_packed_file(filename, two_bit_dna));
+
+		auto loaded=some<CStringFeatures<char>>(DNA);
+		ASSERT_TRUE(loaded->load_packed_file(filename));
+		EXPECT_TRUE(loaded->is_packed());
+		auto alphabet=wrap(loaded->get_alphabet());
+		EXPECT_EQ(DNA, alphabet->get_alphabet());
+		ASSERT_EQ(f->get_num_vectors(), loaded->get_num_vectors());
+
+		for (index_t i=0; i<f->get_num_vectors(); i++)
+		{
+			SGVector<char> vec=f->get_feature_vector(i);
+			SGVector<char> loaded_vec=loaded->get_feature_vector(i);
+			ASSERT_EQ(index_t(strlen(dna[i])), vec.vlen);
+			ASSERT_EQ(vec.vlen, loaded_vec.vlen);
+			for (index_t j=0; j<vec.vlen; j++)
+			{
+				EXPECT_EQ(dna[i][j], vec.vector[j]);
+				EXPECT_EQ(dna[i][j], loaded_vec.vector[j]);
+			}
+			f->free_feature_vector(vec, i);
+			loaded->free_feature_vector(loaded_vec, i);
+		}
+		std::remove(filename);
+	}
+}
+
+TEST(StringFeaturesTest,packed_strings_outlive_features)
+{
+	const char* dna[]={"ACGT", "GATTACA", "", "TTTTGGGGCCCCAAAAC"};
+	std::vector<SGVector<char>> strings;
+	for (auto s : dna)
+	{
+		SGVector<char> str(strlen(s));
+		sg_memcpy(str.vector, s, strlen(s));
+		strings.push_back(str);
+	}
+
+	char filename[]="packed_strings_XXXXXX";
+	generate_temp_filename(filename);
+	auto packed=some<CStringFeatures<char>>(strings, DNA);
+	packed->pack_strings();
+	ASSERT_TRUE(packed->save_packed_file(filename, false));
+
+	/* strings taken from packed features, either allocated or memory
+	 * mapped, are still readable once the features are freed */
+	for (auto mapped : {false, true})
+	{
+		CStringFeatures<char>* f=new CStringFeatures<char>(DNA);
+		SG_REF(f);
+		if (mapped)
+			ASSERT_TRUE(f->load_packed_file(filename));
+		else
+		{
+			f->set_features(strings);
+			f->pack_strings();
+		}
+		ASSERT_TRUE(f->is_packed());
+
+		std::vector<SGVector<char>> list=f->get_string_list();
+		CStringFeatures<char>* copy=new CStringFeatures<char>(list, DNA);
+		SG_REF(copy);
+		SG_UNREF(f);
+
+		ASSERT_EQ(index_t(list.size()), copy->get_num_vectors());
+		for (index_t i=0; i<copy->get_num_vectors(); i++)
+		{
+			SGVector<char> vec=copy->get_feature_vector(i);
+			ASSERT_EQ(index_t(strlen(dna[i])), list[i].vlen);
+			ASSERT_EQ(list[i].vlen, vec.vlen);
+			for (index_t j=0; j<vec.vlen; j++)
+			{
+				EXPECT_EQ(dna[i][j], list[i].vector[j]);
+				EXPECT_EQ(dna[i][j], vec.vector[j]);
+			}
+			copy->free_feature_vector(vec, i);
+		}
+		SG_UNREF(copy);
+	}
+	std::remove(filename);
+}
+
+TEST(StringFeaturesTest,obtain_from_char)
+{
+	const char* dna[]={"ACGTTGCA", "GATTACA", "", "TTTTGGGGCCCCAAAAC"};
+	std::vector<SGVector<char>> strings;
+	for (auto s : dna)
+	{
+		SGVector<char> str(strlen(s));
+		sg_memcpy(str.vector, s, strlen(s));
+		strings.push_back(str);
+	}
+	auto char_features=some<CStringFeatures<char>>(strings, DNA);
+	auto alphabet=wrap(char_features->get_alphabet());
+
+	const int32_t order=3;
+	for (auto rev : {false, true})
+	{
+		auto words=some<CStringFeatures<uint16_t>>(DNA);
+		ASSERT_TRUE(words->obtain_from_char(char_features, order-1, order, 0, rev));
+		ASSERT_EQ(char_features->get_num_vectors(), words->get_num_vectors());
+
+		for (index_t i=0; i<words->get_num_vectors(); i++)
+		{
+			SGVector<uint16_t> vec=words->get_feature_vector(i);
+			index_t len=strlen(dna[i]);
+			ASSERT_EQ(CMath::max(len-order+1, 0), vec.vlen);
+
+			/* k-mer ending at each position with two bits per symbol,
+			 * the last symbol in the lowest or highest bits */
+			for (index_t j=0; j<vec.vlen; j++)
+			{
+				uint16_t word=0;
+				for (index_t k=0; k<order; k++)
+				{
+					uint16_t symbol=alphabet->remap_to_bin(dna[i][j+order-1-k]);
+					word|=symbol << (rev ? 2*(order-1-k) : 2*k);
+				}
+				EXPECT_EQ(word, vec[j]);
+			}
+			words->free_feature_vector(vec, i);
+		}
+	}
+}
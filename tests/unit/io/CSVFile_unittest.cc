@@ -198,3 +198,69 @@ TEST(CSVFileTest, string_list_char)
 	SG_FREE(lines_to_read);
 	unlink("CSVFileTest_string_list_char_output.txt");
 }
+
+TEST(CSVFileTest, matrix_float64_header_and_transpose)
+{
+	const char* fname="CSVFileTest_matrix_float64_header.txt";
+	FILE* f=fopen(fname, "w");
+	fprintf(f, "first,second,third,fourth\n\n1.5,-2,3e2,8\r\n4, 5 ,0.25,-8\n\n7,nan,-1e-3,0.5\n");
+	fclose(f);
+
+	SGMatrix<float64_t> data_from_file(true);
+	CCSVFile* fin=new CCSVFile(fname, 'r', NULL);
+	fin->set_lines_to_skip(1);
+	fin->get_matrix(data_from_file.matrix, data_from_file.num_rows, data_from_file.num_cols);
+	EXPECT_EQ(data_from_file.num_rows, 4);
+	EXPECT_EQ(data_from_file.num_cols, 3);
+
+	float64_t expected[]={1.5, -2, 3e2, 8, 4, 5, 0.25, -8, 7, 0, -1e-3, 0.5};
+	for (int32_t i=0; i<12; i++)
+	{
+		if (i==9)
+			EXPECT_TRUE(std::isnan(data_from_file.matrix[i]));
+		else
+			EXPECT_EQ(data_from_file.matrix[i], expected[i]);
+	}
+
+	SGMatrix<float32_t> transposed(true);
+	fin->set_transpose(true);
+	fin->get_matrix(transposed.matrix, transposed.num_rows, transposed.num_cols);
+	EXPECT_EQ(transposed.num_rows, 3);
+	EXPECT_EQ(transposed.num_cols, 4);
+	for (int32_t i=0; i<3; i++)
+	{
+		for (int32_t j=0; j<4; j++)
+		{
+			if (i==2 && j==1)
+				EXPECT_TRUE(std::isnan(transposed(i, j)));
+			else
+				EXPECT_EQ(transposed(i, j), (float32_t) expected[i*4+j]);
+		}
+	}
+
+	SG_UNREF(fin);
+	unlink(fname);
+}
+
+TEST(CSVFileTest, matrix_int32_transpose)
+{
+	const char* fname="CSVFileTest_matrix_int32_transpose.txt";
+	FILE* f=fopen(fname, "w");
+	fprintf(f, "1,2,3,4,5\n6,7,8,9,10\n");
+	fclose(f);
+
+	SGMatrix<int32_t> transposed(true);
+	CCSVFile* fin=new CCSVFile(fname, 'r', NULL);
+	fin->set_transpose(true);
+	fin->get_matrix(transposed.matrix, transposed.num_rows, transposed.num_cols);
+	EXPECT_EQ(transposed.num_rows, 2);
+	EXPECT_EQ(transposed.num_cols, 5);
+	for (int32_t i=0; i<2; i++)
+	{
+		for (int32_t j=0; j<5; j++)
+			EXPECT_EQ(transposed(i, j), 5*i+j+1);
+	}
+
+	SG_UNREF(fin);
+	unlink(fname);
+}
@@ -0,0 +1,223 @@
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/io/ColumnarFile.h>
+#include <shogun/io/streaming/StreamingColumnarFile.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+
+#include <random>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(ColumnarFileTest, dense_float64_with_labels)
+{
+	const char* fname="ColumnarFileTest_dense_float64.sgcf";
+	int32_t num_feat=4;
+	int32_t num_vec=10;
+
+	std::mt19937_64 prng(100);
+	UniformRealDistribution<float64_t> uniform_real_dist(-1.0, 1.0);
+	SGMatrix<float64_t> data(num_feat, num_vec);
+	SGVector<float64_t> lab(num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		for (int32_t i=0; i<num_feat; i++)
+			data(i, j)=uniform_real_dist(prng);
+		lab[j]=j%2;
+	}
+	/* values of the second feature increase with the chunk */
+	for (int32_t j=0; j<num_vec; j++)
+		data(1, j)=j;
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+	CColumnarFile* fout=new CColumnarFile(fname, 'w');
+	fout->set_chunk_size(3);
+	fout->write(features, labels);
+	SG_UNREF(fout);
+
+	CColumnarFile* fin=new CColumnarFile(fname, 'r');
+	EXPECT_FALSE(fin->is_sparse());
+	EXPECT_TRUE(fin->has_labels());
+	EXPECT_EQ(fin->get_primitive_type(), PT_FLOAT64);
+	EXPECT_EQ(fin->get_num_features(), num_feat);
+	EXPECT_EQ(fin->get_num_vectors(), num_vec);
+	EXPECT_EQ(fin->get_num_chunks(), 4);
+	EXPECT_EQ(fin->get_chunk_num_vectors(3), 1);
+
+	CDenseFeatures<float64_t>* read=fin->read_dense<float64_t>();
+	SGMatrix<float64_t> data_from_file=read->get_feature_matrix();
+	ASSERT_EQ(data_from_file.num_rows, num_feat);
+	ASSERT_EQ(data_from_file.num_cols, num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		for (int32_t i=0; i<num_feat; i++)
+			EXPECT_EQ(data_from_file(i, j), data(i, j));
+	}
+	SG_UNREF(read);
+
+	SGVector<index_t> subset(2);
+	subset[0]=3;
+	subset[1]=1;
+	CDenseFeatures<float32_t>* projected=fin->read_dense<float32_t>(subset);
+	SGMatrix<float32_t> projected_from_file=projected->get_feature_matrix();
+	ASSERT_EQ(projected_from_file.num_rows, 2);
+	ASSERT_EQ(projected_from_file.num_cols, num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		EXPECT_EQ(projected_from_file(0, j), (float32_t) data(3, j));
+		EXPECT_EQ(projected_from_file(1, j), (float32_t) data(1, j));
+	}
+	SG_UNREF(projected);
+
+	SGVector<float64_t> lab_from_file=fin->read_labels();
+	ASSERT_EQ(lab_from_file.vlen, num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+		EXPECT_EQ(lab_from_file[j], lab[j]);
+
+	float64_t min, max;
+	fin->get_statistics(1, 1, min, max);
+	EXPECT_EQ(min, 3);
+	EXPECT_EQ(max, 5);
+	SGVector<index_t> chunks=fin->get_chunks_in_range(1, 4.5, 6.5);
+	ASSERT_EQ(chunks.vlen, 2);
+	EXPECT_EQ(chunks[0], 1);
+	EXPECT_EQ(chunks[1], 2);
+
+	SG_UNREF(fin);
+	SG_UNREF(labels);
+	SG_UNREF(features);
+	unlink(fname);
+}
+
+TEST(ColumnarFileTest, sparse_float32)
+{
+	const char* fname="ColumnarFileTest_sparse_float32.sgcf";
+	int32_t num_feat=6;
+	int32_t num_vec=7;
+
+	SGSparseMatrix<float32_t> data(num_feat, num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		/* vector j stores the features below j, skipping odd ones */
+		int32_t num_entries=(std::min(j, num_feat)+1)/2;
+		data[j]=SGSparseVector<float32_t>(num_entries);
+		for (int32_t k=0; k<num_entries; k++)
+		{
+			data[j].features[k].feat_index=2*k;
+			data[j].features[k].entry=j+0.25*k;
+		}
+	}
+
+	CSparseFeatures<float32_t>* features=new CSparseFeatures<float32_t>(data);
+	CColumnarFile* fout=new CColumnarFile(fname, 'w');
+	fout->set_chunk_size(4);
+#ifdef USE_GZIP
+	fout->set_compression(GZIP, 9);
+#endif
+	fout->write(features);
+	SG_UNREF(fout);
+
+	CColumnarFile* fin=new CColumnarFile(fname, 'r');
+	EXPECT_TRUE(fin->is_sparse());
+	EXPECT_FALSE(fin->has_labels());
+	EXPECT_EQ(fin->get_primitive_type(), PT_FLOAT32);
+
+	CSparseFeatures<float32_t>* read=fin->read_sparse<float32_t>();
+	EXPECT_EQ(read->get_num_features(), num_feat);
+	ASSERT_EQ(read->get_num_vectors(), num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		SGSparseVector<float32_t> vec=read->get_sparse_feature_vector(j);
+		ASSERT_EQ(vec.num_feat_entries, data[j].num_feat_entries);
+		for (int32_t k=0; k<vec.num_feat_entries; k++)
+		{
+			EXPECT_EQ(vec.features[k].feat_index, data[j].features[k].feat_index);
+			EXPECT_EQ(vec.features[k].entry, data[j].features[k].entry);
+		}
+		read->free_sparse_feature_vector(j);
+	}
+	SG_UNREF(read);
+
+	/* the second feature is never stored, so only zeros are in range */
+	EXPECT_EQ(fin->get_chunks_in_range(1, 1, 2).vlen, 0);
+	EXPECT_EQ(fin->get_chunks_in_range(1, 0, 0).vlen, 2);
+
+	SGVector<index_t> subset(1);
+	subset[0]=2;
+	CSparseFeatures<float64_t>* projected=fin->read_sparse<float64_t>(subset);
+	EXPECT_EQ(projected->get_num_features(), 1);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		SGSparseVector<float64_t> vec=projected->get_sparse_feature_vector(j);
+		ASSERT_EQ(vec.num_feat_entries, j>=3 ? 1 : 0);
+		if (vec.num_feat_entries)
+		{
+			EXPECT_EQ(vec.features[0].feat_index, 0);
+			EXPECT_EQ(vec.features[0].entry, j+0.25);
+		}
+		projected->free_sparse_feature_vector(j);
+	}
+	SG_UNREF(projected);
+
+	SG_UNREF(fin);
+	SG_UNREF(features);
+	unlink(fname);
+}
+
+TEST(ColumnarFileTest, streaming_dense)
+{
+	const char* fname="ColumnarFileTest_streaming_dense.sgcf";
+	int32_t num_feat=3;
+	int32_t num_vec=5;
+
+	SGMatrix<float32_t> data(num_feat, num_vec);
+	SGVector<float64_t> lab(num_vec);
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		for (int32_t i=0; i<num_feat; i++)
+			data(i, j)=10*j+i;
+		lab[j]=-j;
+	}
+
+	CDenseFeatures<float32_t>* features=new CDenseFeatures<float32_t>(data);
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+	CColumnarFile* fout=new CColumnarFile(fname, 'w');
+	fout->set_chunk_size(2);
+	fout->write(features, labels);
+	SG_UNREF(fout);
+
+	SGVector<index_t> subset(1);
+	subset[0]=2;
+	CStreamingColumnarFile* stream=new CStreamingColumnarFile(fname, subset);
+	for (int32_t pass=0; pass<2; pass++)
+	{
+		float64_t* vector=NULL;
+		int32_t len=0;
+		float64_t label=0;
+		for (int32_t j=0; j<num_vec; j++)
+		{
+			stream->get_vector_and_label(vector, len, label);
+			ASSERT_EQ(len, 1);
+			EXPECT_EQ(vector[0], data(2, j));
+			EXPECT_EQ(label, lab[j]);
+		}
+		float64_t* end=vector;
+		stream->get_vector_and_label(end, len, label);
+		EXPECT_EQ(len, -1);
+		EXPECT_EQ(end, (float64_t*) NULL);
+		SG_FREE(vector);
+		stream->reset_stream();
+	}
+
+	SG_UNREF(stream);
+	SG_UNREF(labels);
+	SG_UNREF(features);
+	unlink(fname);
+}
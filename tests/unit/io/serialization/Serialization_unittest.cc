@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 
+#include <shogun/base/range.h>
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/io/serialization/BitserySerializer.h>
 #include <shogun/io/serialization/BitseryDeserializer.h>
@@ -12,6 +16,8 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
 
+#include "utils/Utils.h"
+
 using namespace shogun;
 using namespace shogun::io;
 using namespace std;
@@ -145,3 +151,106 @@ TYPED_TEST(SerializationTest, serialize)
 
 	ASSERT_TRUE(obj->equals(deser_obj));
 }
+
+TYPED_TEST(SerializationTest, serialize_large_arrays)
+{
+	SGMatrix<float64_t> data(20, 500);
+	for (auto i : range(data.num_rows * data.num_cols))
+		data[i] = std::sin(i) * 1e3;
+	SGMatrix<int32_t> int_data(3, 1000);
+	for (auto i : range(int_data.num_rows * int_data.num_cols))
+		int_data[i] = i * 7 - 100;
+
+	auto objects = {wrap<CSGObject>(new CDenseFeatures<float64_t>(data)),
+	                wrap<CSGObject>(new CDenseFeatures<int32_t>(int_data))};
+	for (const auto& obj : objects)
+	{
+		auto serializer = some<typename TypeParam::first_type>();
+		auto stream = some<CDummyOutputStream>();
+		serializer->attach(stream);
+		serializer->write(obj);
+
+		auto deserializer = some<typename TypeParam::second_type>();
+		auto istream = some<CDummyInputStream>(stream->buffer());
+		deserializer->attach(istream);
+		auto deser_obj = deserializer->read_object();
+
+		EXPECT_TRUE(obj->equals(deser_obj));
+	}
+}
+
+TEST(BitserySerializationTest, read_object_mapped)
+{
+	SGMatrix<float64_t> data(20, 500);
+	for (auto i : range(data.num_rows * data.num_cols))
+		data[i] = std::sin(i) * 1e3;
+	auto obj = some<CDenseFeatures<float64_t>>(data);
+
+	auto serializer = some<CBitserySerializer>();
+	serializer->set_align_arrays(true);
+	auto stream = some<CDummyOutputStream>();
+	serializer->attach(stream);
+	serializer->write(obj);
+
+	// aligned streams can still be read without mapping them
+	auto deserializer = some<CBitseryDeserializer>();
+	auto istream = some<CDummyInputStream>(stream->buffer());
+	deserializer->attach(istream);
+	EXPECT_TRUE(obj->equals(deserializer->read_object()));
+
+	std::string filename = "shogun-unittest-serialization-mapped.XXXXXX";
+	generate_temp_filename(const_cast<char*>(filename.c_str()));
+	{
+		std::ofstream file(filename, std::ios::binary);
+		file << stream->buffer();
+	}
+
+	auto mapped_obj = deserializer->read_object_mapped(filename);
+	EXPECT_TRUE(obj->equals(mapped_obj));
+
+	// the feature matrix is a view of the aligned mapped values
+	auto matrix = mapped_obj->get<SGMatrix<float64_t>>("feature_matrix");
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(matrix.matrix) % 64, 0);
+	EXPECT_NE(matrix.matrix, data.matrix);
+
+	std::remove(filename.c_str());
+}
+
+TEST(BitserySerializationTest, read_object_mapped_outlives_deserializer)
+{
+	SGMatrix<float64_t> data(20, 500);
+	for (auto i : range(data.num_rows * data.num_cols))
+		data[i] = std::cos(i) * 1e3;
+	auto obj = some<CDenseFeatures<float64_t>>(data);
+
+	auto serializer = some<CBitserySerializer>();
+	serializer->set_align_arrays(true);
+	auto stream = some<CDummyOutputStream>();
+	serializer->attach(stream);
+	serializer->write(obj);
+
+	std::string filename = "shogun-unittest-serialization-mapped.XXXXXX";
+	generate_temp_filename(const_cast<char*>(filename.c_str()));
+	{
+		std::ofstream file(filename, std::ios::binary);
+		file << stream->buffer();
+	}
+
+	CSGObject* mapped_obj = nullptr;
+	{
+		auto deserializer = some<CBitseryDeserializer>();
+		mapped_obj = deserializer->read_object_mapped(filename);
+		SG_REF(mapped_obj);
+	}
+	EXPECT_TRUE(obj->equals(mapped_obj));
+
+	// views taken from the model keep the mapping alive on their own
+	auto matrix = mapped_obj->get<SGMatrix<float64_t>>("feature_matrix");
+	SG_UNREF(mapped_obj);
+	ASSERT_EQ(matrix.num_rows, data.num_rows);
+	ASSERT_EQ(matrix.num_cols, data.num_cols);
+	for (auto i : range(data.num_rows * data.num_cols))
+		EXPECT_EQ(matrix[i], data[i]);
+
+	std::remove(filename.c_str());
+}
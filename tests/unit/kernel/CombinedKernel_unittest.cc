@@ -200,6 +200,58 @@ TEST(CombinedKernelTest,weights)
 	SG_UNREF(combined);
 }
 
+TEST(CombinedKernelTest, compute_batch)
+{
+	const index_t dim = 3;
+	const index_t num_vec = 150;
+	const index_t num_suppvec = 300;
+
+	std::mt19937_64 prng(17);
+	SGMatrix<float64_t> data(dim, num_vec + num_suppvec);
+	random::fill_array(data, -1.0, 1.0, prng);
+	auto feats = new CDenseFeatures<float64_t>(data);
+
+	CCombinedKernel* combined = new CCombinedKernel();
+	CCombinedFeatures* combined_feats = new CCombinedFeatures();
+	std::vector<float64_t> widths = {0.5, 1.0, 2.0};
+	for (auto width : widths)
+	{
+		combined->append_kernel(new CGaussianKernel(width));
+		combined_feats->append_feature_obj(feats);
+	}
+
+	SGVector<float64_t> weights(widths.size());
+	weights[0] = 0.2;
+	weights[1] = 0.0;
+	weights[2] = 0.8;
+	combined->set_subkernel_weights(weights);
+	combined->init(combined_feats, combined_feats);
+
+	SGVector<int32_t> vec_idx(num_vec);
+	SGVector<int32_t> sv_idx(num_suppvec);
+	SGVector<float64_t> alphas(num_suppvec);
+	vec_idx.range_fill();
+	sv_idx.range_fill(num_vec);
+	random::fill_array(alphas, -1.0, 1.0, prng);
+
+	SGVector<float64_t> result(num_vec);
+	result.zero();
+	combined->compute_batch(
+	    num_vec, vec_idx.vector, result.vector, num_suppvec, sv_idx.vector,
+	    alphas.vector, 1.0);
+
+	for (index_t i = 0; i < num_vec; i++)
+	{
+		float64_t expected = 0;
+		for (index_t j = 0; j < num_suppvec; j++)
+			expected += alphas[j] * combined->kernel(sv_idx[j], vec_idx[i]);
+
+		EXPECT_NEAR(result[i], expected, 1e-10);
+	}
+
+	SG_UNREF(combined);
+}
+
 TEST(CombinedKernelTest,serialization)
 {
 	CCombinedKernel* combined = new CCombinedKernel();
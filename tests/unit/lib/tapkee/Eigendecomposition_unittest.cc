@@ -0,0 +1,99 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <shogun/lib/tapkee/tapkee.hpp>
+
+using namespace tapkee;
+using namespace tapkee::tapkee_internal;
+
+namespace
+{
+	/* checks that the Lanczos eigenpairs match the dense ones, eigenvectors
+	 * are only defined up to their sign */
+	void expect_same_eigenpairs(const EigendecompositionResult& lanczos,
+		const EigendecompositionResult& dense, IndexType target_dimension)
+	{
+		ASSERT_EQ(lanczos.first.cols(), target_dimension);
+		ASSERT_EQ(lanczos.second.size(), target_dimension);
+		ASSERT_EQ(lanczos.first.rows(), dense.first.rows());
+		for (IndexType i = 0; i < target_dimension; ++i)
+		{
+			EXPECT_NEAR(lanczos.second(i), dense.second(i), 1e-8);
+			EXPECT_NEAR(lanczos.first.col(i).norm(), 1.0, 1e-8);
+			EXPECT_NEAR(std::abs(lanczos.first.col(i).dot(dense.first.col(i))), 1.0, 1e-8);
+		}
+	}
+
+	/* Laplacian of a path graph with random weights, which is positive
+	 * semidefinite and singular with distinct eigenvalues */
+	SparseWeightMatrix path_laplacian(IndexType n)
+	{
+		std::vector<SparseTriplet> triplets;
+		DenseVector degrees = DenseVector::Zero(n);
+		for (IndexType i = 0; i+1 < n; ++i)
+		{
+			ScalarType weight = 0.5 + uniform_random();
+			triplets.push_back(SparseTriplet(i, i+1, -weight));
+			triplets.push_back(SparseTriplet(i+1, i, -weight));
+			degrees(i) += weight;
+			degrees(i+1) += weight;
+		}
+		for (IndexType i = 0; i < n; ++i)
+			triplets.push_back(SparseTriplet(i, i, degrees(i)));
+
+		SparseWeightMatrix laplacian(n, n);
+		laplacian.setFromTriplets(triplets.begin(), triplets.end());
+		return laplacian;
+	}
+}
+
+TEST(TapkeeEigendecomposition, lanczos_largest_vs_dense)
+{
+	const IndexType n = 200;
+	const IndexType target_dimension = 3;
+
+	DenseMatrix random_matrix(n, n);
+	for (IndexType j = 0; j < n; ++j)
+	{
+		for (IndexType i = 0; i < n; ++i)
+			random_matrix(i, j) = gaussian_random();
+	}
+	DenseMatrix m = random_matrix*random_matrix.transpose();
+
+	EigendecompositionResult lanczos = eigendecomposition(Lanczos,
+		HomogeneousCPUStrategy, LargestEigenvalues, m, target_dimension);
+	EigendecompositionResult dense = eigendecomposition(Dense,
+		HomogeneousCPUStrategy, LargestEigenvalues, m, target_dimension);
+	expect_same_eigenpairs(lanczos, dense, target_dimension);
+
+	// eigenvalues are in ascending order
+	for (IndexType i = 0; i+1 < target_dimension; ++i)
+		EXPECT_LT(lanczos.second(i), lanczos.second(i+1));
+}
+
+TEST(TapkeeEigendecomposition, lanczos_smallest_vs_dense)
+{
+	const IndexType n = 300;
+	const IndexType target_dimension = 3;
+
+	// the null space of the Laplacian is skipped
+	SparseWeightMatrix sparse_laplacian = path_laplacian(n);
+	EigendecompositionResult lanczos = eigendecomposition(Lanczos,
+		HomogeneousCPUStrategy, SmallestEigenvalues, sparse_laplacian, target_dimension);
+	EigendecompositionResult dense = eigendecomposition(Dense,
+		HomogeneousCPUStrategy, SmallestEigenvalues, sparse_laplacian, target_dimension);
+	expect_same_eigenpairs(lanczos, dense, target_dimension);
+	EXPECT_GT(lanczos.second(0), 1e-8);
+
+	DenseMatrix dense_laplacian = DenseMatrix(sparse_laplacian);
+	lanczos = eigendecomposition(Lanczos,
+		HomogeneousCPUStrategy, SmallestEigenvalues, dense_laplacian, target_dimension);
+	dense = eigendecomposition(Dense,
+		HomogeneousCPUStrategy, SmallestEigenvalues, dense_laplacian, target_dimension);
+	expect_same_eigenpairs(lanczos, dense, target_dimension);
+}
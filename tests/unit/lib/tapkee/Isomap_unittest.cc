@@ -0,0 +1,160 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <shogun/lib/tapkee/tapkee.hpp>
+
+using namespace tapkee;
+using namespace tapkee::tapkee_internal;
+
+namespace
+{
+	/* euclidean distance of points in the plane */
+	struct plane_distance_callback
+	{
+		plane_distance_callback(const DenseMatrix& p) : points(p) {}
+		inline ScalarType distance(IndexType a, IndexType b) const
+		{
+			return (points.col(a)-points.col(b)).norm();
+		}
+		const DenseMatrix& points;
+	};
+
+	/* jittered grid with edges between adjacent points in both directions
+	 * so that geodesic distances are symmetric */
+	void jittered_grid(IndexType width, IndexType height, DenseMatrix& points, Neighbors& neighbors)
+	{
+		const IndexType N = width*height;
+		points.resize(2,N);
+		neighbors.assign(N,LocalNeighbors());
+		for (IndexType x=0; x<width; x++)
+		{
+			for (IndexType y=0; y<height; y++)
+			{
+				IndexType i = x*height+y;
+				points(0,i) = x + 0.3*uniform_random();
+				points(1,i) = y + 0.3*uniform_random();
+				if (x>0)
+					neighbors[i].push_back(i-height);
+				if (x+1<width)
+					neighbors[i].push_back(i+height);
+				if (y>0)
+					neighbors[i].push_back(i-1);
+				if (y+1<height)
+					neighbors[i].push_back(i+1);
+			}
+		}
+	}
+}
+
+TEST(TapkeeIsomap, landmark_triangulation_vs_stored_distances)
+{
+	const IndexType target_dimension = 2;
+	DenseMatrix points;
+	Neighbors neighbors;
+	jittered_grid(12,9,points,neighbors);
+	const IndexType N = points.cols();
+
+	std::vector<IndexType> indices(N);
+	std::iota(indices.begin(), indices.end(), 0);
+	plane_distance_callback callback(points);
+
+	Landmarks landmarks;
+	for (IndexType i=0; i<N; i+=5)
+		landmarks.push_back(i);
+	const IndexType N_landmarks = landmarks.size();
+
+	// streamed landmark Isomap as done by the method
+	NeighborsGraph graph = neighbors_graph(indices.begin(),indices.end(),neighbors,callback);
+	DenseSymmetricMatrix landmark_distances = compute_landmark_shortest_distances_matrix(graph,landmarks);
+	DenseVector landmark_distances_squared = landmark_distances.colwise().mean();
+	centerMatrix(landmark_distances);
+	landmark_distances.array() *= -0.5;
+	EigendecompositionResult landmarks_embedding = eigendecomposition(Dense,
+		HomogeneousCPUStrategy, LargestEigenvalues, landmark_distances, target_dimension);
+	for (IndexType i=0; i<target_dimension; i++)
+		landmarks_embedding.first.col(i).array() *= std::sqrt(landmarks_embedding.second(i));
+	DenseMatrix landmark_coordinates = landmarks_embedding.first;
+	DenseMatrix embedding = triangulate_shortest_distances(graph,landmarks,
+		landmark_distances_squared,landmarks_embedding,target_dimension);
+	ASSERT_EQ(embedding.rows(), N);
+	ASSERT_EQ(embedding.cols(), target_dimension);
+
+	// triangulation from the stored geodesic distances of all vectors
+	DenseSymmetricMatrix geodesic = compute_shortest_distances_matrix(
+		indices.begin(),indices.end(),neighbors,callback);
+	DenseMatrix squared(N_landmarks,N);
+	for (IndexType k=0; k<N_landmarks; k++)
+		squared.row(k) = geodesic.row(landmarks[k]).array().square();
+	DenseMatrix landmark_squared(N_landmarks,N_landmarks);
+	for (IndexType l=0; l<N_landmarks; l++)
+		landmark_squared.col(l) = squared.col(landmarks[l]);
+	DenseVector mean_squared = landmark_squared.colwise().mean();
+	DenseMatrix pseudoinverse = landmark_coordinates;
+	for (IndexType i=0; i<target_dimension; i++)
+		pseudoinverse.col(i) /= landmarks_embedding.second(i);
+
+	for (IndexType j=0; j<N; j++)
+	{
+		DenseVector expected = -0.5*pseudoinverse.transpose()*(squared.col(j)-mean_squared);
+		for (IndexType i=0; i<target_dimension; i++)
+			EXPECT_NEAR(embedding(j,i), expected(i), 1e-8);
+	}
+
+	// landmarks are placed at their multidimensional scaling coordinates
+	for (IndexType k=0; k<N_landmarks; k++)
+	{
+		for (IndexType i=0; i<target_dimension; i++)
+			EXPECT_NEAR(embedding(landmarks[k],i), landmark_coordinates(k,i), 1e-8);
+	}
+}
+
+TEST(TapkeeIsomap, all_landmarks_equal_isomap)
+{
+	const IndexType target_dimension = 2;
+	DenseMatrix points;
+	Neighbors neighbors;
+	jittered_grid(10,7,points,neighbors);
+	const IndexType N = points.cols();
+
+	std::vector<IndexType> indices(N);
+	std::iota(indices.begin(), indices.end(), 0);
+	plane_distance_callback callback(points);
+
+	Landmarks landmarks(indices.begin(), indices.end());
+	NeighborsGraph graph = neighbors_graph(indices.begin(),indices.end(),neighbors,callback);
+	DenseSymmetricMatrix landmark_distances = compute_landmark_shortest_distances_matrix(graph,landmarks);
+	DenseVector landmark_distances_squared = landmark_distances.colwise().mean();
+	centerMatrix(landmark_distances);
+	landmark_distances.array() *= -0.5;
+	EigendecompositionResult landmarks_embedding = eigendecomposition(Dense,
+		HomogeneousCPUStrategy, LargestEigenvalues, landmark_distances, target_dimension);
+	for (IndexType i=0; i<target_dimension; i++)
+		landmarks_embedding.first.col(i).array() *= std::sqrt(landmarks_embedding.second(i));
+	DenseMatrix embedding = triangulate_shortest_distances(graph,landmarks,
+		landmark_distances_squared,landmarks_embedding,target_dimension);
+
+	// plain Isomap
+	DenseSymmetricMatrix geodesic = compute_shortest_distances_matrix(
+		indices.begin(),indices.end(),neighbors,callback);
+	geodesic = geodesic.array().square();
+	centerMatrix(geodesic);
+	geodesic.array() *= -0.5;
+	EigendecompositionResult expected = eigendecomposition(Dense,
+		HomogeneousCPUStrategy, LargestEigenvalues, geodesic, target_dimension);
+	for (IndexType i=0; i<target_dimension; i++)
+		expected.first.col(i).array() *= std::sqrt(expected.second(i));
+
+	// coordinates are only defined up to their sign
+	for (IndexType i=0; i<target_dimension; i++)
+	{
+		ScalarType sign = embedding.col(i).dot(expected.first.col(i)) < 0 ? -1.0 : 1.0;
+		for (IndexType j=0; j<N; j++)
+			EXPECT_NEAR(embedding(j,i), sign*expected.first(j,i), 1e-8);
+	}
+}
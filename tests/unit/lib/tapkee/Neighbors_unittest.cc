@@ -0,0 +1,79 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <shogun/lib/tapkee/tapkee.hpp>
+
+using namespace tapkee;
+using namespace tapkee::tapkee_internal;
+
+namespace
+{
+	/* distance of points on a line, optionally with self distances that are
+	 * not exactly zero as with distances computed from kernels */
+	struct line_distance_callback
+	{
+		line_distance_callback(const std::vector<ScalarType>& p, ScalarType s) :
+			points(p), self_distance(s) {}
+		inline ScalarType distance(IndexType a, IndexType b) const
+		{
+			return a == b ? self_distance : std::abs(points[a]-points[b]);
+		}
+		const std::vector<ScalarType>& points;
+		ScalarType self_distance;
+	};
+}
+
+TEST(TapkeeNeighbors, vptree_with_duplicates)
+{
+	// groups of duplicates, some larger than the number of neighbors
+	const std::vector<ScalarType> points = {
+		0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 3.5, 5, 5, 7, 8, 8, 8, 8, 10, 0, 8, 8.25};
+	const IndexType num_points = points.size();
+	const IndexType k = 4;
+
+	std::vector<IndexType> indices(num_points);
+	std::iota(indices.begin(), indices.end(), 0);
+	typedef std::vector<IndexType>::iterator Iterator;
+
+	// with a self distance of 0.5 the query point is not among the k+1
+	// points the tree finds for the points at 8
+	for (ScalarType self_distance : {0.0, 0.5})
+	{
+		line_distance_callback callback(points, self_distance);
+		PlainDistance<Iterator, line_distance_callback> distance(callback);
+
+		Neighbors neighbors = find_neighbors(
+			VpTree, indices.begin(), indices.end(), distance, k, false);
+		ASSERT_EQ(neighbors.size(), static_cast<size_t>(num_points));
+
+		for (IndexType i = 0; i < num_points; ++i)
+		{
+			std::vector<ScalarType> expected;
+			for (IndexType j = 0; j < num_points; ++j)
+			{
+				if (j != i)
+					expected.push_back(callback.distance(i, j));
+			}
+			std::sort(expected.begin(), expected.end());
+			expected.resize(k);
+
+			ASSERT_EQ(neighbors[i].size(), static_cast<size_t>(k));
+			std::vector<ScalarType> found;
+			for (auto j : neighbors[i])
+			{
+				EXPECT_NE(j, i);
+				found.push_back(callback.distance(i, j));
+			}
+			std::sort(found.begin(), found.end());
+			for (IndexType j = 0; j < k; ++j)
+				EXPECT_EQ(found[j], expected[j]);
+		}
+	}
+}
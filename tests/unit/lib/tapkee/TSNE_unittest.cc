@@ -0,0 +1,70 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <shogun/lib/tapkee/tapkee.hpp>
+
+using namespace tapkee;
+
+TEST(TapkeeTSNE, fft_repulsion_vs_exact)
+{
+	const int N = 200;
+	const int D = 2;
+
+	// clusters of different spread so that both near and far interactions
+	// contribute
+	std::srand(7);
+	std::vector<ScalarType> Y(N*D);
+	for (int n = 0; n < N; n++)
+	{
+		ScalarType center = (n % 3) * 8.0 - 8.0;
+		ScalarType spread = 0.5 + (n % 3);
+		Y[n*D] = center + spread*gaussian_random();
+		Y[n*D+1] = -center + spread*gaussian_random();
+	}
+
+	std::vector<ScalarType> neg_f(N*D);
+	ScalarType sum_Q = 0.0;
+	tsne::TSNE().computeFFTRepulsion(Y.data(), N, neg_f.data(), &sum_Q);
+
+	// exact sums over all pairs as in the exact gradient
+	std::vector<ScalarType> exact_neg_f(N*D, 0.0);
+	ScalarType exact_sum_Q = 0.0;
+	for (int n = 0; n < N; n++)
+	{
+		for (int m = 0; m < N; m++)
+		{
+			if (n == m)
+				continue;
+			ScalarType dx = Y[n*D] - Y[m*D];
+			ScalarType dy = Y[n*D+1] - Y[m*D+1];
+			ScalarType q = 1.0 / (1.0 + dx*dx + dy*dy);
+			exact_sum_Q += q;
+			exact_neg_f[n*D] += q*q*dx;
+			exact_neg_f[n*D+1] += q*q*dy;
+		}
+	}
+
+	ScalarType max_force = 0.0;
+	ScalarType squared_error = 0.0;
+	ScalarType squared_norm = 0.0;
+	for (int i = 0; i < N*D; i++)
+	{
+		max_force = std::max(max_force, std::abs(exact_neg_f[i]));
+		squared_error += (neg_f[i]-exact_neg_f[i])*(neg_f[i]-exact_neg_f[i]);
+		squared_norm += exact_neg_f[i]*exact_neg_f[i];
+	}
+
+	// quadratic interpolation on the default grid is accurate to about half
+	// a percent of the forces, a wrong kernel or grid is off by far more
+	EXPECT_NEAR(sum_Q, exact_sum_Q, 1e-3*exact_sum_Q);
+	EXPECT_LT(std::sqrt(squared_error/squared_norm), 1e-2);
+	for (int i = 0; i < N*D; i++)
+		EXPECT_NEAR(neg_f[i], exact_neg_f[i], 3e-2*max_force);
+}
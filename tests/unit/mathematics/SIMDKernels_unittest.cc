@@ -0,0 +1,111 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/range.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/SIMDKernels.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+/* lengths cover the vectorized blocks as well as the remainders */
+static const index_t lengths[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 100};
+
+template <class T>
+class SIMDSparseKernelsTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<float32_t, float64_t> FloatTypes;
+TYPED_TEST_CASE(SIMDSparseKernelsTest, FloatTypes);
+
+TYPED_TEST(SIMDSparseKernelsTest, dot_and_axpy)
+{
+	const index_t dim = 50;
+	std::mt19937_64 prng(3);
+	UniformIntDistribution<index_t> uniform_index(0, dim - 1);
+	UniformRealDistribution<float64_t> uniform(-1.0, 1.0);
+
+	SGVector<float64_t> dense(dim);
+	for (auto i : range(dim))
+		dense[i] = uniform(prng);
+
+	for (auto nnz : lengths)
+	{
+		/* entries repeat feature indices, which axpy has to add up */
+		SGSparseVector<TypeParam> vec(nnz);
+		SGVector<index_t> indices(nnz);
+		SGVector<TypeParam> values(nnz);
+		for (auto k : range(nnz))
+		{
+			indices[k] = uniform_index(prng);
+			values[k] = uniform(prng);
+			vec.features[k].feat_index = indices[k];
+			vec.features[k].entry = values[k];
+		}
+
+		float64_t expected = simd::sparse_dot<TypeParam>(
+		    indices.vector, 1, values.vector, 1, nnz, dense.vector);
+		EXPECT_NEAR(
+		    simd::sparse_dot(
+		        indices.vector, 1, values.vector, 1, nnz, dense.vector),
+		    expected, 1e-12);
+		EXPECT_NEAR(simd::sparse_dot(vec, dense.vector), expected, 1e-12);
+
+		SGVector<float64_t> expected_sum = dense.clone();
+		simd::sparse_axpy<TypeParam>(
+		    0.5, indices.vector, 1, values.vector, 1, nnz,
+		    expected_sum.vector);
+		SGVector<float64_t> sum = dense.clone();
+		simd::sparse_axpy(
+		    0.5, indices.vector, 1, values.vector, 1, nnz, sum.vector);
+		SGVector<float64_t> entries_sum = dense.clone();
+		simd::sparse_axpy(0.5, vec, entries_sum.vector);
+		for (auto i : range(dim))
+		{
+			EXPECT_NEAR(sum[i], expected_sum[i], 1e-12);
+			EXPECT_NEAR(entries_sum[i], expected_sum[i], 1e-12);
+		}
+	}
+}
+
+TEST(SIMDKernelsTest, dense_single_precision)
+{
+	const index_t num_vectors = 7;
+	std::mt19937_64 prng(5);
+	UniformRealDistribution<float64_t> uniform(-1.0, 1.0);
+
+	for (auto len : lengths)
+	{
+		SGVector<float32_t> x(len * num_vectors);
+		SGVector<float64_t> w(len);
+		for (auto i : range(x.vlen))
+			x[i] = uniform(prng);
+		for (auto i : range(len))
+			w[i] = uniform(prng);
+
+		SGVector<float64_t> output(num_vectors);
+		simd::dense_dot_batch(x.vector, len, num_vectors, w.vector, output.vector);
+		for (auto v : range(num_vectors))
+		{
+			float64_t expected = 0;
+			for (auto i : range(len))
+				expected += x[v * len + i] * w[i];
+			EXPECT_NEAR(output[v], expected, 1e-12);
+			EXPECT_NEAR(
+			    simd::dense_dot(x.vector + v * len, w.vector, len), expected,
+			    1e-12);
+		}
+
+		SGVector<float64_t> y = w.clone();
+		simd::dense_axpy(2.0, x.vector, y.vector, len);
+		for (auto i : range(len))
+			EXPECT_NEAR(y[i], w[i] + 2.0 * x[i], 1e-12);
+	}
+}
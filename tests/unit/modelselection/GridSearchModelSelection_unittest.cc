@@ -0,0 +1,120 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/CrossValidation.h>
+#include <shogun/evaluation/CrossValidationSplitting.h>
+#include <shogun/evaluation/MeanSquaredError.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/modelselection/GridSearchModelSelection.h>
+#include <shogun/modelselection/ModelSelectionParameters.h>
+#include <shogun/modelselection/ParameterCombination.h>
+#include <shogun/regression/LinearRidgeRegression.h>
+
+#include <random>
+
+using namespace shogun;
+
+class GridSearchModelSelectionTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		auto N = 100;
+		auto D = 3;
+
+		std::mt19937_64 prng(57);
+		NormalDistribution<float64_t> randn;
+
+		/* noise free linear data: the smallest regularization is best */
+		SGMatrix<float64_t> X(D, N);
+		SGVector<float64_t> y(N);
+		for (auto i : range(N))
+		{
+			y[i] = 0;
+			for (auto j : range(D))
+			{
+				X(j, i) = randn(prng);
+				y[i] += (j + 1) * X(j, i);
+			}
+		}
+
+		features = new CDenseFeatures<float64_t>(X);
+		labels = new CRegressionLabels(y);
+		machine = new CLinearRidgeRegression();
+		SG_REF(features);
+		SG_REF(labels);
+		SG_REF(machine);
+
+		auto splitting = new CCrossValidationSplitting(labels, 5);
+		auto cv = new CCrossValidation(
+		    machine, features, labels, splitting, new CMeanSquaredError());
+		cv->put("seed", 1);
+
+		auto root = new CModelSelectionParameters();
+		auto tau = new CModelSelectionParameters("tau");
+		tau->build_values(-3.0, 3.0, R_EXP);
+		root->append_child(tau);
+
+		grid_search = new CGridSearchModelSelection(cv, root);
+		SG_REF(grid_search);
+	}
+
+	void TearDown()
+	{
+		SG_UNREF(grid_search);
+		SG_UNREF(machine);
+		SG_UNREF(labels);
+		SG_UNREF(features);
+	}
+
+	float64_t select_tau()
+	{
+		auto best = grid_search->select_model();
+		EXPECT_NE(best, nullptr);
+
+		auto tuned = new CLinearRidgeRegression();
+		best->apply_to_machine(tuned);
+		auto tau = tuned->get<float64_t>("tau");
+
+		SG_UNREF(tuned);
+		SG_UNREF(best);
+		return tau;
+	}
+
+	CFeatures* features;
+	CLabels* labels;
+	CMachine* machine;
+	CGridSearchModelSelection* grid_search;
+};
+
+TEST_F(GridSearchModelSelectionTest, single_thread)
+{
+	env()->set_num_threads(1);
+	EXPECT_NEAR(select_tau(), 0.125, 1e-10);
+}
+
+TEST_F(GridSearchModelSelectionTest, multi_thread)
+{
+	env()->set_num_threads(4);
+	EXPECT_NEAR(select_tau(), 0.125, 1e-10);
+}
+
+TEST_F(GridSearchModelSelectionTest, successive_halving)
+{
+	env()->set_num_threads(4);
+	grid_search->set_halving_factor(2);
+	EXPECT_NEAR(select_tau(), 0.125, 1e-10);
+}
+
+TEST_F(GridSearchModelSelectionTest, regularization_path)
+{
+	env()->set_num_threads(4);
+	grid_search->set_path_parameter("tau");
+	EXPECT_NEAR(select_tau(), 0.125, 1e-10);
+}
@@ -29,6 +29,8 @@
  *
  */
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 
 #include "StochasticMinimizers_unittest.h"
 
@@ -51,6 +53,9 @@
 #include <shogun/optimization/ElasticNetPenalty.h>
 #include <shogun/optimization/SMIDASMinimizer.h>
 #include <shogun/optimization/PNormMappingFunction.h>
+#include <shogun/optimization/AdaGradUpdater.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
 using namespace shogun;
 using namespace Eigen;
 
@@ -362,6 +367,51 @@ bool ClassificationForTestCostFunction2::next_sample()
 	return true;
 }
 
+SGSparseVector<float64_t> SparseClassificationForTestCostFunction::get_sparse_gradient()
+{
+	return get_sample_sparse_gradient(m_sample_idx);
+}
+
+SGVector<index_t> SparseClassificationForTestCostFunction::get_sparse_gradient_support()
+{
+	std::vector<index_t> support;
+	for(index_t j=0; j<m_features.num_rows; j++)
+	{
+		if(m_features(j,m_sample_idx)!=0.0)
+			support.push_back(j);
+	}
+	return SGVector<index_t>(support.begin(), support.end());
+}
+
+SGSparseVector<float64_t> SparseClassificationForTestCostFunction::get_sample_sparse_gradient(index_t idx)
+{
+	index_t num_entries=0;
+	for(index_t j=0; j<m_features.num_rows; j++)
+	{
+		if(m_features(j,idx)!=0.0)
+			num_entries++;
+	}
+
+	Map<VectorXd> e_w(m_weight.vector,m_weight.vlen);
+	Map<MatrixXd> e_x(m_features.matrix, m_features.num_rows, m_features.num_cols);
+	float64_t tmp=e_w.dot(e_x.col(idx));
+	tmp=exp(tmp*m_labels[idx]);
+	float64_t w=m_labels[idx]*tmp / (1.0+tmp);
+
+	SGSparseVector<float64_t> result(num_entries);
+	index_t k=0;
+	for(index_t j=0; j<m_features.num_rows; j++)
+	{
+		if(m_features(j,idx)!=0.0)
+		{
+			result.features[k].feat_index=j;
+			result.features[k].entry=w*m_features(j,idx);
+			k++;
+		}
+	}
+	return result;
+}
+
 struct ClassificationFixture
 {
 	ClassificationFixture(){init();}
@@ -417,6 +467,47 @@ void ClassificationFixture::init()
 }
 
 
+struct SparseClassificationFixture
+{
+	SparseClassificationFixture(){init();}
+	SGVector<float64_t> y;
+	SGMatrix<float64_t> x;
+	void init();
+};
+
+void SparseClassificationFixture::init()
+{
+	//each of 50 samples has 3 non-zero features out of 20
+	//labels are given by a fixed linear classifier
+	const index_t num_features=20;
+	const index_t num_samples=50;
+	std::mt19937_64 prng(12);
+	NormalDistribution<float64_t> normal_dist;
+	UniformIntDistribution<index_t> uniform_int_dist(0, num_features-1);
+
+	y=SGVector<float64_t>(num_samples);
+	x=SGMatrix<float64_t>(num_features,num_samples);
+	x.zero();
+	for(index_t i=0; i<num_samples; i++)
+	{
+		index_t num_entries=0;
+		while(num_entries<3)
+		{
+			index_t j=uniform_int_dist(prng);
+			if(x(j,i)==0.0)
+			{
+				x(j,i)=normal_dist(prng);
+				num_entries++;
+			}
+		}
+
+		float64_t score=0.0;
+		for(index_t j=0; j<num_features; j++)
+			score+=(j%2 ? 1.0 : -1.0)*(1+j%3)*x(j,i);
+		y[i]=score>0 ? 1.0 : -1.0;
+	}
+}
+
 struct RegressionFixture
 {
 	RegressionFixture() {init();}
@@ -1086,3 +1177,92 @@ TEST(SMIDASMinimizer, test1)
 
 	delete opt;
 }
+
+TEST(SGDMinimizer,lazy_update)
+{
+	SparseClassificationFixture data;
+	for(index_t type=0; type<3; type++)
+	{
+		SGVector<float64_t> w[2];
+		for(index_t sparse=0; sparse<2; sparse++)
+		{
+			SparseClassificationForTestCostFunction* bb=new SparseClassificationForTestCostFunction();
+			bb->set_data(data.x, data.y);
+			bb->set_sparse_gradient(sparse);
+			SGDMinimizer* opt=new SGDMinimizer(bb);
+
+			DescendUpdater* updater;
+			if(type==0)
+				updater=new GradientDescendUpdater();
+			else if(type==1)
+				updater=new AdaGradUpdater(1.0, 1e-6);
+			else
+				updater=new RmsPropUpdater(0.1, 1e-6, 0.9);
+			EXPECT_TRUE(updater->supports_lazy_update());
+
+			ConstLearningRate* rate=new ConstLearningRate();
+			rate->set_const_learning_rate(0.5);
+			opt->set_gradient_updater(updater);
+			opt->set_learning_rate(rate);
+			opt->set_number_passes(3);
+			opt->minimize();
+			w[sparse]=bb->obtain_variable_reference();
+
+			delete opt;
+		}
+
+		//entries with zero gradient are not moved by these updaters,
+		//so lazy updates give the same result
+		for(index_t j=0; j<w[0].vlen; j++)
+			EXPECT_NEAR(w[0][j],w[1][j],1e-10);
+	}
+}
+
+TEST(SGDMinimizer,asynchronous_update)
+{
+	SparseClassificationFixture data;
+	SparseClassificationForTestCostFunction* bb=new SparseClassificationForTestCostFunction();
+	bb->set_data(data.x, data.y);
+	float64_t initial_cost=bb->get_cost();
+
+	SGDMinimizer* opt=new SGDMinimizer(bb);
+	opt->set_gradient_updater(new AdaGradUpdater(1.0, 1e-6));
+	opt->set_number_passes(20);
+	opt->set_asynchronous_update(true);
+	EXPECT_TRUE(opt->get_asynchronous_update());
+	float64_t cost=opt->minimize();
+
+	EXPECT_NEAR(cost,bb->get_cost(),1e-10);
+	EXPECT_LT(cost,0.2*initial_cost);
+
+	delete opt;
+}
+
+TEST(SVRGMinimizer,lazy_update)
+{
+	SparseClassificationFixture data;
+	SGVector<float64_t> w[2];
+	for(index_t sparse=0; sparse<2; sparse++)
+	{
+		SparseClassificationForTestCostFunction* bb=new SparseClassificationForTestCostFunction();
+		bb->set_data(data.x, data.y);
+		bb->set_sparse_gradient(sparse);
+
+		SVRGMinimizer* opt=new SVRGMinimizer(bb);
+		ConstLearningRate* rate=new ConstLearningRate();
+		rate->set_const_learning_rate(0.5);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_learning_rate(rate);
+		opt->set_number_passes(4);
+		opt->set_sgd_number_passes(0);
+		opt->set_average_update_interval(2);
+		opt->minimize();
+		w[sparse]=bb->obtain_variable_reference();
+
+		delete opt;
+	}
+
+	//the average gradient is applied just in time with the same result
+	for(index_t j=0; j<w[0].vlen; j++)
+		EXPECT_NEAR(w[0][j],w[1][j],1e-10);
+}
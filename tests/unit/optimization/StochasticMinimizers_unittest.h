@@ -98,6 +98,22 @@ public:
 	virtual const char* get_name() const { return "ClassificationForTestCostFunction2"; }
 };
 
+class SparseClassificationForTestCostFunction: public ClassificationForTestCostFunction2
+{
+public:
+	SparseClassificationForTestCostFunction()
+		:ClassificationForTestCostFunction2(), m_sparse_gradient(true){};
+	virtual ~SparseClassificationForTestCostFunction(){};
+	void set_sparse_gradient(bool sparse_gradient){m_sparse_gradient=sparse_gradient;}
+	virtual bool has_sparse_gradient(){return m_sparse_gradient;}
+	virtual SGSparseVector<float64_t> get_sparse_gradient();
+	virtual SGVector<index_t> get_sparse_gradient_support();
+	virtual SGSparseVector<float64_t> get_sample_sparse_gradient(index_t idx);
+	virtual const char* get_name() const { return "SparseClassificationForTestCostFunction"; }
+private:
+	bool m_sparse_gradient;
+};
+
 class CRegressionExample: public CSGObject
 {
 friend class RegressionForTestCostFunction;
@@ -285,3 +285,45 @@ TEST(lbfgs, lbfgs_with_adjust_step_test2)
 	EXPECT_PRED_FORMAT2(::testing::DoubleLE, strict_scale, x[3]);
 	EXPECT_PRED_FORMAT2(::testing::DoubleLE, strict_scale, x[4]);
 }
+
+float64_t evaluate_shard(void *obj, const float64_t *variable, float64_t *gradient,
+	const int dim, const float64_t step, const int shard, const int num_shards)
+{
+	float64_t * non_const_variable=const_cast<float64_t *>(variable);
+	const Map<VectorXd> eigen_x(non_const_variable, dim);
+	float64_t weight=shard+1;
+	float64_t f=weight*(eigen_x.array()-shard).pow(2.0).sum();
+
+	Map<VectorXd> eigen_g(gradient, dim);
+	eigen_g=(eigen_x.array()-shard)*2.0*weight;
+
+	return f;
+}
+
+TEST(lbfgs, lbfgs_sharded)
+{
+	index_t len=5;
+	int32_t num_shards=4;
+	SGVector<float64_t> x(len);
+	Map<VectorXd> eigen_x(x.vector, x.vlen);
+	eigen_x.fill(10);
+	lbfgs_parameter_t lbfgs_param=init_lbfgs_parameters();
+	float64_t opt_value=CMath::INFTY;
+	int32_t ret=lbfgs_sharded(x.vlen, x.vector, &opt_value,
+		evaluate_shard, num_shards, NULL, NULL, &lbfgs_param);
+	EXPECT_GE(ret, 0);
+
+	// minimizer is the weighted mean of shard targets 0,1,2,3 with weights 1,2,3,4
+	float64_t rel_tolerance = 1e-12;
+	float64_t abs_tolerance;
+
+	abs_tolerance = CMath::get_abs_tolerance(10*len, rel_tolerance);
+	EXPECT_NEAR(opt_value, 10*len, abs_tolerance);
+
+	abs_tolerance = CMath::get_abs_tolerance(2, rel_tolerance);
+	for (index_t i=0; i<len; i++)
+		EXPECT_NEAR(x[i], 2, abs_tolerance);
+
+	EXPECT_EQ(LBFGSERR_INVALIDPARAMETERS, lbfgs_sharded(x.vlen, x.vector,
+		&opt_value, evaluate_shard, 0, NULL, NULL, &lbfgs_param));
+}
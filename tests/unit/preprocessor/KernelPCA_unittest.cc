@@ -101,3 +101,140 @@ TEST(KernelPCA, apply_to_feature_vector)
 	SG_UNREF(kpca);
 	SG_UNREF(kernel);
 }
+
+TEST(KernelPCA, nystroem_all_landmarks)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	auto train_feats = some<CDenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = some<CDenseFeatures<float64_t>>(test_matrix);
+
+	auto kernel = some<CGaussianKernel>();
+	kernel->set_width(1);
+
+	// landmarks sampled without replacement cover the whole training set,
+	// which makes the approximation exact
+	auto kpca = some<CKernelPCA>(kernel);
+	kpca->put("seed", 1);
+	kpca->set_method(KPCA_NYSTROEM);
+	kpca->set_landmark_selection(LANDMARKS_LEVERAGE);
+	kpca->set_num_landmarks(num_vectors);
+	kpca->set_target_dim(target_dim);
+	kpca->fit(train_feats);
+
+	SGMatrix<float64_t> embedding = kpca->transform(test_feats)
+	                                    ->as<CDenseFeatures<float64_t>>()
+	                                    ->get_feature_matrix();
+
+	ASSERT_EQ(embedding.num_rows, target_dim);
+	ASSERT_EQ(embedding.num_cols, num_test_vectors);
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(CMath::abs(embedding[i]), CMath::abs(resdata[i]), 1E-6);
+}
+
+TEST(KernelPCA, random_features)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	auto train_feats = some<CDenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = some<CDenseFeatures<float64_t>>(test_matrix);
+
+	auto kernel = some<CGaussianKernel>();
+	kernel->set_width(1);
+
+	auto kpca = some<CKernelPCA>(kernel);
+	kpca->set_method(KPCA_RANDOM_FEATURES);
+	kpca->set_num_random_features(50);
+	kpca->set_target_dim(target_dim);
+
+	kpca->put("seed", 1);
+	kpca->fit(train_feats);
+	SGMatrix<float64_t> embedding = kpca->transform(test_feats)
+	                                    ->as<CDenseFeatures<float64_t>>()
+	                                    ->get_feature_matrix();
+
+	kpca->put("seed", 1);
+	kpca->fit(train_feats);
+	SGMatrix<float64_t> embedding_again = kpca->transform(test_feats)
+	                                          ->as<CDenseFeatures<float64_t>>()
+	                                          ->get_feature_matrix();
+
+	ASSERT_EQ(embedding.num_rows, target_dim);
+	ASSERT_EQ(embedding.num_cols, num_test_vectors);
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_EQ(embedding[i], embedding_again[i]);
+}
+
+TEST(KernelPCA, random_features_approximate_exact)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	auto train_feats = some<CDenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = some<CDenseFeatures<float64_t>>(test_matrix);
+
+	// a width for which the two leading eigenvalues are well separated from
+	// the third, so that the embedded subspace is stable
+	auto kernel = some<CGaussianKernel>();
+	kernel->set_width(10);
+
+	auto exact = some<CKernelPCA>(kernel);
+	exact->set_target_dim(target_dim);
+	exact->fit(train_feats);
+
+	auto approximate = some<CKernelPCA>(kernel);
+	approximate->put("seed", 1);
+	approximate->set_method(KPCA_RANDOM_FEATURES);
+	approximate->set_num_random_features(5000);
+	approximate->set_target_dim(target_dim);
+	approximate->fit(train_feats);
+
+	SGMatrix<float64_t> embeddings[2];
+	CKernelPCA* kpcas[] = {exact.get(), approximate.get()};
+	for (index_t k = 0; k < 2; ++k)
+	{
+		embeddings[k] =
+		    SGMatrix<float64_t>(target_dim, num_vectors + num_test_vectors);
+		SGMatrix<float64_t> train_embedding =
+		    kpcas[k]->apply_to_feature_matrix(train_feats);
+		SGMatrix<float64_t> test_embedding =
+		    kpcas[k]->apply_to_feature_matrix(test_feats);
+		for (index_t i = 0; i < target_dim; ++i)
+		{
+			for (index_t j = 0; j < num_vectors; ++j)
+				embeddings[k](i, j) = train_embedding(i, j);
+			for (index_t j = 0; j < num_test_vectors; ++j)
+				embeddings[k](i, num_vectors + j) = test_embedding(i, j);
+		}
+	}
+
+	// pairwise distances do not depend on the signs of the components, the
+	// kernel approximation error of 5000 features is about 1/sqrt(5000)
+	// while the largest distance is about 1.4
+	for (index_t i = 0; i < num_vectors + num_test_vectors; ++i)
+	{
+		for (index_t j = 0; j < i; ++j)
+		{
+			float64_t distances[2];
+			for (index_t k = 0; k < 2; ++k)
+			{
+				float64_t squared = 0;
+				for (index_t d = 0; d < target_dim; ++d)
+					squared += CMath::sq(embeddings[k](d, i) - embeddings[k](d, j));
+				distances[k] = std::sqrt(squared);
+			}
+			EXPECT_NEAR(distances[0], distances[1], 0.1);
+		}
+	}
+}
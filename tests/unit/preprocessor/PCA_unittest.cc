@@ -7,12 +7,16 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <shogun/preprocessor/PCA.h>
 
+#include <random>
+
 using namespace shogun;
 
 /** Check eigenvector equality
@@ -603,3 +607,88 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+/** Noise free data of rank 2 with an offset, so that the truncated randomized
+ * and streaming decompositions are exact
+ */
+static SGMatrix<float64_t> low_rank_data(index_t num_features, index_t num_vectors)
+{
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> randn;
+
+	SGMatrix<float64_t> basis(num_features, 2);
+	for (auto i : range(basis.size()))
+		basis[i] = randn(prng);
+
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (auto i : range(num_vectors))
+	{
+		auto a = 3.0 * randn(prng);
+		auto b = randn(prng);
+		for (auto j : range(num_features))
+			data(j, i) = a * basis(j, 0) + b * basis(j, 1) + j;
+	}
+	return data;
+}
+
+TEST(PCA, PCA_RANDOMIZED_vs_SVD)
+{
+	auto data = low_rank_data(20, 100);
+
+	auto features = some<CDenseFeatures<float64_t>>(data);
+	auto pca = some<CPCA>(SVD);
+	pca->set_target_dim(2);
+	pca->fit(features);
+
+	auto randomized = some<CPCA>(RANDOMIZED);
+	randomized->put("seed", 1);
+	randomized->set_target_dim(2);
+	randomized->set_oversampling(3);
+	randomized->fit(features);
+
+	auto eigvals = pca->get_eigenvalues();
+	auto randomized_eigvals = randomized->get_eigenvalues();
+	auto transmat = pca->get_transformation_matrix();
+	auto randomized_transmat = randomized->get_transformation_matrix();
+	ASSERT_EQ(randomized_eigvals.vlen, 2);
+	for (auto i : range(2))
+	{
+		EXPECT_NEAR(eigvals[i], randomized_eigvals[i], 1e-8);
+		check_eigenvector_eq(
+		    transmat.get_column(i), randomized_transmat.get_column(i));
+	}
+}
+
+TEST(PCA, PCA_streaming_vs_SVD)
+{
+	auto data = low_rank_data(20, 100);
+
+	auto features = some<CDenseFeatures<float64_t>>(data);
+	auto pca = some<CPCA>(SVD);
+	pca->set_target_dim(2);
+	pca->fit(features);
+
+	auto streaming_features =
+	    some<CStreamingDenseFeatures<float64_t>>(features.get());
+	auto streaming = some<CPCA>();
+	streaming->set_target_dim(2);
+	streaming->set_batch_size(30);
+	streaming->fit(streaming_features);
+
+	auto mean = pca->get_mean();
+	auto streaming_mean = streaming->get_mean();
+	for (auto i : range(mean.vlen))
+		EXPECT_NEAR(mean[i], streaming_mean[i], 1e-10);
+
+	auto eigvals = pca->get_eigenvalues();
+	auto streaming_eigvals = streaming->get_eigenvalues();
+	auto transmat = pca->get_transformation_matrix();
+	auto streaming_transmat = streaming->get_transformation_matrix();
+	ASSERT_EQ(streaming_eigvals.vlen, 2);
+	for (auto i : range(2))
+	{
+		EXPECT_NEAR(eigvals[i], streaming_eigvals[i], 1e-8);
+		check_eigenvector_eq(
+		    transmat.get_column(i), streaming_transmat.get_column(i));
+	}
+}
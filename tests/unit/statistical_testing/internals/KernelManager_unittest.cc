@@ -29,9 +29,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/some.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/distance/CustomDistance.h>
+#include <shogun/distance/Distance.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/statistical_testing/internals/KernelManager.h>
 
@@ -67,3 +70,78 @@ TEST(KernelManager, store_precompute_restore)
 	ASSERT_TRUE(const_kernel_mgr.kernel_at(0)==kernel);
 	ASSERT_TRUE(const_kernel_mgr.kernel_at(0)->get_kernel_type()==K_GAUSSIAN);
 }
+
+TEST(KernelManager, kernel_matrix_from_shared_distance)
+{
+	const index_t dim=2;
+	const index_t num_vec=10;
+
+	SGMatrix<float64_t> data(dim, num_vec);
+	for (auto i=0; i<dim*num_vec; ++i)
+		data.matrix[i]=i*0.1;
+	auto feats=some<CDenseFeatures<float64_t>>(data);
+
+	KernelManager kernel_mgr;
+	for (auto width : {0.5, 1.0, 2.0})
+		kernel_mgr.push_back(new CGaussianKernel(width));
+	const KernelManager& const_kernel_mgr=kernel_mgr;
+	ASSERT_TRUE(const_kernel_mgr.same_distance_type());
+
+	auto distance=const_kernel_mgr.get_distance_instance();
+	distance->init(feats, feats);
+	auto precomputed_distance=some<CCustomDistance>(distance);
+	SG_UNREF(distance);
+
+	for (auto k=0; k<const_kernel_mgr.num_kernels(); ++k)
+	{
+		auto kernel_matrix=const_kernel_mgr.kernel_matrix_at(k, precomputed_distance.get());
+
+		CKernel* kernel=const_kernel_mgr.kernel_at(k);
+		kernel->init(feats, feats);
+		auto expected=kernel->get_kernel_matrix<float32_t>();
+		kernel->remove_lhs_and_rhs();
+
+		ASSERT_EQ(kernel_matrix.num_rows, num_vec);
+		ASSERT_EQ(kernel_matrix.num_cols, num_vec);
+		for (auto i=0; i<num_vec*num_vec; ++i)
+			EXPECT_NEAR(kernel_matrix.matrix[i], expected.matrix[i], 1E-6);
+	}
+}
+
+TEST(KernelManager, kernel_matrix_follows_modified_kernel)
+{
+	const index_t dim=2;
+	const index_t num_vec=10;
+
+	SGMatrix<float64_t> data(dim, num_vec);
+	for (auto i=0; i<dim*num_vec; ++i)
+		data.matrix[i]=i*0.1;
+	auto feats=some<CDenseFeatures<float64_t>>(data);
+
+	auto kernel=new CGaussianKernel(0.5);
+	KernelManager kernel_mgr;
+	kernel_mgr.push_back(kernel);
+	const KernelManager& const_kernel_mgr=kernel_mgr;
+
+	auto distance=const_kernel_mgr.get_distance_instance();
+	distance->init(feats, feats);
+	auto precomputed_distance=some<CCustomDistance>(distance);
+	SG_UNREF(distance);
+
+	// the copy of the kernel made by the first call is reused by the second
+	// one, and replaced after the width changed
+	for (auto width : {0.5, 0.5, 3.0})
+	{
+		kernel->set_width(width);
+		auto kernel_matrix=const_kernel_mgr.kernel_matrix_at(0, precomputed_distance.get());
+
+		kernel->init(feats, feats);
+		auto expected=kernel->get_kernel_matrix<float32_t>();
+		kernel->remove_lhs_and_rhs();
+
+		ASSERT_EQ(kernel_matrix.num_rows, num_vec);
+		ASSERT_EQ(kernel_matrix.num_cols, num_vec);
+		for (auto i=0; i<num_vec*num_vec; ++i)
+			EXPECT_NEAR(kernel_matrix.matrix[i], expected.matrix[i], 1E-6);
+	}
+}
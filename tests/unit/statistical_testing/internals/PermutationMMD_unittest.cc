@@ -357,6 +357,60 @@ TEST(PermutationMMD, precomputed_vs_non_precomputed_single_kernel)
 	SG_UNREF(feats);
 }
 
+TEST(PermutationMMD, blocked_vs_non_precomputed_single_kernel)
+{
+	const index_t seed=17;
+	const index_t dim=2;
+	// more samples than a kernel tile and more permutations than a block
+	const index_t n=160;
+	const index_t m=160;
+	const index_t num_null_samples=100;
+
+	std::mt19937_64 prng(seed);
+
+	SGMatrix<float64_t> data_p(dim, n);
+	std::iota(data_p.matrix, data_p.matrix+dim*n, 1);
+	std::for_each(data_p.matrix, data_p.matrix+dim*n, [&n](float64_t& val) { val/=n; });
+
+	SGMatrix<float64_t> data_q(dim, m);
+	std::iota(data_q.matrix, data_q.matrix+dim*m, n+1);
+	std::for_each(data_q.matrix, data_q.matrix+dim*m, [&m](float64_t& val) { val/=2*m; });
+
+	auto feats_p=new CDenseFeatures<float64_t>(data_p);
+	auto feats_q=new CDenseFeatures<float64_t>(data_q);
+	auto feats=feats_p->create_merged_copy(feats_q);
+	SG_REF(feats);
+	SG_UNREF(feats_p);
+	SG_UNREF(feats_q);
+
+	auto kernel=some<CGaussianKernel>();
+	kernel->set_width(2.0);
+
+	kernel->init(feats, feats);
+	auto kernel_matrix=kernel->get_kernel_matrix<float32_t>();
+
+	for (auto stype : {ST_BIASED_FULL, ST_UNBIASED_FULL, ST_UNBIASED_INCOMPLETE})
+	{
+		auto permutation_mmd=PermutationMMD();
+		permutation_mmd.m_n_x=n;
+		permutation_mmd.m_n_y=m;
+		permutation_mmd.m_stype=stype;
+		permutation_mmd.m_num_null_samples=num_null_samples;
+
+		prng.seed(seed);
+		SGVector<float32_t> result_1=permutation_mmd(kernel_matrix, prng);
+
+		prng.seed(seed);
+		SGVector<float32_t> result_2=permutation_mmd(Kernel(kernel), prng);
+
+		EXPECT_TRUE(result_1.size()==result_2.size());
+		for (auto i=0; i<result_1.size(); ++i)
+			EXPECT_NEAR(result_1[i], result_2[i], 1E-6);
+	}
+
+	SG_UNREF(feats);
+}
+
 TEST(PermutationMMD, biased_full_multi_kernel)
 {
 	const index_t seed = 12345;